@@ -15,6 +15,8 @@
 
 #include "Math/FitMethodFunction.h"
 
+#include "Fit/FitUtil.h"
+
 #include "Math/IParamFunction.h"
 
 #include "Math/IParamFunctionfwd.h"
@@ -54,7 +56,8 @@ protected:
    BasicFCN (const std::shared_ptr<DataType> & data, const std::shared_ptr<IModelFunction> & func) :
       BaseObjFunction(func->NPar(), data->Size() ),
       fData(data),
-      fFunc(func)
+      fFunc(func),
+      fScalarFunc(*func)
    { }
 
 
@@ -79,6 +82,10 @@ public:
    /// access to function pointer
    std::shared_ptr<IModelFunction> ModelFunctionPtr() const { return fFunc; }
 
+   /// access to the model function as a scalar function, for the contributions of single data points.
+   /// For a vectorized model function this is an adapter, created once with the model function.
+   const ::ROOT::Math::IParamMultiFunction & ScalarModelFunction() const { return fScalarFunc.Get(); }
+
 
 
 protected:
@@ -88,11 +95,15 @@ protected:
    void SetData(const std::shared_ptr<DataType> & data) { fData = data; }
 
       /// Set the function pointer
-   void SetModelFunction(const std::shared_ptr<IModelFunction> & func) { fFunc = func; }
+   void SetModelFunction(const std::shared_ptr<IModelFunction> & func) {
+      fFunc = func;
+      fScalarFunc = FitUtil::ScalarModelFunctionHolder<T>(*func);
+   }
 
 
    std::shared_ptr<DataType>  fData;
    std::shared_ptr<IModelFunction>  fFunc;
+   FitUtil::ScalarModelFunctionHolder<T> fScalarFunc; //! scalar view of fFunc
 
 
 
@@ -29,6 +29,8 @@
 #include "Math/IntegratorMultiDim.h"
 
 #include "TError.h"
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 // using parameter cache is not thread safe but needed for normalizing the functions
@@ -346,16 +348,136 @@ namespace FitUtil {
   double
   EvaluatePdf(const IModelFunction &func, const UnBinData &data, const double *x, unsigned int ipoint, double *g = 0);
 
+  /**
+      holder of the model function of a fit as a scalar function, used for the contributions of single data
+      points (needed by Fumili or the least square minimizers). For a scalar model function it is the function
+      itself, for a vectorized one an adapter created once for the whole fit.
+  */
+  template <class T>
+  class ScalarModelFunctionHolder;
+
+  template <>
+  class ScalarModelFunctionHolder<double> {
+  public:
+     explicit ScalarModelFunctionHolder(const IModelFunction &func) : fFunc(&func) {}
+     const IModelFunction &Get() const { return *fFunc; }
+
+  private:
+     const IModelFunction *fFunc; //! not owned
+  };
+
 #ifdef R__HAS_VECCORE
+  /// return the coordinates broadcast to all the vector lanes, in a scratch buffer of the calling thread
+  /// which is reused for all the points
+  template <class T>
+  const T *BroadcastCoordinates(const double *x, unsigned int ndim)
+  {
+     static thread_local std::vector<T> xx;
+     xx.assign(x, x + ndim);
+     return xx.data();
+  }
+
+  /**
+      adapter using a vectorized model function as a scalar one, evaluating it in a single point
+      with the coordinates broadcast to all the vector lanes.
+      The contributions of a single data point are then computed by the scalar functions.
+      ScalarGradModelFunction uses in addition the parameter gradient of the vectorized function.
+  */
+  template <class T>
+  class ScalarModelFunction : public IModelFunction {
+  public:
+     ScalarModelFunction(const IModelFunctionTempl<T> &func)
+        : fFunc(func), fParams(func.Parameters(), func.Parameters() + func.NPar())
+     {
+     }
+
+     IModelFunction *Clone() const { return new ScalarModelFunction<T>(fFunc); }
+     unsigned int NDim() const { return fFunc.NDim(); }
+     unsigned int NPar() const { return fFunc.NPar(); }
+     const double *Parameters() const { return fParams.data(); }
+     void SetParameters(const double *p) { std::copy(p, p + fParams.size(), fParams.begin()); }
+
+  private:
+     double DoEvalPar(const double *x, const double *p) const
+     {
+        return vecCore::Get<T>(fFunc(BroadcastCoordinates<T>(x, fFunc.NDim()), p), 0);
+     }
+
+     const IModelFunctionTempl<T> &fFunc;
+     std::vector<double> fParams;
+  };
+
+  template <class T>
+  class ScalarGradModelFunction : public IGradModelFunction {
+  public:
+     ScalarGradModelFunction(const IGradModelFunctionTempl<T> &func)
+        : fFunc(func), fParams(func.Parameters(), func.Parameters() + func.NPar())
+     {
+     }
+
+     IGradModelFunction *Clone() const { return new ScalarGradModelFunction<T>(fFunc); }
+     unsigned int NDim() const { return fFunc.NDim(); }
+     unsigned int NPar() const { return fFunc.NPar(); }
+     const double *Parameters() const { return fParams.data(); }
+     void SetParameters(const double *p) { std::copy(p, p + fParams.size(), fParams.begin()); }
+
+     void ParameterGradient(const double *x, const double *p, double *grad) const
+     {
+        static thread_local std::vector<T> gg;
+        gg.resize(fFunc.NPar());
+        fFunc.ParameterGradient(BroadcastCoordinates<T>(x, fFunc.NDim()), p, gg.data());
+        for (unsigned int ipar = 0; ipar < gg.size(); ++ipar)
+           grad[ipar] = vecCore::Get<T>(gg[ipar], 0);
+     }
+
+  private:
+     double DoEvalPar(const double *x, const double *p) const
+     {
+        return vecCore::Get<T>(fFunc(BroadcastCoordinates<T>(x, fFunc.NDim()), p), 0);
+     }
+
+     double DoParameterDerivative(const double *x, const double *p, unsigned int ipar) const
+     {
+        return vecCore::Get<T>(fFunc.ParameterDerivative(BroadcastCoordinates<T>(x, fFunc.NDim()), p, ipar), 0);
+     }
+
+     const IGradModelFunctionTempl<T> &fFunc;
+     std::vector<double> fParams;
+  };
+
+  /// create the scalar adapter of a vectorized model function, using its gradient if it provides one
+  template <class T>
+  std::unique_ptr<IModelFunction> MakeScalarModelFunction(const IModelFunctionTempl<T> &func)
+  {
+     auto gfunc = dynamic_cast<const IGradModelFunctionTempl<T> *>(&func);
+     if (gfunc)
+        return std::unique_ptr<IModelFunction>(new ScalarGradModelFunction<T>(*gfunc));
+     return std::unique_ptr<IModelFunction>(new ScalarModelFunction<T>(func));
+  }
+
+  template <class T>
+  class ScalarModelFunctionHolder {
+  public:
+     explicit ScalarModelFunctionHolder(const IModelFunctionTempl<T> &func) : fFunc(MakeScalarModelFunction(func)) {}
+     const IModelFunction &Get() const { return *fFunc; }
+
+  private:
+     std::unique_ptr<IModelFunction> fFunc; //!
+  };
+
+  /// call the scalar evaluation eval(scalarFunc) of a single point contribution using a vectorized model function.
+  /// The adapter is created for this call only: the fit method functions keep one for the whole fit instead.
+  template <class T, class Eval>
+  double EvalWithScalarFunction(const IModelFunctionTempl<T> &func, Eval eval)
+  {
+     return eval(*MakeScalarModelFunction(func));
+  }
+
    template <class NotCompileIfScalarBackend = std::enable_if<!(std::is_same<double, ROOT::Double_v>::value)>>
-   double EvaluatePdf(const IModelFunctionTempl<ROOT::Double_v> &func, const UnBinData &data, const double *p, unsigned int i, double *) {
+   double EvaluatePdf(const IModelFunctionTempl<ROOT::Double_v> &func, const UnBinData &data, const double *p, unsigned int i, double *g) {
       // evaluate the pdf contribution to the generic logl function in case of bin data
       // return actually the log of the pdf and its derivatives
-      // func.SetParameters(p);
-      const auto x = vecCore::FromPtr<ROOT::Double_v>(data.GetCoordComponent(i, 0));
-      auto fval = func(&x, p);
-      auto logPdf = ROOT::Math::Util::EvalLog(fval);
-      return vecCore::Get<ROOT::Double_v>(logPdf, 0);
+      return EvalWithScalarFunction(func, [&](const IModelFunction &f) { return EvaluatePdf(f, data, p, i, g); });
    }
 #endif
 
@@ -863,10 +985,13 @@ namespace FitUtil {
          return vecCore::ReduceAdd(res);
       }
 
-      static double EvalChi2Effective(const IModelFunctionTempl<T> &, const BinData &, const double *, unsigned int &)
+      static double EvalChi2Effective(const IModelFunctionTempl<T> &func, const BinData &data, const double *p,
+                                      unsigned int &nPoints)
       {
-         Error("FitUtil::Evaluate<T>::EvalChi2Effective", "The vectorized evaluation of the Chi2 with coordinate errors is still not supported");
-         return -1.;
+         // the derivatives with respect to the coordinates are computed numerically point by point:
+         // use the scalar evaluation
+         return EvalWithScalarFunction(
+            func, [&](const IModelFunction &f) { return FitUtil::EvaluateChi2Effective(f, data, p, nPoints); });
       }
 
       // Compute a mask to filter out infinite numbers and NaN values.
@@ -1066,17 +1191,20 @@ namespace FitUtil {
          }
       }
 
-      static double EvalChi2Residual(const IModelFunctionTempl<T> &, const BinData &, const double *, unsigned int, double *)
+      static double EvalChi2Residual(const IModelFunctionTempl<T> &func, const BinData &data, const double *p,
+                                     unsigned int i, double *g = 0)
       {
-         Error("FitUtil::Evaluate<T>::EvalChi2Residual", "The vectorized evaluation of the Chi2 with the ith residual is still not supported");
-         return -1.;
+         return EvalWithScalarFunction(
+            func, [&](const IModelFunction &f) { return FitUtil::EvaluateChi2Residual(f, data, p, i, g); });
       }
 
       /// evaluate the pdf (Poisson) contribution to the logl (return actually log of pdf)
       /// and its gradient
-      static double EvalPoissonBinPdf(const IModelFunctionTempl<T> &, const BinData &, const double *, unsigned int , double * ) {
-         Error("FitUtil::Evaluate<T>::EvaluatePoissonBinPdf", "The vectorized evaluation of the BinnedLikelihood fit evaluated point by point is still not supported");
-         return -1.;
+      static double EvalPoissonBinPdf(const IModelFunctionTempl<T> &func, const BinData &data, const double *p,
+                                      unsigned int i, double *g)
+      {
+         return EvalWithScalarFunction(
+            func, [&](const IModelFunction &f) { return FitUtil::EvaluatePoissonBinPdf(f, data, p, i, g); });
       }
 
       static void
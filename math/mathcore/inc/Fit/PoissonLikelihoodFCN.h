@@ -120,7 +120,7 @@ public:
    /// i-th likelihood element and its gradient
    virtual double DataElement(const double * x, unsigned int i, double * g) const {
       if (i==0) this->UpdateNCalls();
-      return FitUtil::Evaluate<typename BaseFCN::T>::EvalPoissonBinPdf(BaseFCN::ModelFunction(), BaseFCN::Data(), x, i, g);
+      return FitUtil::EvaluatePoissonBinPdf(BaseFCN::ScalarModelFunction(), BaseFCN::Data(), x, i, g);
    }
 
    /// evaluate gradient
@@ -60,6 +60,8 @@ fast as Mersenne and Twister is MIXMAX (TRandomMixMax).
 #include "TRandom2.h"
 #include "TUUID.h"
 
+#include <algorithm>
+
 TRandom *gRandom = new TRandom3();
 #ifdef R__COMPLETE_MEM_TERMINATION
 namespace {
@@ -72,6 +74,89 @@ namespace {
 
 ClassImp(TRandom3);
 
+namespace {
+
+const Int_t  kM = 397;
+const Int_t  kN = 624;
+const UInt_t kTemperingMaskB =  0x9d2c5680;
+const UInt_t kTemperingMaskC =  0xefc60000;
+const UInt_t kUpperMask =       0x80000000;
+const UInt_t kLowerMask =       0x7fffffff;
+const UInt_t kMatrixA =         0x9908b0df;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the next 624 words of the state.
+/// The loops have no branches (the conditional xor with kMatrixA is done with a mask),
+/// so that the compiler can vectorize them.
+
+void NextState(UInt_t *mt)
+{
+   UInt_t y;
+   Int_t i;
+
+   for (i=0; i < kN-kM; i++) {
+      y = (mt[i] & kUpperMask) | (mt[i+1] & kLowerMask);
+      mt[i] = mt[i+kM] ^ (y >> 1) ^ ((0u - (y & 0x1)) & kMatrixA);
+   }
+
+   for (   ; i < kN-1    ; i++) {
+      y = (mt[i] & kUpperMask) | (mt[i+1] & kLowerMask);
+      mt[i] = mt[i+kM-kN] ^ (y >> 1) ^ ((0u - (y & 0x1)) & kMatrixA);
+   }
+
+   y = (mt[kN-1] & kUpperMask) | (mt[0] & kLowerMask);
+   mt[kN-1] = mt[kM-1] ^ (y >> 1) ^ ((0u - (y & 0x1)) & kMatrixA);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Tempering of a word of the state, giving the 32 random bits
+
+inline UInt_t Temper(UInt_t y)
+{
+   y ^=  (y >> 11);
+   y ^= ((y << 7 ) & kTemperingMaskB );
+   y ^= ((y << 15) & kTemperingMaskC );
+   y ^=  (y >> 18);
+   return y;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill array with n numbers in ]0,1], the same as n calls to TRandom3::Rndm().
+/// The words available in the state are converted in a single loop, without branches;
+/// the (very rare) zeros, which Rndm() skips, are removed afterwards.
+
+template <class T>
+void FillArray(UInt_t *mt, Int_t &count, Int_t n, T *array)
+{
+   Int_t k = 0;
+   while (k < n) {
+      if (count >= kN) {
+         NextState(mt);
+         count = 0;
+      }
+      const Int_t m = std::min(n - k, kN - count);
+      const UInt_t *words = mt + count;
+      T *out = array + k;
+      Int_t nzero = 0;
+      for (Int_t i = 0; i < m; i++) {
+         const UInt_t y = Temper(words[i]);
+         // the conversion to Double_t of a signed integer is faster (and vectorizable without AVX-512)
+         out[i] = T((Double_t(Int_t(y ^ kUpperMask)) + 2147483648.) * 2.3283064365386963e-10); // * Power(2,-32)
+         nzero += (y == 0);
+      }
+      count += m;
+      if (nzero) {
+         Int_t j = 0;
+         for (Int_t i = 0; i < m; i++) {
+            if (out[i] != 0) out[j++] = out[i];
+         }
+      }
+      k += m - nzero;
+   }
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 /// If seed is 0, the seed is automatically computed via a TUUID object.
@@ -98,39 +183,12 @@ TRandom3::~TRandom3()
 
 Double_t TRandom3::Rndm()
 {
-   UInt_t y;
-
-   const Int_t  kM = 397;
-   const Int_t  kN = 624;
-   const UInt_t kTemperingMaskB =  0x9d2c5680;
-   const UInt_t kTemperingMaskC =  0xefc60000;
-   const UInt_t kUpperMask =       0x80000000;
-   const UInt_t kLowerMask =       0x7fffffff;
-   const UInt_t kMatrixA =         0x9908b0df;
-
    if (fCount624 >= kN) {
-      Int_t i;
-
-      for (i=0; i < kN-kM; i++) {
-         y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-         fMt[i] = fMt[i+kM] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-      }
-
-      for (   ; i < kN-1    ; i++) {
-         y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-         fMt[i] = fMt[i+kM-kN] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-      }
-
-      y = (fMt[kN-1] & kUpperMask) | (fMt[0] & kLowerMask);
-      fMt[kN-1] = fMt[kM-1] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
+      NextState(fMt);
       fCount624 = 0;
    }
 
-   y = fMt[fCount624++];
-   y ^=  (y >> 11);
-   y ^= ((y << 7 ) & kTemperingMaskB );
-   y ^= ((y << 15) & kTemperingMaskC );
-   y ^=  (y >> 18);
+   UInt_t y = Temper(fMt[fCount624++]);
 
    // 2.3283064365386963e-10 == 1./(max<UINt_t>+1)  -> then returned value cannot be = 1.0
    if (y) return ( (Double_t) y * 2.3283064365386963e-10); // * Power(2,-32)
@@ -142,56 +200,17 @@ Double_t TRandom3::Rndm()
 
 void TRandom3::RndmArray(Int_t n, Float_t *array)
 {
-  for(Int_t i=0; i<n; i++) array[i]=(Float_t)Rndm();
+   FillArray(fMt, fCount624, n, array);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return an array of n random numbers uniformly distributed in ]0,1]
+/// The numbers are the same as the ones returned by n calls to Rndm(), but the
+/// words of the state are tempered and converted in blocks, with SIMD instructions.
 
 void TRandom3::RndmArray(Int_t n, Double_t *array)
 {
-   Int_t k = 0;
-
-   UInt_t y;
-
-   const Int_t  kM = 397;
-   const Int_t  kN = 624;
-   const UInt_t kTemperingMaskB =  0x9d2c5680;
-   const UInt_t kTemperingMaskC =  0xefc60000;
-   const UInt_t kUpperMask =       0x80000000;
-   const UInt_t kLowerMask =       0x7fffffff;
-   const UInt_t kMatrixA =         0x9908b0df;
-
-   while (k < n) {
-      if (fCount624 >= kN) {
-         Int_t i;
-
-         for (i=0; i < kN-kM; i++) {
-            y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-            fMt[i] = fMt[i+kM] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         }
-
-         for (   ; i < kN-1    ; i++) {
-            y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-            fMt[i] = fMt[i+kM-kN] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         }
-
-         y = (fMt[kN-1] & kUpperMask) | (fMt[0] & kLowerMask);
-         fMt[kN-1] = fMt[kM-1] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         fCount624 = 0;
-      }
-
-      y = fMt[fCount624++];
-      y ^=  (y >> 11);
-      y ^= ((y << 7 ) & kTemperingMaskB );
-      y ^= ((y << 15) & kTemperingMaskC );
-      y ^=  (y >> 18);
-
-      if (y) {
-         array[k] = Double_t( y * 2.3283064365386963e-10); // * Power(2,-32)
-         k++;
-      }
-   }
+   FillArray(fMt, fCount624, n, array);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
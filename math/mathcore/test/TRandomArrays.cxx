@@ -0,0 +1,64 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Test that the array functions of TRandom3 return the same numbers as the
+// corresponding single number functions.
+
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+TEST(TRandomArrays, RndmArray)
+{
+   // more than the 624 words of the state, starting in the middle of it
+   const Int_t n = 1500;
+   TRandom3 r1(4357), r2(4357);
+   r1.Rndm();
+   r2.Rndm();
+   std::vector<Double_t> d(n);
+   r1.RndmArray(n, d.data());
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_EQ(d[i], r2.Rndm());
+
+   std::vector<Float_t> f(n);
+   r1.RndmArray(n, f.data());
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_EQ(f[i], Float_t(r2.Rndm()));
+}
+
+TEST(TRandomArrays, ExpArray)
+{
+   const Int_t n = 1000;
+   TRandom3 r1(111), r2(111);
+   std::vector<Double_t> e(n);
+   r1.ExpArray(n, e.data(), 2.5);
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_EQ(e[i], r2.Exp(2.5));
+}
+
+TEST(TRandomArrays, GausArray)
+{
+   // odd number of values, larger than the block of uniform numbers
+   const Int_t n = 1001;
+   TRandom3 r1(222), r2(222);
+   std::vector<Double_t> g(n);
+   r1.GausArray(n, g.data(), 1., 3.);
+   for (Int_t i = 0; i < n; i += 2) {
+      Double_t a, b;
+      r2.Rannor(a, b);
+      EXPECT_DOUBLE_EQ(g[i], 1. + 3. * a);
+      if (i + 1 < n)
+         EXPECT_DOUBLE_EQ(g[i + 1], 1. + 3. * b);
+   }
+   // the generators are in the same state afterwards
+   EXPECT_EQ(r1.Rndm(), r2.Rndm());
+}
@@ -22,6 +22,7 @@ struct FitModelData {
    TFitResultPtr refValue;
    std::string name;
    std::vector<double> speedups;
+   bool compareParameters = false; // compare also the fitted parameters with the reference ones
 };
 
 // Function that calls the fit, checks for numerical correctness and computes speed up
@@ -54,6 +55,16 @@ void benchmarkFit(TF1 *f, TH1D &h, const std::string &opt, const std::string &fi
                msg.c_str(), result->MinFcnValue(), model.refValue->MinFcnValue());
          exit(-1);
       }
+      if (model.compareParameters) {
+         for (unsigned int ipar = 0; ipar < result->NPar(); ++ipar) {
+            const double ref = model.refValue->Parameter(ipar);
+            if (std::abs(result->Parameter(ipar) - ref) > tolerance * model.refValue->ParError(ipar)) {
+               Error("testBinnedFitExecPolicy", "%s : Failed comparison of parameter %u \t p = %f, it should be = %f",
+                     msg.c_str(), ipar, result->Parameter(ipar), ref);
+               exit(-1);
+            }
+         }
+      }
       // Compute speedup
       model.speedups.emplace_back(model.refTime.count() / duration.count() * result->NCalls() /
                                   model.refValue->NCalls());
@@ -130,5 +141,35 @@ int main()
 #endif
 #endif
    printSpeedUps(models);
+
+   // Fumili uses the contribution of each single bin (and its gradient), which for the
+   // vectorized function is evaluated point by point: the parameters must agree with the scalar fit
+   ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2", "Fumili");
+   std::vector<FitModelData> fumiliModels(2);
+   fumiliModels[kChi2].name = "Fumili Chi2";
+   fumiliModels[kPoisson].name = "Fumili Binned Likelihood";
+   for (auto &m : fumiliModels)
+      m.compareParameters = true;
+
+   fit = "Sequential";
+   benchmarkFit(f, h1f, "S SERIAL", fit, fumiliModels[EModel::kChi2]);
+   benchmarkFit(f, h1f, "SERIAL S L", fit, fumiliModels[EModel::kPoisson]);
+#ifdef R__USE_IMT
+   fit = "Multithreaded";
+   benchmarkFit(f, h1f, "S", fit, fumiliModels[EModel::kChi2]);
+   benchmarkFit(f, h1f, "S L", fit, fumiliModels[EModel::kPoisson]);
+#endif
+#ifdef R__HAS_VECCORE
+   fit = "Vectorized";
+   benchmarkFit(fvecCore, h1f, "SERIAL S", fit, fumiliModels[EModel::kChi2]);
+   benchmarkFit(fvecCore, h1f, "SERIAL S L", fit, fumiliModels[EModel::kPoisson]);
+#ifdef R__USE_IMT
+   fit = "Multithreaded and vectorized";
+   benchmarkFit(fvecCore, h1f, "S", fit, fumiliModels[EModel::kChi2]);
+   benchmarkFit(fvecCore, h1f, "S L", fit, fumiliModels[EModel::kPoisson]);
+#endif
+#endif
+   printSpeedUps(fumiliModels);
+
    return 0;
 }
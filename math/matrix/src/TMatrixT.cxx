@@ -20,6 +20,7 @@
 
 */
 
+#include <algorithm>
 #include <typeinfo>
 
 #include "TMatrixT.h"
@@ -30,6 +31,12 @@
 #include "TDecompLU.h"
 #include "TMatrixDEigen.h"
 #include "TMath.h"
+#include "ROOT/TSeq.hxx"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 templateClassImp(TMatrixT);
 
@@ -3071,6 +3078,84 @@ TMatrixT<Element> &TMatrixTAutoloadOps::ElementDiv(TMatrixT<Element> &target,con
    return target;
 }
 
+namespace {
+
+// Block sizes of the matrix multiplication kernels: a block of kMultBlockK rows and kMultBlockN
+// columns of B stays in the L2 cache while it is used for all the rows of A, and the kMultBlockN
+// elements of a row of C in the L1 cache. Within a block the innermost loop runs over contiguous
+// elements of B and C, so that it can be vectorized by the compiler.
+// The elements of C are still accumulated in the order of the inner index, so that the result
+// does not depend on the block sizes nor on the number of threads.
+const Int_t kMultBlockK = 128;
+const Int_t kMultBlockN = 512;
+// Minimum number of multiply-adds to run the multiplication with the implicit multi-threading,
+// when enabled
+const Double_t kMultMinParallel = 1.e7;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(row0,row1) for all the rows [0,nrows) of the result, split in blocks
+/// processed in parallel when implicit multi-threading is enabled and the work is large enough
+
+template<class F>
+void ForEachRowBlock(Int_t nrows,Double_t nops,F func)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nops >= kMultMinParallel && nrows > 1) {
+      ROOT::TThreadExecutor pool;
+      const Int_t nblocks = TMath::Min(nrows,Int_t(4*pool.GetPoolSize()));
+      pool.Foreach([&](Int_t iblock) { func(Int_t(Long64_t(nrows)*iblock/nblocks),
+                                            Int_t(Long64_t(nrows)*(iblock+1)/nblocks)); },
+                   ROOT::TSeqI(nblocks));
+      return;
+   }
+#else
+   (void)nops;
+#endif
+   func(0,nrows);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C[i,] = sum_k op(A)[i,k] * B[k,] for the rows row0 <= i < row1 of C, where op(A)[i,k] = ap[i*astride+k*ainc]
+
+template<class Element>
+void MultRows(const Element * const ap,Int_t astride,Int_t ainc,Int_t ninner,
+              const Element * const bp,Int_t ncolsb,Element * const cp,Int_t row0,Int_t row1)
+{
+   std::fill(cp+Long64_t(row0)*ncolsb,cp+Long64_t(row1)*ncolsb,Element(0));
+   for (Int_t j0 = 0; j0 < ncolsb; j0 += kMultBlockN) {
+      const Int_t j1 = TMath::Min(j0+kMultBlockN,ncolsb);
+      for (Int_t k0 = 0; k0 < ninner; k0 += kMultBlockK) {
+         const Int_t k1 = TMath::Min(k0+kMultBlockK,ninner);
+         for (Int_t i = row0; i < row1; i++) {
+            const Element *aip = ap+Long64_t(i)*astride;
+                  Element *crp = cp+Long64_t(i)*ncolsb;
+            Int_t k = k0;
+            // four rows of B at a time, adding the terms in the same order as one at a time
+            for (; k+4 <= k1; k += 4) {
+               const Element a0 = aip[Long64_t(k)*ainc];
+               const Element a1 = aip[Long64_t(k+1)*ainc];
+               const Element a2 = aip[Long64_t(k+2)*ainc];
+               const Element a3 = aip[Long64_t(k+3)*ainc];
+               const Element *brp0 = bp+Long64_t(k)*ncolsb;
+               const Element *brp1 = brp0+ncolsb;
+               const Element *brp2 = brp1+ncolsb;
+               const Element *brp3 = brp2+ncolsb;
+               for (Int_t j = j0; j < j1; j++)
+                  crp[j] = crp[j]+a0*brp0[j]+a1*brp1[j]+a2*brp2[j]+a3*brp3[j];
+            }
+            for (; k < k1; k++) {
+               const Element aik = aip[Long64_t(k)*ainc];
+               const Element *brp = bp+Long64_t(k)*ncolsb;
+               for (Int_t j = j0; j < j1; j++)
+                  crp[j] += aik*brp[j];
+            }
+         }
+      }
+   }
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
 
@@ -3078,20 +3163,12 @@ template<class Element>
 void TMatrixTAutoloadOps::AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                     // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *arp = arp0;                       // Pointer to the i-th row of A, reset to A[i,0]
-         Element cij = 0;
-         while (bcp < bp+nb) {                     // Scan the i-th row of A and
-            cij += *arp++ * *bcp;                   // the j-th col of B
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                              // Set bcp to the (j+1)-th col
-      }
-      arp0 += ncolsa;                             // Set ap to the (i+1)-th row
-   }
+   if (ncolsa == 0)
+      return;
+   const Int_t nrowsa = na/ncolsa;
+   ForEachRowBlock(nrowsa,Double_t(na)*ncolsb,[&](Int_t row0,Int_t row1) {
+      MultRows(ap,ncolsa,1,ncolsa,bp,ncolsb,cp,row0,row1);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3101,21 +3178,12 @@ template<class Element>
 void TMatrixTAutoloadOps::AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *acp0 = ap;           // Pointer to  A[i,0];
-   while (acp0 < ap+ncolsa) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *acp = acp0;                       // Pointer to the i-th column of A, reset to A[0,i]
-         Element cij = 0;
-         while (bcp < bp+nb) {           // Scan the i-th column of A and
-            cij += *acp * *bcp;           // the j-th col of B
-            acp += ncolsa;
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                    // Set bcp to the (j+1)-th col
-      }
-      acp0++;                           // Set acp0 to the (i+1)-th col
-   }
+   if (ncolsb == 0)
+      return;
+   const Int_t nrowsb = nb/ncolsb;
+   ForEachRowBlock(ncolsa,Double_t(ncolsa)*nb,[&](Int_t row0,Int_t row1) {
+      MultRows(ap,1,ncolsa,nrowsb,bp,ncolsb,cp,row0,row1);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3125,20 +3193,48 @@ template<class Element>
 void TMatrixTAutoloadOps::AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                    // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      const Element *brp0 = bp;                  // Pointer to  B[j,0];
-      while (brp0 < bp+nb) {
-         const Element *arp = arp0;               // Pointer to the i-th row of A, reset to A[i,0]
-         const Element *brp = brp0;               // Pointer to the j-th row of B, reset to B[j,0]
-         Element cij = 0;
-         while (brp < brp0+ncolsb)                 // Scan the i-th row of A and
-            cij += *arp++ * *brp++;                 // the j-th row of B
-         *cp++ = cij;
-         brp0 += ncolsb;                           // Set brp0 to the (j+1)-th row
+   if (ncolsa == 0 || ncolsb == 0)
+      return;
+   const Int_t nrowsa = na/ncolsa;
+   const Int_t nrowsb = nb/ncolsb;
+   // the rows of B are used in blocks which stay in the L2 cache for all the rows of A,
+   // and four elements of C are computed at the same time from the same row of A
+   const Int_t nblockb = TMath::Max(1,kMultBlockK*kMultBlockN/ncolsb);
+   ForEachRowBlock(nrowsa,Double_t(na)*nrowsb,[&](Int_t row0,Int_t row1) {
+      for (Int_t j0 = 0; j0 < nrowsb; j0 += nblockb) {
+         const Int_t j1 = TMath::Min(j0+nblockb,nrowsb);
+         for (Int_t i = row0; i < row1; i++) {
+            const Element *arp = ap+Long64_t(i)*ncolsa;
+                  Element *crp = cp+Long64_t(i)*nrowsb;
+            Int_t j = j0;
+            for (; j+4 <= j1; j += 4) {
+               const Element *brp0 = bp+Long64_t(j)*ncolsb;
+               const Element *brp1 = brp0+ncolsb;
+               const Element *brp2 = brp1+ncolsb;
+               const Element *brp3 = brp2+ncolsb;
+               Element c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+               for (Int_t k = 0; k < ncolsb; k++) {
+                  const Element aik = arp[k];
+                  c0 += aik*brp0[k];
+                  c1 += aik*brp1[k];
+                  c2 += aik*brp2[k];
+                  c3 += aik*brp3[k];
+               }
+               crp[j]   = c0;
+               crp[j+1] = c1;
+               crp[j+2] = c2;
+               crp[j+3] = c3;
+            }
+            for (; j < j1; j++) {
+               const Element *brp = bp+Long64_t(j)*ncolsb;
+               Element cij = 0;
+               for (Int_t k = 0; k < ncolsb; k++)
+                  cij += arp[k]*brp[k];
+               crp[j] = cij;
+            }
+         }
       }
-      arp0 += ncolsa;                             // Set arp0 to the (i+1)-th row
-   }
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,110 @@
+// Tests for the matrix multiplication kernels of TMatrixT: A*B, A^T*B and A*B^T are compared
+// with a naive triple loop, for sizes crossing the cache blocks of the kernels and sizes which
+// are not multiples of the unrolling factor, with and without implicit multi-threading.
+
+#include "TMatrixD.h"
+#include "TMatrixF.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace {
+
+template <class Element>
+TMatrixT<Element> RandomMatrix(Int_t nrows, Int_t ncols, TRandom &rng)
+{
+   TMatrixT<Element> m(nrows, ncols);
+   for (Int_t i = 0; i < nrows; i++)
+      for (Int_t j = 0; j < ncols; j++)
+         m(i, j) = rng.Uniform(-1, 1);
+   return m;
+}
+
+// C = A * B computed with the textbook triple loop, in double precision
+template <class Element>
+TMatrixD NaiveMult(const TMatrixT<Element> &a, const TMatrixT<Element> &b)
+{
+   TMatrixD c(a.GetNrows(), b.GetNcols());
+   for (Int_t i = 0; i < a.GetNrows(); i++)
+      for (Int_t j = 0; j < b.GetNcols(); j++) {
+         Double_t cij = 0;
+         for (Int_t k = 0; k < a.GetNcols(); k++)
+            cij += Double_t(a(i, k)) * b(k, j);
+         c(i, j) = cij;
+      }
+   return c;
+}
+
+template <class Element>
+void ExpectNear(const TMatrixT<Element> &c, const TMatrixD &ref, Double_t tol, const char *op)
+{
+   ASSERT_EQ(c.GetNrows(), ref.GetNrows()) << op;
+   ASSERT_EQ(c.GetNcols(), ref.GetNcols()) << op;
+   Int_t nbad = 0;
+   for (Int_t i = 0; i < c.GetNrows(); i++)
+      for (Int_t j = 0; j < c.GetNcols(); j++)
+         if (!(std::abs(c(i, j) - ref(i, j)) <= tol) && nbad++ < 10)
+            ADD_FAILURE() << op << ": element (" << i << "," << j << ") is " << c(i, j) << " instead of "
+                          << ref(i, j);
+   EXPECT_EQ(nbad, 0) << op;
+}
+
+// check the three products for C(n x m) = A(n x k) * B(k x m)
+template <class Element>
+void CheckProducts(Int_t n, Int_t k, Int_t m, Double_t tol)
+{
+   SCOPED_TRACE(::testing::Message() << "n=" << n << " k=" << k << " m=" << m);
+   TRandom3 rng(n * 10007 + k * 101 + m);
+   const TMatrixT<Element> a = RandomMatrix<Element>(n, k, rng);
+   const TMatrixT<Element> b = RandomMatrix<Element>(k, m, rng);
+   const TMatrixD ref = NaiveMult(a, b);
+
+   const TMatrixT<Element> at(TMatrixT<Element>::kTransposed, a);
+   const TMatrixT<Element> bt(TMatrixT<Element>::kTransposed, b);
+
+   ExpectNear(TMatrixT<Element>(a, TMatrixT<Element>::kMult, b), ref, tol, "A*B");
+   ExpectNear(TMatrixT<Element>(at, TMatrixT<Element>::kTransposeMult, b), ref, tol, "A^T*B");
+   ExpectNear(TMatrixT<Element>(a, TMatrixT<Element>::kMultTranspose, bt), ref, tol, "A*B^T");
+}
+
+// The kernels work on blocks of 128 inner indices and 512 columns of the result, with
+// a four-fold unrolling: the sizes below cross one or several blocks and are not all
+// multiples of four
+template <class Element>
+void CheckAllSizes(Double_t tol)
+{
+   CheckProducts<Element>(1, 1, 1, tol);
+   CheckProducts<Element>(3, 5, 7, tol);
+   CheckProducts<Element>(4, 8, 4, tol);
+   CheckProducts<Element>(17, 128, 512, tol);
+   CheckProducts<Element>(9, 131, 517, tol);
+   CheckProducts<Element>(13, 263, 1029, tol);
+   CheckProducts<Element>(130, 257, 5, tol);
+}
+
+} // namespace
+
+TEST(TMatrixT, MultiplicationDouble)
+{
+   CheckAllSizes<Double_t>(1.e-12);
+}
+
+TEST(TMatrixT, MultiplicationFloat)
+{
+   CheckAllSizes<Float_t>(1.e-4);
+}
+
+#ifdef R__USE_IMT
+// large enough products to be split between the threads
+TEST(TMatrixT, MultiplicationIMT)
+{
+   ROOT::EnableImplicitMT(4);
+   CheckProducts<Double_t>(61, 263, 1029, 1.e-12);
+   CheckProducts<Double_t>(1031, 131, 75, 1.e-12);
+   CheckProducts<Float_t>(61, 263, 1029, 1.e-4);
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -45,6 +45,7 @@
 #pragma link C++ class ROOT::Minuit2::CombinedMinimizer;
 #pragma link C++ class ROOT::Minuit2::ScanMinimizer;
 #pragma link C++ class ROOT::Minuit2::FumiliMinimizer;
+#pragma link C++ class ROOT::Minuit2::LBFGSMinimizer;
 #pragma link C++ class ROOT::Minuit2::MnMachinePrecision;
 #pragma link C++ class ROOT::Minuit2::MnTraceObject;
 
@@ -0,0 +1,71 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_LBFGSBuilder
+#define ROOT_Minuit2_LBFGSBuilder
+
+#include "Minuit2/MnConfig.h"
+#include "Minuit2/MinimumBuilder.h"
+#include "Minuit2/MnMatrix.h"
+
+#include <deque>
+#include <vector>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+/**
+   Build (find) function minimum using the limited-memory BFGS method (L-BFGS,
+   see D.C. Liu and J. Nocedal, Math. Programming 45 (1989) 503).
+   Instead of the dense inverse Hessian of the VariableMetricBuilder, only the last
+   few (by default 10) pairs of position and gradient differences are kept, and the
+   Newton step is computed from them with the two-loop recursion. Memory and time per
+   iteration are therefore O(n) for n parameters. The step length is found with the
+   MnLineSearch used also by Migrad.
+
+   The resulting minimum has no covariance matrix; the parameter errors are the
+   diagonal of the approximated inverse Hessian. A full Hesse can be run afterwards if needed.
+   Only the last state is stored with its parameter values, independently of the storage level.
+ */
+class LBFGSBuilder : public MinimumBuilder {
+
+public:
+   LBFGSBuilder(unsigned int nhistory = 10) : fNHistory(nhistory > 0 ? nhistory : 1) {}
+
+   ~LBFGSBuilder() {}
+
+   virtual FunctionMinimum Minimum(const MnFcn &, const GradientCalculator &, const MinimumSeed &, const MnStrategy &,
+                                   unsigned int, double) const;
+
+   unsigned int NHistory() const { return fNHistory; }
+   void SetNHistory(unsigned int n) { fNHistory = n > 0 ? n : 1; }
+
+private:
+   /// difference of position (s) and gradient (y) between two iterations, with rho = 1/(y.s)
+   struct Correction {
+      MnAlgebraicVector fS;
+      MnAlgebraicVector fY;
+      double fRho;
+   };
+
+   MnAlgebraicVector InvHessianProduct(const MnAlgebraicVector &v, const std::deque<Correction> &corrections,
+                                       unsigned int ncorr, const MnAlgebraicVector &h0) const;
+
+   MnAlgebraicVector InvHessianDiagonal(const std::deque<Correction> &corrections, const MnAlgebraicVector &h0) const;
+
+   void AddResult(std::vector<MinimumState> &result, const MinimumState &state) const;
+
+   unsigned int fNHistory;
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_LBFGSBuilder
@@ -0,0 +1,49 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_LBFGSMinimizer
+#define ROOT_Minuit2_LBFGSMinimizer
+
+#include "Minuit2/MnConfig.h"
+#include "Minuit2/ModularFunctionMinimizer.h"
+#include "Minuit2/LBFGSSeedGenerator.h"
+#include "Minuit2/LBFGSBuilder.h"
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+//______________________________________________________________________________
+/**
+    Instantiates the SeedGenerator and MinimumBuilder for the
+    limited-memory BFGS minimization method, suited for a very large number of parameters.
+    API is provided in the upper ROOT::Minuit2::ModularFunctionMinimizer class
+
+ */
+
+class LBFGSMinimizer : public ModularFunctionMinimizer {
+
+public:
+   LBFGSMinimizer(unsigned int nhistory = 10) : fMinSeedGen(LBFGSSeedGenerator()), fMinBuilder(LBFGSBuilder(nhistory)) {}
+
+   ~LBFGSMinimizer() {}
+
+   const MinimumSeedGenerator &SeedGenerator() const { return fMinSeedGen; }
+   const MinimumBuilder &Builder() const { return fMinBuilder; }
+   MinimumBuilder &Builder() { return fMinBuilder; }
+
+private:
+   LBFGSSeedGenerator fMinSeedGen;
+   LBFGSBuilder fMinBuilder;
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_LBFGSMinimizer
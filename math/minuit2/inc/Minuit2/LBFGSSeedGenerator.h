@@ -0,0 +1,42 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_LBFGSSeedGenerator
+#define ROOT_Minuit2_LBFGSSeedGenerator
+
+#include "Minuit2/MinimumSeedGenerator.h"
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+/** seed generator for the LBFGSBuilder; contrary to the MnSeedGenerator it does not
+    build the n x n starting error matrix and it does not compute the gradient, which is
+    done by the builder. Only one function call is needed, and the step sizes and second
+    derivatives are estimated from the parameter errors (InitialGradientCalculator).
+ */
+
+class LBFGSSeedGenerator : public MinimumSeedGenerator {
+
+public:
+   LBFGSSeedGenerator() {}
+
+   virtual ~LBFGSSeedGenerator() {}
+
+   virtual MinimumSeed
+   operator()(const MnFcn &, const GradientCalculator &, const MnUserParameterState &, const MnStrategy &) const;
+
+   virtual MinimumSeed operator()(const MnFcn &, const AnalyticalGradientCalculator &, const MnUserParameterState &,
+                                  const MnStrategy &) const;
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_LBFGSSeedGenerator
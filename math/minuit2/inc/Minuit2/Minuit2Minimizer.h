@@ -32,7 +32,7 @@ class FunctionMinimum;
 class MnTraceObject;
 
 // enumeration specifying the type of Minuit2 minimizers
-enum EMinimizerType { kMigrad, kSimplex, kCombined, kScan, kFumili, kMigradBFGS };
+enum EMinimizerType { kMigrad, kSimplex, kCombined, kScan, kFumili, kMigradBFGS, kLBFGS };
 
 } // namespace Minuit2
 
@@ -44,10 +44,17 @@ namespace Minuit2 {
    In ROOT it can be instantiated using the plug-in manager (plug-in "Minuit2")
    Using a string  (used by the plugin manager) or via an enumeration
    an one can set all the possible minimization algorithms (Migrad, Simplex, Combined, Scan and Fumili).
+   For a very large number of parameters the limited-memory BFGS algorithm ("LBFGS") can be used:
+   it does not compute the covariance matrix, which is obtained only when calling Hesse. Without Hesse
+   the status is 0 and the parameter errors are an approximation from the diagonal of the inverse Hessian.
 
    Refer to the [guide](https://root.cern.ch/root/htmldoc/guides/minuit2/Minuit2.html) for an introduction how Minuit
    works.
 
+   With ROOT built with IMT, the numerical gradient and the Hessian matrix can be computed in parallel,
+   by setting the extra option "NumThreads" of the "Minuit2" default options to the number of threads.
+   The function to minimize must then be thread safe.
+
    @ingroup Minuit
 */
 class Minuit2Minimizer : public ROOT::Math::Minimizer {
@@ -10,6 +10,9 @@
 #ifndef ROOT_Minuit2_MnStrategy
 #define ROOT_Minuit2_MnStrategy
 
+#include <functional>
+#include <utility>
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -22,11 +25,18 @@ namespace Minuit2 {
              Minos (lowers strategy by 1 for Minos-own minimization),
              Hesse (iterations),
              Numerical2PDerivative (iterations)
+
+    Optionally, a parallel executor can be set, which is used to compute the
+    components of the numerical gradient and the elements of the Hessian
+    matrix concurrently. The FCN must then be thread safe.
  */
 
 class MnStrategy {
 
 public:
+   /// function calling body(i) for all i in [0,n), possibly concurrently, and returning when all calls are done
+   using Executor = std::function<void(unsigned int n, const std::function<void(unsigned int)> &body)>;
+
    // default strategy
    MnStrategy();
 
@@ -48,6 +58,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   const Executor &ParallelExecutor() const { return fExecutor; }
+
    bool IsLow() const { return fStrategy == 0; }
    bool IsMedium() const { return fStrategy == 1; }
    bool IsHigh() const { return fStrategy >= 2; }
@@ -69,6 +81,10 @@ public:
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
 
+   // set the executor for the numerical derivatives (an empty function means serial execution)
+   // the FCN must be thread safe if the executor runs the calls concurrently
+   void SetParallelExecutor(Executor executor) { fExecutor = std::move(executor); }
+
 private:
    unsigned int fStrategy;
 
@@ -80,6 +96,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   Executor fExecutor; //! not persistent
 };
 
 } // namespace Minuit2
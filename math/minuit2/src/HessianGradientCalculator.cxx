@@ -75,7 +75,6 @@ HessianGradientCalculator::DeltaGradient(const MinimumParameters &par, const Fun
 
    MnPrint print("HessianGradientCalculator");
 
-   MnAlgebraicVector x = par.Vec();
    MnAlgebraicVector grd = Gradient.Grad();
    const MnAlgebraicVector &g2 = Gradient.G2();
    // const MnAlgebraicVector& gstep = Gradient.Gstep();
@@ -87,15 +86,11 @@ HessianGradientCalculator::DeltaGradient(const MinimumParameters &par, const Fun
 
    double dfmin = 4. * Precision().Eps2() * (fabs(fcnmin) + Fcn().Up());
 
-   unsigned int n = x.size();
+   unsigned int n = par.Vec().size();
    MnAlgebraicVector dgrd(n);
 
-   MPIProcess mpiproc(n, 0);
-   // initial starting values
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
+   // compute component i of the gradient, varying x(i) (it is restored at the end)
+   auto component = [&](unsigned int i, MnAlgebraicVector &x) {
       double xtf = x(i);
       double dmin = 4. * Precision().Eps2() * (xtf + Precision().Eps2());
       double epspri = Precision().Eps2() + fabs(grd(i) * Precision().Eps2());
@@ -142,14 +137,33 @@ HessianGradientCalculator::DeltaGradient(const MinimumParameters &par, const Fun
       }
 
       dgrd(i) = std::max(dgmin, std::fabs(grdold - grdnew));
+   };
+
+   if (Strategy().ParallelExecutor()) {
+      // the components are independent: each task works on its own copy of the point
+      Strategy().ParallelExecutor()(n, [&](unsigned int i) {
+         MnAlgebraicVector x = par.Vec();
+         component(i, x);
+      });
+      for (unsigned int i = 0; i < n; i++)
+         print.Debug("HGC Param :", i, "\t new g1 =", grd(i), "gstep =", gstep(i), "dgrd =", dgrd(i));
+   } else {
+      MPIProcess mpiproc(n, 0);
+      // initial starting values
+      unsigned int startElementIndex = mpiproc.StartElementIndex();
+      unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+      MnAlgebraicVector x = par.Vec();
+      for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
+         component(i, x);
+         print.Debug("HGC Param :", i, "\t new g1 =", grd(i), "gstep =", gstep(i), "dgrd =", dgrd(i));
+      }
 
-      print.Debug("HGC Param :", i, "\t new g1 =", grd(i), "gstep =", d, "dgrd =", dgrd(i));
+      mpiproc.SyncVector(grd);
+      mpiproc.SyncVector(gstep);
+      mpiproc.SyncVector(dgrd);
    }
 
-   mpiproc.SyncVector(grd);
-   mpiproc.SyncVector(gstep);
-   mpiproc.SyncVector(dgrd);
-
    return std::pair<FunctionGradient, MnAlgebraicVector>(FunctionGradient(grd, g2, gstep), dgrd);
 }
 
@@ -0,0 +1,224 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/LBFGSBuilder.h"
+#include "Minuit2/GradientCalculator.h"
+#include "Minuit2/MinimumState.h"
+#include "Minuit2/MinimumError.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnLineSearch.h"
+#include "Minuit2/MinimumSeed.h"
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/MnMachinePrecision.h"
+#include "Minuit2/MnParabolaPoint.h"
+#include "Minuit2/LaSum.h"
+#include "Minuit2/LaProd.h"
+#include "Minuit2/MnPrint.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+double inner_product(const LAVector &, const LAVector &);
+
+void LBFGSBuilder::AddResult(std::vector<MinimumState> &result, const MinimumState &state) const
+{
+   result.push_back(state);
+   if (TraceIter())
+      TraceIteration(result.size() - 1, result.back());
+   else {
+      MnPrint print("LBFGSBuilder", PrintLevel());
+      print.Info(MnPrint::Oneline(result.back(), result.size() - 1));
+   }
+}
+
+MnAlgebraicVector LBFGSBuilder::InvHessianProduct(const MnAlgebraicVector &v, const std::deque<Correction> &corrections,
+                                                  unsigned int ncorr, const MnAlgebraicVector &h0) const
+{
+   // product of the inverse Hessian approximated with the first ncorr corrections
+   // with the vector v (two-loop recursion)
+   MnAlgebraicVector q(v);
+   std::vector<double> alpha(ncorr);
+   for (int k = int(ncorr) - 1; k >= 0; --k) {
+      const Correction &c = corrections[k];
+      alpha[k] = c.fRho * inner_product(c.fS, q);
+      q += (-alpha[k]) * c.fY;
+   }
+   for (unsigned int i = 0; i < q.size(); ++i)
+      q(i) *= h0(i);
+   for (unsigned int k = 0; k < ncorr; ++k) {
+      const Correction &c = corrections[k];
+      double beta = c.fRho * inner_product(c.fY, q);
+      q += (alpha[k] - beta) * c.fS;
+   }
+   return q;
+}
+
+MnAlgebraicVector
+LBFGSBuilder::InvHessianDiagonal(const std::deque<Correction> &corrections, const MnAlgebraicVector &h0) const
+{
+   // diagonal of the approximated inverse Hessian, obtained by applying the BFGS updates
+   //   H' = (1 - rho s y^T) H (1 - rho y s^T) + rho s s^T
+   // to the diagonal only, which requires the product H y for each of the stored corrections
+   MnAlgebraicVector diag(h0);
+   for (unsigned int k = 0; k < corrections.size(); ++k) {
+      const Correction &c = corrections[k];
+      MnAlgebraicVector hy = InvHessianProduct(c.fY, corrections, k, h0);
+      double yhy = inner_product(c.fY, hy);
+      double fac = c.fRho * c.fRho * yhy + c.fRho;
+      for (unsigned int i = 0; i < diag.size(); ++i)
+         diag(i) += -2. * c.fRho * c.fS(i) * hy(i) + fac * c.fS(i) * c.fS(i);
+   }
+   return diag;
+}
+
+FunctionMinimum LBFGSBuilder::Minimum(const MnFcn &fcn, const GradientCalculator &gc, const MinimumSeed &seed,
+                                      const MnStrategy &, unsigned int maxfcn, double edmval) const
+{
+   MnPrint print("LBFGSBuilder", PrintLevel());
+
+   // to be consistent with F77 Minuit (as in VariableMetricBuilder)
+   edmval *= 0.002;
+
+   if (seed.Parameters().Vec().size() == 0) {
+      print.Warn("No free parameters.");
+      return FunctionMinimum(seed, fcn.Up());
+   }
+
+   if (!seed.IsValid()) {
+      print.Error("Minimum seed invalid.");
+      return FunctionMinimum(seed, fcn.Up());
+   }
+
+   const MnMachinePrecision &prec = seed.Precision();
+   const unsigned int n = seed.Parameters().Vec().size();
+
+   // diagonal inverse Hessian used before the first correction is available
+   MnAlgebraicVector h0seed(n);
+   for (unsigned int i = 0; i < n; ++i) {
+      double g2 = seed.Gradient().G2()(i);
+      h0seed(i) = (g2 > prec.Eps2()) ? 1. / g2 : 1.;
+   }
+   MnAlgebraicVector h0(h0seed);
+
+   print.Info("Start iterating until Edm is <", edmval, "with call limit =", maxfcn, "and history of", fNHistory,
+              "corrections");
+
+   // the seed contains only an estimate of the gradient: compute it now
+   FunctionGradient g0 = gc(seed.Parameters(), seed.Gradient());
+   std::deque<Correction> corrections;
+   MnAlgebraicVector hg = InvHessianProduct(g0.Vec(), corrections, 0, h0);
+   double edm = 0.5 * inner_product(g0.Vec(), hg);
+   MinimumState s0(seed.Parameters(), MinimumError(0), g0, edm, fcn.NumOfCalls());
+
+   std::vector<MinimumState> result;
+   AddResult(result, s0);
+
+   MnLineSearch lsearch;
+   while (edm > edmval && fcn.NumOfCalls() < maxfcn) {
+
+      MnAlgebraicVector step(hg);
+      step *= -1.;
+      double gdel = inner_product(step, s0.Gradient().Grad());
+      if (gdel >= 0.) {
+         if (corrections.empty()) {
+            print.Warn("Search direction is not a descent direction, gdel =", gdel, "> 0");
+            break;
+         }
+         // restart from the diagonal approximation
+         print.Warn("Search direction is not a descent direction, gdel =", gdel, "> 0; reset the corrections");
+         corrections.clear();
+         h0 = h0seed;
+         hg = InvHessianProduct(s0.Gradient().Vec(), corrections, 0, h0);
+         continue;
+      }
+
+      MnParabolaPoint pp = lsearch(fcn, s0.Parameters(), step, gdel, prec);
+
+      // no improvement exit, as in VariableMetricBuilder
+      if (std::fabs(pp.Y() - s0.Fval()) <= std::fabs(s0.Fval()) * prec.Eps()) {
+         print.Warn("No improvement in line search");
+         break;
+      }
+
+      MnAlgebraicVector ds(step);
+      ds *= pp.X();
+      MnAlgebraicVector x(s0.Vec());
+      x += ds;
+      MinimumParameters p(x, ds, pp.Y());
+      FunctionGradient g = gc(p, s0.Gradient());
+
+      MnAlgebraicVector dg(g.Vec());
+      dg -= s0.Gradient().Vec();
+      double sy = inner_product(ds, dg);
+      double yy = inner_product(dg, dg);
+      // keep only the corrections satisfying the curvature condition, so that the
+      // approximated inverse Hessian stays positive definite
+      if (sy > prec.Eps2() * yy) {
+         corrections.push_back(Correction{ds, dg, 1. / sy});
+         if (corrections.size() > fNHistory)
+            corrections.pop_front();
+         double gamma = sy / yy;
+         for (unsigned int i = 0; i < n; ++i)
+            h0(i) = gamma;
+      } else {
+         print.Debug("Curvature condition not satisfied, s.y =", sy, "; correction not stored");
+      }
+
+      hg = InvHessianProduct(g.Vec(), corrections, corrections.size(), h0);
+      edm = 0.5 * inner_product(g.Vec(), hg);
+
+      if (std::isnan(edm)) {
+         print.Warn("Edm is NaN; stop iterations");
+         edm = s0.Edm();
+         break;
+      }
+
+      s0 = MinimumState(p, MinimumError(0), g, edm, fcn.NumOfCalls());
+
+      // the intermediate states are stored without parameters and gradient
+      AddResult(result, MinimumState(p.Fval(), edm, fcn.NumOfCalls()));
+   }
+
+   // the last state has as parameter errors the ones from the diagonal of the approximated inverse Hessian
+   MnAlgebraicVector hdiag = InvHessianDiagonal(corrections, h0);
+   MnAlgebraicVector err(n);
+   for (unsigned int i = 0; i < n; ++i)
+      err(i) = std::sqrt(2. * fcn.Up() * std::max(hdiag(i), 0.));
+   result.back() = MinimumState(MinimumParameters(s0.Vec(), err, s0.Fval()), s0.Error(), s0.Gradient(), s0.Edm(),
+                                fcn.NumOfCalls());
+
+   if (fcn.NumOfCalls() >= maxfcn) {
+      print.Warn("Call limit exceeded");
+      return FunctionMinimum(seed, result, fcn.Up(), FunctionMinimum::MnReachedCallLimit);
+   }
+
+   if (edm > edmval) {
+      if (edm < std::fabs(prec.Eps2() * s0.Fval())) {
+         print.Warn("Machine accuracy limits further improvement");
+      } else if (edm < 10 * edmval) {
+         print.Warn("Edm", edm, "is above tolerance but below 10*tolerance");
+      } else {
+         print.Warn("No convergence; Edm", edm, "is above tolerance", 10 * edmval);
+         return FunctionMinimum(seed, result, fcn.Up(), FunctionMinimum::MnAboveMaxEdm);
+      }
+   }
+
+   print.Debug("Exiting successfully;", "Ncalls", fcn.NumOfCalls(), "FCN", s0.Fval(), "Edm", edm, "Requested",
+               edmval);
+
+   return FunctionMinimum(seed, result, fcn.Up());
+}
+
+} // namespace Minuit2
+
+} // namespace ROOT
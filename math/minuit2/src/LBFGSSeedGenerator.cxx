@@ -0,0 +1,77 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/LBFGSSeedGenerator.h"
+#include "Minuit2/MinimumSeed.h"
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/GradientCalculator.h"
+#include "Minuit2/InitialGradientCalculator.h"
+#include "Minuit2/AnalyticalGradientCalculator.h"
+#include "Minuit2/MnUserTransformation.h"
+#include "Minuit2/MinimumParameters.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/MinimumError.h"
+#include "Minuit2/MinimumState.h"
+#include "Minuit2/MnMatrix.h"
+#include "Minuit2/MnMachinePrecision.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnPrint.h"
+
+#include <cmath>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+MinimumSeed LBFGSSeedGenerator::
+operator()(const MnFcn &fcn, const GradientCalculator &, const MnUserParameterState &st, const MnStrategy &stra) const
+{
+   MnPrint print("LBFGSSeedGenerator");
+
+   const unsigned int n = st.VariableParameters();
+   const MnMachinePrecision &prec = st.Precision();
+
+   print.Debug(n, "free parameters, FCN pointer", &fcn);
+
+   // initial starting values
+   MnAlgebraicVector x(n);
+   for (unsigned int i = 0; i < n; i++)
+      x(i) = st.IntParameters()[i];
+   double fcnmin = fcn(x);
+
+   MinimumParameters pa(x, fcnmin);
+   InitialGradientCalculator igc(fcn, st.Trafo(), stra);
+   FunctionGradient dgrad = igc(pa);
+
+   // estimated distance to the minimum using the diagonal second derivatives
+   double edm = 0;
+   for (unsigned int i = 0; i < n; i++) {
+      double g2 = dgrad.G2()(i);
+      if (std::fabs(g2) > prec.Eps2())
+         edm += 0.5 * dgrad.Grad()(i) * dgrad.Grad()(i) / std::fabs(g2);
+   }
+
+   // no error matrix is stored
+   MinimumState state(pa, MinimumError(0), dgrad, edm, fcn.NumOfCalls());
+
+   print.Info("Initial state:", MnPrint::Oneline(state));
+
+   return MinimumSeed(state, st.Trafo());
+}
+
+MinimumSeed LBFGSSeedGenerator::operator()(const MnFcn &fcn, const AnalyticalGradientCalculator &gc,
+                                           const MnUserParameterState &st, const MnStrategy &stra) const
+{
+   // the gradient is not used for the seed
+   return (*this)(fcn, static_cast<const GradientCalculator &>(gc), st, stra);
+}
+
+} // namespace Minuit2
+
+} // namespace ROOT
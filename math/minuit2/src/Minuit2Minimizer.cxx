@@ -29,6 +29,7 @@
 #include "Minuit2/MnUserFcn.h"
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/VariableMetricMinimizer.h"
+#include "Minuit2/LBFGSMinimizer.h"
 #include "Minuit2/SimplexMinimizer.h"
 #include "Minuit2/CombinedMinimizer.h"
 #include "Minuit2/ScanMinimizer.h"
@@ -42,10 +43,15 @@
 #include <iostream>
 #include <algorithm>
 #include <functional>
+#include <memory>
 
 #ifdef USE_ROOT_ERROR
 #include "TROOT.h"
 #include "TMinuit2TraceObject.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 #endif
 
 namespace ROOT {
@@ -82,6 +88,25 @@ int ControlPrintLevel()
 void RestoreGlobalPrintLevel(int) {}
 #endif
 
+// set the executor for computing the numerical derivatives in parallel, if the extra option "NumThreads"
+// is larger than zero. It requires ROOT built with IMT and a thread-safe FCN
+void SetParallelExecutor(MnStrategy &strategy, const ROOT::Math::IOptions *minuit2Opt)
+{
+   int nThreads = 0;
+   if (!minuit2Opt || !minuit2Opt->GetValue("NumThreads", nThreads) || nThreads <= 0)
+      return;
+#if defined(USE_ROOT_ERROR) && defined(R__USE_IMT)
+   auto executor = std::make_shared<ROOT::TThreadExecutor>(nThreads);
+   strategy.SetParallelExecutor([executor](unsigned int n, const std::function<void(unsigned int)> &body) {
+      executor->Foreach(body, ROOT::TSeqU(n));
+   });
+#else
+   (void)strategy;
+   MnPrint print("Minuit2Minimizer");
+   print.Warn("Option NumThreads requires ROOT built with IMT; the derivatives are computed serially");
+#endif
+}
+
 Minuit2Minimizer::Minuit2Minimizer(ROOT::Minuit2::EMinimizerType type)
    : Minimizer(), fDim(0), fMinimizer(0), fMinuitFCN(0), fMinimum(0)
 {
@@ -108,6 +133,8 @@ Minuit2Minimizer::Minuit2Minimizer(const char *type) : Minimizer(), fDim(0), fMi
       algoType = kFumili;
    if (algoname == "bfgs")
       algoType = kMigradBFGS;
+   if (algoname == "lbfgs")
+      algoType = kLBFGS;
 
    SetMinimizerType(algoType);
 }
@@ -125,6 +152,9 @@ void Minuit2Minimizer::SetMinimizerType(ROOT::Minuit2::EMinimizerType type)
       // std::cout << "Minuit2Minimizer: minimize using MIGRAD " << std::endl;
       SetMinimizer(new ROOT::Minuit2::VariableMetricMinimizer(VariableMetricMinimizer::BFGSType()));
       return;
+   case ROOT::Minuit2::kLBFGS:
+      SetMinimizer(new ROOT::Minuit2::LBFGSMinimizer());
+      return;
    case ROOT::Minuit2::kSimplex:
       // std::cout << "Minuit2Minimizer: minimize using SIMPLEX " << std::endl;
       SetMinimizer(new ROOT::Minuit2::SimplexMinimizer());
@@ -494,6 +524,8 @@ bool Minuit2Minimizer::Minimize()
       strategy.SetHessianStepTolerance(hessStepTol);
       strategy.SetHessianG2Tolerance(hessStepTol);
 
+      SetParallelExecutor(strategy, minuit2Opt);
+
       int storageLevel = 1;
       bool ret = minuit2Opt->GetValue("StorageLevel", storageLevel);
       if (ret)
@@ -605,10 +637,16 @@ bool Minuit2Minimizer::ExamineMinimum(const ROOT::Minuit2::FunctionMinimum &min)
    fStatus = 0;
    std::string txt;
    if (!min.HasPosDefCovar()) {
-      // this happens normally when Hesse failed
-      // it can happen in case MnSeed failed (see ROOT-9522)
-      txt = "Covar is not pos def";
-      fStatus = 5;
+      if (!min.HasCovariance() && dynamic_cast<const ROOT::Minuit2::LBFGSMinimizer *>(GetMinimizer())) {
+         // LBFGS does not compute the covariance matrix: this is not a failure, the parameter
+         // errors are approximated from the diagonal of the inverse Hessian (run Hesse for the full matrix)
+         txt = "Covar is not computed by LBFGS, errors are approximate";
+      } else {
+         // this happens normally when Hesse failed
+         // it can happen in case MnSeed failed (see ROOT-9522)
+         txt = "Covar is not pos def";
+         fStatus = 5;
+      }
    }
    if (min.HasMadePosDefCovar()) {
       txt = "Covar was made pos def";
@@ -633,6 +671,8 @@ bool Minuit2Minimizer::ExamineMinimum(const ROOT::Minuit2::FunctionMinimum &min)
       // print a warning message in case something is not ok
       if (fStatus != 0 && debugLevel > 0)
          print.Warn(txt);
+      else if (!txt.empty())
+         print.Info(txt);
    } else {
       // minimum is not valid when state is not valid and edm is over max or has passed call limits
       if (fStatus == 0) {
@@ -1207,7 +1247,9 @@ bool Minuit2Minimizer::Hesse()
    if (Precision() > 0)
       fState.SetPrecision(Precision());
 
-   ROOT::Minuit2::MnHesse hesse(strategy);
+   ROOT::Minuit2::MnStrategy hesseStrategy(strategy);
+   SetParallelExecutor(hesseStrategy, ROOT::Math::MinimizerOptions::FindDefault("Minuit2"));
+   ROOT::Minuit2::MnHesse hesse(hesseStrategy);
 
    // case when function minimum exists
    if (fMinimum) {
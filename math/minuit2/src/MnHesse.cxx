@@ -21,6 +21,9 @@
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/MPIProcess.h"
 
+#include <utility>
+#include <vector>
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -130,36 +133,42 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
    print.Debug("Gradient is", st.Gradient().IsAnalytical() ? "analytical" : "numerical", "\n  point:", x,
                "\n  fcn  :", amin, "\n  grad :", grd, "\n  step :", gst, "\n  g2   :", g2);
 
-   for (unsigned int i = 0; i < n; i++) {
+   const MnStrategy::Executor &executor = fStrategy.ParallelExecutor();
 
-      double xtf = x(i);
+   // compute the diagonal element i, varying x(i) (it is restored at the end)
+   // return false if the second derivative is zero
+   // the cycles are only printed in serial execution, since the MnPrint prefix stack is thread-local
+   auto diagonalElement = [&](unsigned int i, MnAlgebraicVector &xv, bool printCycles) {
+      double xtf = xv(i);
       double dmin = 8. * prec.Eps2() * (std::fabs(xtf) + prec.Eps2());
       double d = std::fabs(gst(i));
       if (d < dmin)
          d = dmin;
 
-      print.Debug("Derivative parameter", i, "d =", d, "dmin =", dmin);
+      if (printCycles)
+         print.Debug("Derivative parameter", i, "d =", d, "dmin =", dmin);
 
       for (unsigned int icyc = 0; icyc < Ncycles(); icyc++) {
          double sag = 0.;
          double fs1 = 0.;
          double fs2 = 0.;
          for (unsigned int multpy = 0; multpy < 5; multpy++) {
-            x(i) = xtf + d;
-            fs1 = mfcn(x);
-            x(i) = xtf - d;
-            fs2 = mfcn(x);
-            x(i) = xtf;
+            xv(i) = xtf + d;
+            fs1 = mfcn(xv);
+            xv(i) = xtf - d;
+            fs2 = mfcn(xv);
+            xv(i) = xtf;
             sag = 0.5 * (fs1 + fs2 - 2. * amin);
 
-            print.Debug("cycle", icyc, "mul", multpy, "\tsag =", sag, "d =", d);
+            if (printCycles)
+               print.Debug("cycle", icyc, "mul", multpy, "\tsag =", sag, "d =", d);
 
             //  Now as F77 Minuit - check that sag is not zero
             if (sag != 0)
-               goto L30; // break
+               break;
             if (trafo.Parameter(i).HasLimits()) {
                if (d > 0.5)
-                  goto L26;
+                  return false;
                d *= 10.;
                if (d > 0.5)
                   d = 0.51;
@@ -167,22 +176,9 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
             }
             d *= 10.;
          }
+         if (sag == 0)
+            return false;
 
-      L26:
-         // get parameter name for i
-         // (need separate scope for avoiding compl error when declaring name)
-         print.Warn("2nd derivative zero for parameter", trafo.Name(trafo.ExtOfInt(i)),
-                    "; MnHesse fails and will return diagonal matrix");
-
-         for (unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1. / g2(j);
-            vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed), st.Gradient(), st.Edm(),
-                             mfcn.NumOfCalls());
-
-      L30:
          double g2bfor = g2(i);
          g2(i) = 2. * sag / (d * d);
          grd(i) = (fs1 - fs2) / (2. * d);
@@ -196,8 +192,9 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
          if (d < dmin)
             d = dmin;
 
-         print.Debug("g1 =", grd(i), "g2 =", g2(i), "step =", gst(i), "d =", d, "diffd =", std::fabs(d - dlast) / d,
-                     "diffg2 =", std::fabs(g2(i) - g2bfor) / g2(i));
+         if (printCycles)
+            print.Debug("g1 =", grd(i), "g2 =", g2(i), "step =", gst(i), "d =", d,
+                        "diffd =", std::fabs(d - dlast) / d, "diffg2 =", std::fabs(g2(i) - g2bfor) / g2(i));
 
          // see if converged
          if (std::fabs((d - dlast) / d) < Tolerstp())
@@ -208,18 +205,49 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
          d = std::max(d, 0.1 * dlast);
       }
       vhmat(i, i) = g2(i);
-      if (mfcn.NumOfCalls() > maxcalls) {
-
-         // std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
-         print.Warn("Maximum number of allowed function calls exhausted; will return diagonal matrix");
-
-         for (unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1. / g2(j);
-            vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
+      return true;
+   };
 
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed), st.Gradient(), st.Edm(),
-                             mfcn.NumOfCalls());
+   // diagonal matrix returned in case of failure
+   auto diagonalState = [&](int status) {
+      for (unsigned int j = 0; j < n; j++) {
+         double tmp = g2(j) < prec.Eps2() ? 1. : 1. / g2(j);
+         vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
+      }
+      return MinimumState(st.Parameters(), MinimumError(vhmat, status), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+   };
+
+   auto zeroDerivativeState = [&](unsigned int i) {
+      print.Warn("2nd derivative zero for parameter", trafo.Name(trafo.ExtOfInt(i)),
+                 "; MnHesse fails and will return diagonal matrix");
+      return diagonalState(MinimumError::MnHesseFailed);
+   };
+
+   auto maxCallsState = [&]() {
+      print.Warn("Maximum number of allowed function calls exhausted; will return diagonal matrix");
+      return diagonalState(MinimumError::MnHesseFailed);
+   };
+
+   if (executor) {
+      // the diagonal elements are independent: each task works on its own copy of the point
+      // (the limit on the function calls can only be checked once all of them are done)
+      std::vector<char> valid(n);
+      executor(n, [&](unsigned int i) {
+         MnAlgebraicVector xv = x;
+         valid[i] = diagonalElement(i, xv, false);
+      });
+      for (unsigned int i = 0; i < n; i++) {
+         if (!valid[i])
+            return zeroDerivativeState(i);
+      }
+      if (mfcn.NumOfCalls() > maxcalls)
+         return maxCallsState();
+   } else {
+      for (unsigned int i = 0; i < n; i++) {
+         if (!diagonalElement(i, x, true))
+            return zeroDerivativeState(i);
+         if (mfcn.NumOfCalls() > maxcalls)
+            return maxCallsState();
       }
    }
 
@@ -235,8 +263,26 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
    }
 
    // off-diagonal Elements
-   // initial starting values
-   if (n > 0) {
+   if (n > 0 && executor) {
+      // all n(n-1)/2 elements are independent: each task works on its own copy of the point
+      std::vector<std::pair<unsigned int, unsigned int>> elements;
+      elements.reserve(n * (n - 1) / 2);
+      for (unsigned int i = 0; i < n; i++) {
+         for (unsigned int j = i + 1; j < n; j++)
+            elements.emplace_back(i, j);
+      }
+
+      executor(elements.size(), [&](unsigned int in) {
+         const unsigned int i = elements[in].first;
+         const unsigned int j = elements[in].second;
+         MnAlgebraicVector xv = x;
+         xv(i) += dirin(i);
+         xv(j) += dirin(j);
+         double fs1 = mfcn(xv);
+         vhmat(i, j) = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
+      });
+   } else if (n > 0) {
+      // initial starting values
       MPIProcess mpiprocOffDiagonal(n * (n - 1) / 2, 0);
       unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
       unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
@@ -21,6 +21,10 @@ namespace Minuit2 {
 int mneigen(double *a, unsigned int ndima, unsigned int n, unsigned int mits, double *work, double precis)
 {
    // compute matrix eignevalues (transaltion from mneig.F of Minuit)
+   // Only the eigenvalues are computed (returned sorted in work[0..n-1]), the eigenvectors are not
+   // accumulated and the content of the symmetric matrix a is destroyed.
+   // The matrix is traversed row by row (a is symmetric, so this is the transpose of the Fortran
+   // column order) to keep the O(n^3) loops on contiguous memory; the arithmetic is unchanged.
 
    /* System generated locals */
    unsigned int a_dim1, a_offset, i__1, i__2, i__3;
@@ -30,7 +34,7 @@ int mneigen(double *a, unsigned int ndima, unsigned int n, unsigned int mits, do
    double b, c__, f, h__;
    unsigned int i__, j, k, l, m = 0;
    double r__, s;
-   unsigned int i0, i1, j1, m1, n1;
+   unsigned int i0, i1, m1, n1;
    double hh, gl, pr, pt;
 
    /*          PRECIS is the machine precision EPSMAC */
@@ -47,7 +51,7 @@ int mneigen(double *a, unsigned int ndima, unsigned int n, unsigned int mits, do
    i__1 = n;
    for (i1 = 2; i1 <= i__1; ++i1) {
       l = i__ - 2;
-      f = a[i__ + (i__ - 1) * a_dim1];
+      f = a[i__ - 1 + i__ * a_dim1];
       gl = (double)0.;
 
       if (l < 1) {
@@ -57,7 +61,7 @@ int mneigen(double *a, unsigned int ndima, unsigned int n, unsigned int mits, do
       i__2 = l;
       for (k = 1; k <= i__2; ++k) {
          /* Computing 2nd power */
-         r__1 = a[i__ + k * a_dim1];
+         r__1 = a[k + i__ * a_dim1];
          gl += r__1 * r__1;
       }
    L25:
@@ -83,39 +87,42 @@ int mneigen(double *a, unsigned int ndima, unsigned int n, unsigned int mits, do
 
       work[n + i__] = gl;
       h__ -= f * gl;
-      a[i__ + (i__ - 1) * a_dim1] = f - gl;
+      a[i__ - 1 + i__ * a_dim1] = f - gl;
       f = (double)0.;
       i__2 = l;
       for (j = 1; j <= i__2; ++j) {
-         a[j + i__ * a_dim1] = a[i__ + j * a_dim1] / h__;
+         a[i__ + j * a_dim1] = a[j + i__ * a_dim1] / h__;
          gl = (double)0.;
          i__3 = j;
          for (k = 1; k <= i__3; ++k) {
-            gl += a[j + k * a_dim1] * a[i__ + k * a_dim1];
+            gl += a[k + j * a_dim1] * a[k + i__ * a_dim1];
          }
-
-         if (j >= l) {
-            goto L47;
-         }
-
-         j1 = j + 1;
-         i__3 = l;
-         for (k = j1; k <= i__3; ++k) {
-            gl += a[k + j * a_dim1] * a[i__ + k * a_dim1];
+         work[n + j] = gl;
+      }
+      /* add the terms k > j row by row (contiguous), in the same order for each j */
+      i__2 = l;
+      for (k = 2; k <= i__2; ++k) {
+         r__1 = a[k + i__ * a_dim1];
+         i__3 = k - 1;
+         for (j = 1; j <= i__3; ++j) {
+            work[n + j] += a[j + k * a_dim1] * r__1;
          }
-      L47:
+      }
+      i__2 = l;
+      for (j = 1; j <= i__2; ++j) {
+         gl = work[n + j];
          work[n + j] = gl / h__;
-         f += gl * a[j + i__ * a_dim1];
+         f += gl * a[i__ + j * a_dim1];
       }
       hh = f / (h__ + h__);
       i__2 = l;
       for (j = 1; j <= i__2; ++j) {
-         f = a[i__ + j * a_dim1];
+         f = a[j + i__ * a_dim1];
          gl = work[n + j] - hh * f;
          work[n + j] = gl;
          i__3 = j;
          for (k = 1; k <= i__3; ++k) {
-            a[j + k * a_dim1] = a[j + k * a_dim1] - f * work[n + k] - gl * a[i__ + k * a_dim1];
+            a[k + j * a_dim1] = a[k + j * a_dim1] - f * work[n + k] - gl * a[k + i__ * a_dim1];
          }
       }
       work[i__] = h__;
@@ -126,38 +133,7 @@ int mneigen(double *a, unsigned int ndima, unsigned int n, unsigned int mits, do
    work[n + 1] = (double)0.;
    i__1 = n;
    for (i__ = 1; i__ <= i__1; ++i__) {
-      l = i__ - 1;
-
-      if (work[i__] == (double)0. || l == 0) {
-         goto L100;
-      }
-
-      i__3 = l;
-      for (j = 1; j <= i__3; ++j) {
-         gl = (double)0.;
-         i__2 = l;
-         for (k = 1; k <= i__2; ++k) {
-            gl += a[i__ + k * a_dim1] * a[k + j * a_dim1];
-         }
-         i__2 = l;
-         for (k = 1; k <= i__2; ++k) {
-            a[k + j * a_dim1] -= gl * a[k + i__ * a_dim1];
-         }
-      }
-   L100:
       work[i__] = a[i__ + i__ * a_dim1];
-      a[i__ + i__ * a_dim1] = (double)1.;
-
-      if (l == 0) {
-         goto L110;
-      }
-
-      i__2 = l;
-      for (j = 1; j <= i__2; ++j) {
-         a[i__ + j * a_dim1] = (double)0.;
-         a[j + i__ * a_dim1] = (double)0.;
-      }
-   L110:;
    }
 
    n1 = n - 1;
@@ -243,12 +219,6 @@ int mneigen(double *a, unsigned int ndima, unsigned int n, unsigned int mits, do
       L190:
          pt = c__ * work[i__] - s * gl;
          work[j] = h__ + s * (c__ * gl + s * work[i__]);
-         i__3 = n;
-         for (k = 1; k <= i__3; ++k) {
-            h__ = a[k + j * a_dim1];
-            a[k + j * a_dim1] = s * a[k + i__ * a_dim1] + c__ * h__;
-            a[k + i__ * a_dim1] = c__ * a[k + i__ * a_dim1] - s * h__;
-         }
       }
       work[n + l] = s * pt;
       work[l] = c__ * pt;
@@ -283,12 +253,6 @@ int mneigen(double *a, unsigned int ndima, unsigned int n, unsigned int mits, do
 
       work[k] = work[i__];
       work[i__] = pt;
-      i__3 = n;
-      for (j = 1; j <= i__3; ++j) {
-         pt = a[j + i__ * a_dim1];
-         a[j + i__ * a_dim1] = a[j + k * a_dim1];
-         a[j + k * a_dim1] = pt;
-      }
    L240:;
    }
    ifault = 0;
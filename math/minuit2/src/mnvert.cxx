@@ -18,6 +18,11 @@ namespace Minuit2 {
 /** Inverts a symmetric matrix. Matrix is first scaled to have all ones on
     the diagonal (equivalent to change of units) but no pivoting is done
     since matrix is positive-definite.
+
+    The Elements are accessed directly in the packed storage of the Upper
+    triangle, column by column, so that the O(n^3) updates run over
+    contiguous memory (element (j,k), j <= k, is stored at j + k*(k+1)/2).
+    The arithmetic is the same as in the Fortran Minuit version.
  */
 
 int mnvert(MnAlgebraicSymMatrix &a)
@@ -28,47 +33,56 @@ int mnvert(MnAlgebraicSymMatrix &a)
    MnAlgebraicVector q(nrow);
    MnAlgebraicVector pp(nrow);
 
+   double *ap = a.Data();
+   double *sp = s.Data();
+   double *qp = q.Data();
+   double *ppp = pp.Data();
+
    for (unsigned int i = 0; i < nrow; i++) {
       double si = a(i, i);
       if (si < 0.)
          return 1;
-      s(i) = 1. / std::sqrt(si);
+      sp[i] = 1. / std::sqrt(si);
    }
 
-   for (unsigned int i = 0; i < nrow; i++)
-      for (unsigned int j = i; j < nrow; j++)
-         a(i, j) *= (s(i) * s(j));
+   for (unsigned int k = 0, kk = 0; k < nrow; kk += ++k) {
+      double *col = ap + kk;
+      for (unsigned int j = 0; j <= k; j++)
+         col[j] *= (sp[j] * sp[k]);
+   }
 
-   for (unsigned i = 0; i < nrow; i++) {
-      unsigned int k = i;
-      if (a(k, k) == 0.)
+   for (unsigned int k = 0; k < nrow; k++) {
+      double *colk = ap + k * (k + 1) / 2;
+      if (colk[k] == 0.)
          return 1;
-      q(k) = 1. / a(k, k);
-      pp(k) = 1.;
-      a(k, k) = 0.;
-      unsigned int kp1 = k + 1;
-      if (k != 0) {
-         for (unsigned int j = 0; j < k; j++) {
-            pp(j) = a(j, k);
-            q(j) = a(j, k) * q(k);
-            a(j, k) = 0.;
-         }
+      qp[k] = 1. / colk[k];
+      ppp[k] = 1.;
+      colk[k] = 0.;
+      for (unsigned int j = 0; j < k; j++) {
+         ppp[j] = colk[j];
+         qp[j] = colk[j] * qp[k];
+         colk[j] = 0.;
       }
-      if (k != nrow - 1) {
-         for (unsigned int j = kp1; j < nrow; j++) {
-            pp(j) = a(k, j);
-            q(j) = -a(k, j) * q(k);
-            a(k, j) = 0.;
-         }
+      for (unsigned int j = k + 1; j < nrow; j++) {
+         double &akj = ap[k + j * (j + 1) / 2];
+         ppp[j] = akj;
+         qp[j] = -akj * qp[k];
+         akj = 0.;
+      }
+      // rank one update of the Upper triangle, a(j,l) += pp(j) * q(l) for j <= l
+      for (unsigned int l = 0, ll = 0; l < nrow; ll += ++l) {
+         double *col = ap + ll;
+         const double ql = qp[l];
+         for (unsigned int j = 0; j <= l; j++)
+            col[j] += (ppp[j] * ql);
       }
-      for (unsigned int j = 0; j < nrow; j++)
-         for (k = j; k < nrow; k++)
-            a(j, k) += (pp(j) * q(k));
    }
 
-   for (unsigned int j = 0; j < nrow; j++)
-      for (unsigned int k = j; k < nrow; k++)
-         a(j, k) *= (s(j) * s(k));
+   for (unsigned int k = 0, kk = 0; k < nrow; kk += ++k) {
+      double *col = ap + kk;
+      for (unsigned int j = 0; j <= k; j++)
+         col[j] *= (sp[j] * sp[k]);
+   }
 
    return 0;
 }
@@ -0,0 +1,62 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef MN_ChainFCN_H_
+#define MN_ChainFCN_H_
+
+#include "Minuit2/FCNGradientBase.h"
+
+#include <vector>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+// sum of quadratic and quartic terms, with correlations between neighbouring parameters.
+// The function and its gradient cost O(n), for tests with a large number of parameters.
+class ChainFCN : public FCNGradientBase {
+
+public:
+   double operator()(const std::vector<double> &p) const
+   {
+      double f = 0;
+      for (unsigned int i = 0; i < p.size(); ++i) {
+         double di = p[i] - Mean(i);
+         f += 0.5 * di * di + 0.01 * di * di * di * di;
+         if (i > 0)
+            f += 0.3 * di * (p[i - 1] - Mean(i - 1));
+      }
+      return f;
+   }
+
+   std::vector<double> Gradient(const std::vector<double> &p) const
+   {
+      std::vector<double> g(p.size());
+      for (unsigned int i = 0; i < p.size(); ++i) {
+         double di = p[i] - Mean(i);
+         g[i] += di + 0.04 * di * di * di;
+         if (i > 0) {
+            double dim1 = p[i - 1] - Mean(i - 1);
+            g[i] += 0.3 * dim1;
+            g[i - 1] += 0.3 * di;
+         }
+      }
+      return g;
+   }
+
+   bool CheckGradient() const { return false; }
+   double Up() const { return 0.5; }
+
+   static double Mean(unsigned int i) { return 0.1 * (i % 10); }
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // MN_ChainFCN_H_
@@ -0,0 +1,125 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/LBFGSMinimizer.h"
+#include "ChainFCN.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// test of the limited-memory BFGS minimizer (LBFGSMinimizer): the minimum must agree
+// with the one found by Migrad (with analytical and numerical derivatives) and the parameter errors must be a reasonable
+// approximation of the ones from Hesse. It is then run with a large number of parameters
+// (default 5000), which can be changed by doing:
+// ./LBFGSTest  n
+
+using namespace ROOT::Minuit2;
+
+// same function using the numerical derivatives
+struct ChainNumFCN : public FCNBase {
+   double operator()(const std::vector<double> &p) const { return fFCN(p); }
+   double Up() const { return fFCN.Up(); }
+   ChainFCN fFCN;
+};
+
+MnUserParameterState initialState(unsigned int npar)
+{
+   MnUserParameterState init;
+   for (unsigned int i = 0; i < npar; ++i)
+      init.Add("p" + std::to_string(i), 1., 0.1);
+   return init;
+}
+
+int compareWithMigrad(unsigned int npar)
+{
+   ChainFCN fcn;
+   ChainNumFCN numfcn;
+   MnUserParameterState init = initialState(npar);
+
+   FunctionMinimum migradMin = MnMigrad(fcn, init, MnStrategy(1))();
+   MnUserParameterState hesseState = MnHesse()(fcn, migradMin.UserState());
+
+   LBFGSMinimizer lbfgs;
+   FunctionMinimum min = lbfgs.Minimize(fcn, init, MnStrategy(1));
+   FunctionMinimum numMin = lbfgs.Minimize(numfcn, init, MnStrategy(1));
+
+   int iret = 0;
+   if (!min.IsValid() || !numMin.IsValid()) {
+      std::cerr << "LBFGSTest: invalid minimum" << std::endl;
+      iret = 1;
+   }
+   if (min.UserState().HasCovariance()) {
+      std::cerr << "LBFGSTest: the L-BFGS minimum should not have a covariance matrix" << std::endl;
+      iret = 1;
+   }
+   for (unsigned int i = 0; i < npar; ++i) {
+      // both Migrad and L-BFGS stop within ~0.01 of the true minimum (errors are ~1)
+      double expected = ChainFCN::Mean(i);
+      if (std::fabs(migradMin.UserState().Value(i) - expected) > 0.01 ||
+          std::fabs(min.UserState().Value(i) - expected) > 0.01 ||
+          std::fabs(numMin.UserState().Value(i) - expected) > 0.01) {
+         std::cerr << "LBFGSTest: wrong value for parameter " << i << ": " << min.UserState().Value(i) << " and "
+                   << numMin.UserState().Value(i) << " (Migrad " << migradMin.UserState().Value(i) << ") instead of "
+                   << expected << std::endl;
+         iret = 1;
+      }
+      // the approximated errors are within a factor 2 of the Hesse ones
+      double err = min.UserState().Error(i);
+      if (!(err > 0.5 * hesseState.Error(i) && err < 2. * hesseState.Error(i))) {
+         std::cerr << "LBFGSTest: wrong error for parameter " << i << ": " << err << " instead of "
+                   << hesseState.Error(i) << std::endl;
+         iret = 1;
+      }
+   }
+   std::cout << "LBFGSTest: npar " << npar << "\tMigrad " << migradMin.NFcn() << " calls, L-BFGS " << min.NFcn()
+             << " calls, L-BFGS with numerical derivatives " << numMin.NFcn() << " calls" << std::endl;
+   return iret;
+}
+
+int largeFit(unsigned int npar)
+{
+   ChainFCN fcn;
+   MnUserParameterState init = initialState(npar);
+
+   auto t0 = std::chrono::steady_clock::now();
+   FunctionMinimum min = LBFGSMinimizer().Minimize(fcn, init, MnStrategy(1));
+   auto t1 = std::chrono::steady_clock::now();
+
+   std::cout << "LBFGSTest: npar " << npar << "\tL-BFGS: " << std::chrono::duration<double>(t1 - t0).count()
+             << " s, " << min.NFcn() << " calls" << std::endl;
+
+   if (!min.IsValid()) {
+      std::cerr << "LBFGSTest: fit with " << npar << " parameters failed" << std::endl;
+      return 1;
+   }
+   for (unsigned int i = 0; i < npar; ++i) {
+      if (std::fabs(min.UserState().Value(i) - ChainFCN::Mean(i)) > 0.01) {
+         std::cerr << "LBFGSTest: wrong value for parameter " << i << std::endl;
+         return 1;
+      }
+   }
+   return 0;
+}
+
+int main(int argc, char **argv)
+{
+   unsigned int npar = (argc > 1) ? atoi(argv[1]) : 5000;
+
+   int iret = compareWithMigrad(20);
+   iret += largeFit(npar);
+   return iret;
+}
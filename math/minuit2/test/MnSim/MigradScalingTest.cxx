@@ -0,0 +1,74 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnStrategy.h"
+#include "ChainFCN.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// benchmark of Migrad and Hesse as a function of the number of parameters.
+// The function and its gradient cost O(n), so that the time is dominated by the
+// linear algebra of Minuit (the O(n^2) updates of the error matrix in each iteration,
+// the O(n^3) inversion and eigenvalues of the Hessian matrix).
+// One can change the list of the number of parameters by doing:
+// ./MigradScalingTest  n1 n2 ...
+
+using namespace ROOT::Minuit2;
+
+int doFit(unsigned int npar)
+{
+   ChainFCN fcn;
+
+   MnUserParameterState init;
+   for (unsigned int i = 0; i < npar; ++i)
+      init.Add("p" + std::to_string(i), 1., 0.1);
+
+   auto t0 = std::chrono::steady_clock::now();
+   FunctionMinimum min = MnMigrad(fcn, init, MnStrategy(1))();
+   auto t1 = std::chrono::steady_clock::now();
+   MnUserParameterState state = MnHesse()(fcn, min.UserState());
+   auto t2 = std::chrono::steady_clock::now();
+
+   std::cout << "npar " << npar << "\tMigrad: " << std::chrono::duration<double>(t1 - t0).count() << " s, "
+             << min.NFcn() << " calls\tHesse: " << std::chrono::duration<double>(t2 - t1).count() << " s" << std::endl;
+
+   if (!min.IsValid() || !state.IsValid()) {
+      std::cerr << "MigradScalingTest: fit with " << npar << " parameters failed" << std::endl;
+      return 1;
+   }
+   for (unsigned int i = 0; i < npar; ++i) {
+      if (std::fabs(state.Value(i) - ChainFCN::Mean(i)) > 0.01) {
+         std::cerr << "MigradScalingTest: wrong value for parameter " << i << std::endl;
+         return 1;
+      }
+   }
+   return 0;
+}
+
+int main(int argc, char **argv)
+{
+   std::vector<unsigned int> npars;
+   for (int i = 1; i < argc; ++i)
+      npars.push_back(atoi(argv[i]));
+   if (npars.empty())
+      npars = {10, 50, 100, 200};
+
+   int iret = 0;
+   for (unsigned int npar : npars)
+      iret += doFit(npar);
+   return iret;
+}
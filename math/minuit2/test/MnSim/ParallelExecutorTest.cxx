@@ -0,0 +1,157 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2026 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/MnPrint.h"
+
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// test computing the numerical gradient and the Hessian matrix with a parallel executor
+// (see MnStrategy::SetParallelExecutor): the results must agree with the serial computation
+
+using namespace ROOT::Minuit2;
+
+// correlated quadratic function with a quartic term, which is thread safe
+struct CorrelatedFCN : public FCNBase {
+
+   CorrelatedFCN(unsigned int n) : fN(n) {}
+
+   double operator()(const std::vector<double> &p) const
+   {
+      double f = 0;
+      for (unsigned int i = 0; i < fN; ++i) {
+         double di = p[i] - i;
+         f += 0.5 * di * di / (1. + 0.1 * i) + 0.01 * di * di * di * di;
+         if (i > 0)
+            f += 0.2 * di * (p[i - 1] - (i - 1));
+      }
+      return f;
+   }
+   double Up() const { return 0.5; }
+
+   unsigned int fN;
+};
+
+// executor running the calls on a few threads
+struct ThreadExecutor {
+
+   void operator()(unsigned int n, const std::function<void(unsigned int)> &body)
+   {
+      ++fNumCalls;
+      std::atomic<unsigned int> next{0};
+      std::vector<std::thread> threads;
+      for (unsigned int t = 0; t < 4; ++t) {
+         threads.emplace_back([&]() {
+            for (unsigned int i = next++; i < n; i = next++)
+               body(i);
+         });
+      }
+      for (auto &thread : threads)
+         thread.join();
+   }
+
+   std::atomic<int> &fNumCalls;
+};
+
+bool isClose(double a, double b, double tol = 1.E-8)
+{
+   return std::fabs(a - b) <= tol * std::max(1., std::max(std::fabs(a), std::fabs(b)));
+}
+
+// the debug printouts of the serial computation must not be done from the threads of the
+// executor, where the (thread-local) MnPrint prefix stack is empty
+int testDebugPrint()
+{
+   const unsigned int n = 3;
+   CorrelatedFCN fcn(n);
+
+   MnUserParameterState init;
+   for (unsigned int i = 0; i < n; ++i)
+      init.Add("p" + std::to_string(i), 0.5 * i + 1., 0.1);
+
+   std::atomic<int> numCalls{0};
+   MnStrategy strategy(2);
+   strategy.SetParallelExecutor(ThreadExecutor{numCalls});
+
+   int prevLevel = MnPrint::SetGlobalLevel(3); // debug level
+   FunctionMinimum min = MnMigrad(fcn, init, strategy)();
+   MnUserParameterState state = MnHesse(strategy)(fcn, min.UserState());
+   MnPrint::SetGlobalLevel(prevLevel);
+
+   if (!min.IsValid() || !state.HasCovariance()) {
+      std::cerr << "ParallelExecutorTest: invalid minimum with debug printouts" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+int main()
+{
+   int iret = testDebugPrint();
+
+   const unsigned int n = 12;
+   CorrelatedFCN fcn(n);
+
+   MnUserParameterState init;
+   for (unsigned int i = 0; i < n; ++i)
+      init.Add("p" + std::to_string(i), 0.5 * i + 1., 0.1);
+
+   std::atomic<int> numCalls{0};
+   MnStrategy serialStrategy(2);
+   MnStrategy parallelStrategy(2);
+   parallelStrategy.SetParallelExecutor(ThreadExecutor{numCalls});
+
+   FunctionMinimum serialMin = MnMigrad(fcn, init, serialStrategy)();
+   FunctionMinimum parallelMin = MnMigrad(fcn, init, parallelStrategy)();
+
+   if (numCalls == 0) {
+      std::cerr << "ParallelExecutorTest: the executor has not been used" << std::endl;
+      iret = 1;
+   }
+   if (!serialMin.IsValid() || !parallelMin.IsValid()) {
+      std::cerr << "ParallelExecutorTest: invalid minimum" << std::endl;
+      iret = 1;
+   }
+   if (serialMin.NFcn() != parallelMin.NFcn()) {
+      std::cerr << "ParallelExecutorTest: different number of calls " << serialMin.NFcn() << " and "
+                << parallelMin.NFcn() << std::endl;
+      iret = 1;
+   }
+
+   MnUserParameterState serialState = MnHesse(serialStrategy)(fcn, serialMin.UserState());
+   MnUserParameterState parallelState = MnHesse(parallelStrategy)(fcn, serialMin.UserState());
+
+   for (unsigned int i = 0; i < n; ++i) {
+      if (!isClose(serialMin.UserState().Value(i), parallelMin.UserState().Value(i))) {
+         std::cerr << "ParallelExecutorTest: different value for parameter " << i << std::endl;
+         iret = 1;
+      }
+      for (unsigned int j = 0; j <= i; ++j) {
+         if (!isClose(serialState.Covariance()(i, j), parallelState.Covariance()(i, j))) {
+            std::cerr << "ParallelExecutorTest: different covariance for parameters " << i << "," << j << ": "
+                      << serialState.Covariance()(i, j) << " and " << parallelState.Covariance()(i, j) << std::endl;
+            iret = 1;
+         }
+      }
+   }
+
+   if (iret == 0)
+      std::cout << "ParallelExecutorTest: OK, executor called " << numCalls << " times" << std::endl;
+   return iret;
+}
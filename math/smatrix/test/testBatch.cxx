@@ -0,0 +1,255 @@
+// test and timing of the batched matrices (SMatrixBatch, SMatrixSymBatch, SVectorBatch)
+// against the equivalent SMatrix operations, for the Kalman filter update of a
+// 5 parameters track with a 2D measurement
+#include "Math/SMatrix.h"
+#include "Math/SVector.h"
+#include "Math/SMatrixBatch.h"
+
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace ROOT::Math;
+
+constexpr unsigned int NBATCH = 8;     // number of tracks processed together
+constexpr unsigned int NTRACKS = 8000; // number of tracks
+constexpr int NLOOP = 100;             // number of times the test is repeated for the timing
+
+typedef SMatrix<double, 5, 5, MatRepSym<double, 5>> SymMatrix5;
+typedef SMatrix<double, 2, 2, MatRepSym<double, 2>> SymMatrix2;
+typedef SMatrix<double, 2, 5> Matrix25;
+typedef SMatrix<double, 5, 2> Matrix52;
+typedef SVector<double, 5> Vector5;
+typedef SVector<double, 2> Vector2;
+
+typedef SMatrixSymBatch<double, 5, NBATCH> SymMatrix5Batch;
+typedef SMatrixSymBatch<double, 2, NBATCH> SymMatrix2Batch;
+typedef SMatrixBatch<double, 2, 5, NBATCH> Matrix25Batch;
+typedef SMatrixBatch<double, 5, 2, NBATCH> Matrix52Batch;
+typedef SVectorBatch<double, 5, NBATCH> Vector5Batch;
+typedef SVectorBatch<double, 2, NBATCH> Vector2Batch;
+
+struct Track {
+   Vector5 fPar;
+   SymMatrix5 fCov;
+   Matrix25 fH;
+   SymMatrix2 fV;
+   Vector2 fMeas;
+   double fChi2;
+};
+
+// generate a positive definite covariance matrix (see testInversion.cxx)
+void genCovariance(TRandom &r, SymMatrix5 &m)
+{
+   for (int i = 0; i < 5; ++i)
+      m(i, i) = r.Uniform(0.1, 100.);
+   for (int i = 0; i < 5; ++i)
+      for (int j = 0; j < i; ++j)
+         m(i, j) = r.Uniform(0, 0.3 * std::sqrt(m(i, i) * m(j, j)));
+}
+
+void genTracks(std::vector<Track> &tracks)
+{
+   TRandom3 r(111);
+   for (auto &t : tracks) {
+      for (int i = 0; i < 5; ++i)
+         t.fPar[i] = r.Gaus(0, 1);
+      genCovariance(r, t.fCov);
+      for (int i = 0; i < 2; ++i)
+         for (int j = 0; j < 5; ++j)
+            t.fH(i, j) = r.Uniform(-1, 1);
+      t.fV(0, 0) = r.Uniform(0.01, 0.1);
+      t.fV(1, 1) = r.Uniform(0.01, 0.1);
+      t.fV(1, 0) = 0.3 * std::sqrt(t.fV(0, 0) * t.fV(1, 1));
+      t.fMeas[0] = r.Gaus(0, 1);
+      t.fMeas[1] = r.Gaus(0, 1);
+      t.fChi2 = 0;
+   }
+}
+
+// Kalman filter update of one track
+bool update(Track &t)
+{
+   Vector2 res = t.fMeas - t.fH * t.fPar;
+   SymMatrix2 rinv = t.fV + Similarity(t.fH, t.fCov);
+   if (!rinv.InvertChol())
+      return false;
+   Matrix52 cht = t.fCov * Transpose(t.fH);
+   t.fPar += cht * (rinv * res);
+   t.fCov -= Similarity(cht, rinv);
+   t.fChi2 = Similarity(rinv, res);
+   return true;
+}
+
+// Kalman filter update of NBATCH tracks
+bool update(Vector5Batch &par, SymMatrix5Batch &cov, const Matrix25Batch &h, const SymMatrix2Batch &v,
+            const Vector2Batch &meas, SVector<double, NBATCH> &chi2)
+{
+   Vector2Batch res = meas - h * par;
+   SymMatrix2Batch rinv = v + Similarity(h, cov);
+   if (!rinv.Invert())
+      return false;
+   Matrix52Batch cht = cov * Transpose(h);
+   par += cht * (rinv * res);
+   cov -= Similarity(cht, rinv);
+   chi2 = Similarity(rinv, res);
+   return true;
+}
+
+bool isClose(double a, double b, double tol = 1.E-10)
+{
+   return std::fabs(a - b) <= tol * std::max(1., std::max(std::fabs(a), std::fabs(b)));
+}
+
+int testKalman()
+{
+   std::vector<Track> tracks(NTRACKS);
+   genTracks(tracks);
+   std::vector<Track> scalarTracks(tracks);
+
+   // fill the batches
+   const unsigned int nbatches = NTRACKS / NBATCH;
+   std::vector<Vector5Batch> par(nbatches);
+   std::vector<SymMatrix5Batch> cov(nbatches);
+   std::vector<Matrix25Batch> h(nbatches);
+   std::vector<SymMatrix2Batch> v(nbatches);
+   std::vector<Vector2Batch> meas(nbatches);
+   std::vector<SVector<double, NBATCH>> chi2(nbatches);
+   for (unsigned int i = 0; i < NTRACKS; ++i) {
+      const unsigned int b = i / NBATCH;
+      const unsigned int n = i % NBATCH;
+      par[b].Set(n, tracks[i].fPar);
+      cov[b].Set(n, tracks[i].fCov);
+      h[b].Set(n, tracks[i].fH);
+      v[b].Set(n, tracks[i].fV);
+      meas[b].Set(n, tracks[i].fMeas);
+   }
+
+   int iret = 0;
+   for (auto &t : scalarTracks) {
+      if (!update(t)) {
+         std::cerr << "testKalman: inversion failed with SMatrix" << std::endl;
+         iret = 1;
+      }
+   }
+   for (unsigned int b = 0; b < nbatches; ++b) {
+      if (!update(par[b], cov[b], h[b], v[b], meas[b], chi2[b])) {
+         std::cerr << "testKalman: inversion failed with SMatrixSymBatch" << std::endl;
+         iret = 1;
+      }
+   }
+
+   for (unsigned int i = 0; i < NTRACKS && iret == 0; ++i) {
+      const unsigned int b = i / NBATCH;
+      const unsigned int n = i % NBATCH;
+      const Track &t = scalarTracks[i];
+      bool ok = isClose(t.fChi2, chi2[b][n]);
+      for (int k = 0; k < 5; ++k) {
+         ok = ok && isClose(t.fPar[k], par[b].At(n, k));
+         for (int l = 0; l <= k; ++l)
+            ok = ok && isClose(t.fCov(k, l), cov[b].At(n, k, l));
+      }
+      if (!ok) {
+         std::cerr << "testKalman: different result for track " << i << std::endl;
+         std::cerr << "SMatrix:\n" << t.fCov << "\nSMatrixSymBatch:\n" << cov[b].Get(n) << std::endl;
+         iret = 1;
+      }
+   }
+
+   // timing
+   {
+      TStopwatch w;
+      for (int iloop = 0; iloop < NLOOP; ++iloop) {
+         std::vector<Track> work(tracks);
+         for (auto &t : work)
+            update(t);
+      }
+      w.Stop();
+      std::cout << "SMatrix Kalman update of " << NTRACKS << " tracks x " << NLOOP << "\ttime = " << w.RealTime()
+                << " (sec)" << std::endl;
+   }
+   {
+      TStopwatch w;
+      for (int iloop = 0; iloop < NLOOP; ++iloop) {
+         std::vector<Vector5Batch> wpar(par);
+         std::vector<SymMatrix5Batch> wcov(cov);
+         for (unsigned int b = 0; b < nbatches; ++b)
+            update(wpar[b], wcov[b], h[b], v[b], meas[b], chi2[b]);
+      }
+      w.Stop();
+      std::cout << "SMatrixBatch Kalman update of " << NTRACKS << " tracks x " << NLOOP << "\ttime = " << w.RealTime()
+                << " (sec)" << std::endl;
+   }
+   return iret;
+}
+
+int testCholesky()
+{
+   TRandom3 r(222);
+   SymMatrix5Batch batch;
+   Vector5Batch rhs;
+   std::vector<SymMatrix5> matrices(NBATCH);
+   std::vector<Vector5> vectors(NBATCH);
+   for (unsigned int n = 0; n < NBATCH; ++n) {
+      genCovariance(r, matrices[n]);
+      for (int i = 0; i < 5; ++i)
+         vectors[n][i] = r.Gaus(0, 1);
+   }
+   // a matrix which is not positive definite
+   matrices[1](4, 4) = -1.;
+   for (unsigned int n = 0; n < NBATCH; ++n) {
+      batch.Set(n, matrices[n]);
+      rhs.Set(n, vectors[n]);
+   }
+
+   int iret = 0;
+   CholeskyDecompBatch<double, 5, NBATCH> decomp(batch);
+   if (decomp.AllOk() || decomp.Ok(1) || !decomp.Ok(0)) {
+      std::cerr << "testCholesky: wrong status of the decomposition" << std::endl;
+      iret = 1;
+   }
+   decomp.Solve(rhs);
+   decomp.Invert(batch);
+   for (unsigned int n = 0; n < NBATCH; ++n) {
+      SymMatrix5 inv = matrices[n];
+      Vector5 x = vectors[n];
+      const bool ok = inv.InvertChol() && SolveChol(matrices[n], x);
+      if (ok != decomp.Ok(n)) {
+         std::cerr << "testCholesky: different status for matrix " << n << std::endl;
+         iret = 1;
+      }
+      // the matrices and vectors whose decomposition failed are unchanged
+      if (!ok) {
+         inv = matrices[n];
+         x = vectors[n];
+      }
+      for (int i = 0; i < 5; ++i) {
+         if (!isClose(x[i], rhs.At(n, i))) {
+            std::cerr << "testCholesky: different solution for matrix " << n << std::endl;
+            iret = 1;
+         }
+         for (int j = 0; j <= i; ++j) {
+            if (!isClose(inv(i, j), batch.At(n, i, j))) {
+               std::cerr << "testCholesky: different inverse for matrix " << n << std::endl;
+               iret = 1;
+            }
+         }
+      }
+   }
+   return iret;
+}
+
+int main()
+{
+   int iret = 0;
+   iret |= testCholesky();
+   iret |= testKalman();
+   if (iret != 0)
+      std::cerr << "testBatch: FAILED" << std::endl;
+   else
+      std::cout << "testBatch: OK" << std::endl;
+   return iret;
+}
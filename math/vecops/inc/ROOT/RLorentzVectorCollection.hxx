@@ -0,0 +1,500 @@
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RLORENTZVECTORCOLLECTION
+#define ROOT_RLORENTZVECTORCOLLECTION
+
+#include <ROOT/RVec.hxx>
+#include <Math/LorentzVector.h>
+#include <Math/PtEtaPhiM4D.h>
+#include <Math/PtEtaPhiE4D.h>
+#include <Math/PxPyPzE4D.h>
+#include <Math/PxPyPzM4D.h>
+#include <Math/GenVector/eta.h>
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace ROOT {
+
+namespace Internal {
+namespace VecOps {
+
+/// Cartesian (x, y, z, e) components of a collection of Lorentz vectors, used internally
+/// by the kinematic functions of ROOT::VecOps::LorentzVectorCollection
+template <typename T>
+struct RCartesianColumns {
+   RVec<T> fX, fY, fZ, fE;
+
+   RCartesianColumns(std::size_t size) : fX(size), fY(size), fZ(size), fE(size) {}
+};
+
+/// Energy from the squared momentum and the mass, with the convention of GenVector for negative masses
+template <typename T>
+inline T EnergyFromP2M(T p2, T m)
+{
+   const T e2 = p2 + (m >= 0 ? m * m : -m * m);
+   return e2 > 0 ? std::sqrt(e2) : T(0);
+}
+
+/// Mass from the energy and the squared momentum; a negative value is returned for P^2 > E^2
+template <typename T>
+inline T MassFromEP2(T e, T p2)
+{
+   const T m2 = e * e - p2;
+   return m2 >= 0 ? std::sqrt(m2) : -std::sqrt(-m2);
+}
+
+/// Azimuthal angle from the x and y components, 0 for x = y = 0 as in GenVector
+template <typename T>
+inline T PhiFromXY(T x, T y)
+{
+   return (x == 0 && y == 0) ? T(0) : std::atan2(y, x);
+}
+
+/// z component from pt and eta, with the convention of GenVector for pt = 0
+template <typename T>
+inline T ZFromPtEta(T pt, T eta)
+{
+   return pt > 0 ? pt * std::sinh(eta)
+                 : eta == 0 ? 0 : eta > 0 ? eta - ROOT::Math::etaMax<T>() : eta + ROOT::Math::etaMax<T>();
+}
+
+/// Return the result of f(a[i], b[i], ...) for all the elements of the columns
+template <typename T, typename F>
+RVec<T> MapColumns(F &&f, const RVec<T> &a, const RVec<T> &b)
+{
+   const std::size_t size = a.size();
+   RVec<T> ret(size);
+   const T *pa = a.data(), *pb = b.data();
+   T *r = ret.data();
+   for (std::size_t i = 0; i < size; ++i)
+      r[i] = f(pa[i], pb[i]);
+   return ret;
+}
+
+template <typename T, typename F>
+RVec<T> MapColumns(F &&f, const RVec<T> &a, const RVec<T> &b, const RVec<T> &c)
+{
+   const std::size_t size = a.size();
+   RVec<T> ret(size);
+   const T *pa = a.data(), *pb = b.data(), *pc = c.data();
+   T *r = ret.data();
+   for (std::size_t i = 0; i < size; ++i)
+      r[i] = f(pa[i], pb[i], pc[i]);
+   return ret;
+}
+
+template <typename T, typename F>
+RVec<T> MapColumns(F &&f, const RVec<T> &a, const RVec<T> &b, const RVec<T> &c, const RVec<T> &d)
+{
+   const std::size_t size = a.size();
+   RVec<T> ret(size);
+   const T *pa = a.data(), *pb = b.data(), *pc = c.data(), *pd = d.data();
+   T *r = ret.data();
+   for (std::size_t i = 0; i < size; ++i)
+      r[i] = f(pa[i], pb[i], pc[i], pd[i]);
+   return ret;
+}
+
+/// Conversion of the four columns of a coordinate system to and from cartesian coordinates, and
+/// computation of the kinematic quantities: the ones stored in a column are returned as they are,
+/// the others are computed only from the columns they depend on.
+/// The columns are in the order of the constructor of the coordinate system.
+template <typename CoordSystem>
+struct RLorentzColumnsTraits;
+
+/// common part of the (x, y, z, e/m) systems
+template <typename T>
+struct RPxPyPzColumns {
+   static RVec<T> Px(const RVec<T> *c) { return c[0]; }
+   static RVec<T> Py(const RVec<T> *c) { return c[1]; }
+   static RVec<T> Pz(const RVec<T> *c) { return c[2]; }
+   static RVec<T> Pt(const RVec<T> *c)
+   {
+      return MapColumns([](T x, T y) { return std::sqrt(x * x + y * y); }, c[0], c[1]);
+   }
+   static RVec<T> Eta(const RVec<T> *c)
+   {
+      return MapColumns([](T x, T y, T z) { return ROOT::Math::Impl::Eta_FromRhoZ(std::sqrt(x * x + y * y), z); },
+                        c[0], c[1], c[2]);
+   }
+   static RVec<T> Phi(const RVec<T> *c) { return MapColumns([](T x, T y) { return PhiFromXY(x, y); }, c[0], c[1]); }
+};
+
+template <typename T>
+struct RLorentzColumnsTraits<ROOT::Math::PxPyPzE4D<T>> : RPxPyPzColumns<T> {
+   static void ToCartesian(const RVec<T> *c, RCartesianColumns<T> &cart)
+   {
+      cart.fX = c[0];
+      cart.fY = c[1];
+      cart.fZ = c[2];
+      cart.fE = c[3];
+   }
+   static void FromCartesian(const RCartesianColumns<T> &cart, RVec<T> *c)
+   {
+      c[0] = cart.fX;
+      c[1] = cart.fY;
+      c[2] = cart.fZ;
+      c[3] = cart.fE;
+   }
+   static RVec<T> E(const RVec<T> *c) { return c[3]; }
+   static RVec<T> M(const RVec<T> *c)
+   {
+      return MapColumns([](T x, T y, T z, T e) { return MassFromEP2(e, x * x + y * y + z * z); }, c[0], c[1], c[2],
+                        c[3]);
+   }
+};
+
+template <typename T>
+struct RLorentzColumnsTraits<ROOT::Math::PxPyPzM4D<T>> : RPxPyPzColumns<T> {
+   static void ToCartesian(const RVec<T> *c, RCartesianColumns<T> &cart)
+   {
+      cart.fX = c[0];
+      cart.fY = c[1];
+      cart.fZ = c[2];
+      cart.fE = E(c);
+   }
+   static void FromCartesian(const RCartesianColumns<T> &cart, RVec<T> *c)
+   {
+      c[0] = cart.fX;
+      c[1] = cart.fY;
+      c[2] = cart.fZ;
+      c[3] = MapColumns([](T x, T y, T z, T e) { return MassFromEP2(e, x * x + y * y + z * z); }, cart.fX, cart.fY,
+                        cart.fZ, cart.fE);
+   }
+   static RVec<T> E(const RVec<T> *c)
+   {
+      return MapColumns([](T x, T y, T z, T m) { return EnergyFromP2M(x * x + y * y + z * z, m); }, c[0], c[1], c[2],
+                        c[3]);
+   }
+   static RVec<T> M(const RVec<T> *c) { return c[3]; }
+};
+
+/// common part of the (pt, eta, phi, e/m) systems
+template <typename T>
+struct RPtEtaPhiColumns {
+   static void ToCartesian3D(const RVec<T> *c, RCartesianColumns<T> &cart)
+   {
+      const std::size_t size = c[0].size();
+      const T *pt = c[0].data(), *eta = c[1].data(), *phi = c[2].data();
+      T *x = cart.fX.data(), *y = cart.fY.data(), *z = cart.fZ.data();
+      for (std::size_t i = 0; i < size; ++i) {
+         x[i] = pt[i] * std::cos(phi[i]);
+         y[i] = pt[i] * std::sin(phi[i]);
+         z[i] = ZFromPtEta(pt[i], eta[i]);
+      }
+   }
+   static void FromCartesian3D(const RCartesianColumns<T> &cart, RVec<T> *c)
+   {
+      const std::size_t size = cart.fX.size();
+      c[0].resize(size);
+      c[1].resize(size);
+      c[2].resize(size);
+      const T *x = cart.fX.data(), *y = cart.fY.data(), *z = cart.fZ.data();
+      T *pt = c[0].data(), *eta = c[1].data(), *phi = c[2].data();
+      for (std::size_t i = 0; i < size; ++i) {
+         pt[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+         eta[i] = ROOT::Math::Impl::Eta_FromRhoZ(pt[i], z[i]);
+         phi[i] = PhiFromXY(x[i], y[i]);
+      }
+   }
+   static RVec<T> Px(const RVec<T> *c)
+   {
+      return MapColumns([](T pt, T phi) { return pt * std::cos(phi); }, c[0], c[2]);
+   }
+   static RVec<T> Py(const RVec<T> *c)
+   {
+      return MapColumns([](T pt, T phi) { return pt * std::sin(phi); }, c[0], c[2]);
+   }
+   static RVec<T> Pz(const RVec<T> *c)
+   {
+      return MapColumns([](T pt, T eta) { return ZFromPtEta(pt, eta); }, c[0], c[1]);
+   }
+   static RVec<T> Pt(const RVec<T> *c) { return c[0]; }
+   static RVec<T> Eta(const RVec<T> *c) { return c[1]; }
+   static RVec<T> Phi(const RVec<T> *c) { return c[2]; }
+};
+
+template <typename T>
+struct RLorentzColumnsTraits<ROOT::Math::PtEtaPhiE4D<T>> : RPtEtaPhiColumns<T> {
+   static void ToCartesian(const RVec<T> *c, RCartesianColumns<T> &cart)
+   {
+      RPtEtaPhiColumns<T>::ToCartesian3D(c, cart);
+      cart.fE = c[3];
+   }
+   static void FromCartesian(const RCartesianColumns<T> &cart, RVec<T> *c)
+   {
+      RPtEtaPhiColumns<T>::FromCartesian3D(cart, c);
+      c[3] = cart.fE;
+   }
+   static RVec<T> E(const RVec<T> *c) { return c[3]; }
+   static RVec<T> M(const RVec<T> *c)
+   {
+      return MapColumns(
+         [](T pt, T eta, T e) {
+            const T z = ZFromPtEta(pt, eta);
+            return MassFromEP2(e, pt * pt + z * z);
+         },
+         c[0], c[1], c[3]);
+   }
+};
+
+template <typename T>
+struct RLorentzColumnsTraits<ROOT::Math::PtEtaPhiM4D<T>> : RPtEtaPhiColumns<T> {
+   static void ToCartesian(const RVec<T> *c, RCartesianColumns<T> &cart)
+   {
+      RPtEtaPhiColumns<T>::ToCartesian3D(c, cart);
+      const std::size_t size = c[0].size();
+      const T *x = cart.fX.data(), *y = cart.fY.data(), *z = cart.fZ.data(), *m = c[3].data();
+      T *e = cart.fE.data();
+      for (std::size_t i = 0; i < size; ++i)
+         e[i] = EnergyFromP2M(x[i] * x[i] + y[i] * y[i] + z[i] * z[i], m[i]);
+   }
+   static void FromCartesian(const RCartesianColumns<T> &cart, RVec<T> *c)
+   {
+      RPtEtaPhiColumns<T>::FromCartesian3D(cart, c);
+      c[3] = MapColumns([](T x, T y, T z, T e) { return MassFromEP2(e, x * x + y * y + z * z); }, cart.fX, cart.fY,
+                        cart.fZ, cart.fE);
+   }
+   static RVec<T> E(const RVec<T> *c)
+   {
+      return MapColumns(
+         [](T pt, T eta, T m) {
+            const T z = ZFromPtEta(pt, eta);
+            return EnergyFromP2M(pt * pt + z * z, m);
+         },
+         c[0], c[1], c[3]);
+   }
+   static RVec<T> M(const RVec<T> *c) { return c[3]; }
+};
+
+} // namespace VecOps
+} // namespace Internal
+
+namespace VecOps {
+
+////////////////////////////////////////////////////////////////////////////
+/// \brief A collection of Lorentz vectors stored as structure of arrays.
+/// \tparam CoordSystem The GenVector coordinate system, e.g. ROOT::Math::PtEtaPhiM4D<float>.
+///
+/// The four components of the vectors are stored in four RVec columns, in the order of the
+/// constructor of the coordinate system (e.g. pt, eta, phi, mass for PtEtaPhiM4D). The
+/// kinematic quantities (Pt(), M(), ...), the sum, boosts and coordinate conversions are computed
+/// for the whole collection in loops over contiguous arrays, which the compiler can vectorize,
+/// instead of calling the methods of each ROOT::Math::LorentzVector.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// LorentzVectorCollection<ROOT::Math::PtEtaPhiM4D<float>> muons(pts, etas, phis, masses);
+/// auto e = muons.E();
+/// auto mass = InvariantMass(muons);
+/// auto boosted = Boost(muons, 0., 0., 0.5);
+/// auto cartesian = muons.As<ROOT::Math::PxPyPzE4D<float>>();
+/// ~~~
+template <typename CoordSystem>
+class LorentzVectorCollection {
+public:
+   using Scalar = typename CoordSystem::Scalar;
+   using LorentzVector_t = ROOT::Math::LorentzVector<CoordSystem>;
+   using size_type = typename RVec<Scalar>::size_type;
+
+private:
+   using Traits_t = ::ROOT::Internal::VecOps::RLorentzColumnsTraits<CoordSystem>;
+   using Cartesian_t = ::ROOT::Internal::VecOps::RCartesianColumns<Scalar>;
+
+   RVec<Scalar> fColumns[4];
+
+   Cartesian_t ToCartesian() const
+   {
+      Cartesian_t cart(size());
+      Traits_t::ToCartesian(fColumns, cart);
+      return cart;
+   }
+
+public:
+   LorentzVectorCollection() = default;
+
+   /// Construct from the four columns, in the order of the constructor of the coordinate system
+   LorentzVectorCollection(RVec<Scalar> c0, RVec<Scalar> c1, RVec<Scalar> c2, RVec<Scalar> c3)
+   {
+      ::ROOT::Internal::VecOps::GetVectorsSize("LorentzVectorCollection", c0, c1, c2, c3);
+      fColumns[0] = std::move(c0);
+      fColumns[1] = std::move(c1);
+      fColumns[2] = std::move(c2);
+      fColumns[3] = std::move(c3);
+   }
+
+   /// Construct from a collection of Lorentz vectors (array of structures)
+   explicit LorentzVectorCollection(const RVec<LorentzVector_t> &vectors)
+   {
+      reserve(vectors.size());
+      for (const auto &v : vectors)
+         push_back(v);
+   }
+
+   template <typename OtherCoordSystem>
+   friend class LorentzVectorCollection;
+
+   template <typename CoordSystem1, typename CoordSystem2>
+   friend RVec<typename CoordSystem1::Scalar>
+   InvariantMasses(const LorentzVectorCollection<CoordSystem1> &v1, const LorentzVectorCollection<CoordSystem2> &v2);
+
+   size_type size() const { return fColumns[0].size(); }
+   bool empty() const { return fColumns[0].empty(); }
+   void reserve(size_type n)
+   {
+      for (auto &c : fColumns)
+         c.reserve(n);
+   }
+   void clear()
+   {
+      for (auto &c : fColumns)
+         c.clear();
+   }
+
+   void push_back(const LorentzVector_t &v)
+   {
+      Scalar c[4];
+      v.GetCoordinates(c);
+      for (int k = 0; k < 4; ++k)
+         fColumns[k].push_back(c[k]);
+   }
+
+   /// Return the i-th vector
+   LorentzVector_t operator[](size_type i) const
+   {
+      return LorentzVector_t(fColumns[0][i], fColumns[1][i], fColumns[2][i], fColumns[3][i]);
+   }
+
+   /// Return the column k (0 to 3) of the components, in the order of the constructor of the coordinate system
+   const RVec<Scalar> &Column(unsigned int k) const { return fColumns[k]; }
+
+   /// Return the collection as array of structures
+   RVec<LorentzVector_t> Vectors() const
+   {
+      RVec<LorentzVector_t> ret;
+      ret.reserve(size());
+      for (size_type i = 0; i < size(); ++i)
+         ret.emplace_back((*this)[i]);
+      return ret;
+   }
+
+   /// Return the collection in another coordinate system
+   template <typename OtherCoordSystem>
+   LorentzVectorCollection<OtherCoordSystem> As() const
+   {
+      static_assert(std::is_same<typename OtherCoordSystem::Scalar, Scalar>::value,
+                    "The coordinate systems must have the same scalar type");
+      LorentzVectorCollection<OtherCoordSystem> ret;
+      ::ROOT::Internal::VecOps::RLorentzColumnsTraits<OtherCoordSystem>::FromCartesian(ToCartesian(),
+                                                                                      ret.fColumns);
+      return ret;
+   }
+
+   /// The kinematic quantities of all the vectors. The ones stored in a column of the coordinate system are returned
+   /// without any computation, the others are computed only from the columns they depend on.
+   RVec<Scalar> Px() const { return Traits_t::Px(fColumns); }
+   RVec<Scalar> Py() const { return Traits_t::Py(fColumns); }
+   RVec<Scalar> Pz() const { return Traits_t::Pz(fColumns); }
+   RVec<Scalar> E() const { return Traits_t::E(fColumns); }
+   RVec<Scalar> Pt() const { return Traits_t::Pt(fColumns); }
+   RVec<Scalar> Eta() const { return Traits_t::Eta(fColumns); }
+   RVec<Scalar> Phi() const { return Traits_t::Phi(fColumns); }
+   RVec<Scalar> M() const { return Traits_t::M(fColumns); }
+
+   /// Return the sum of all the vectors
+   LorentzVector_t Sum() const
+   {
+      const auto cart = ToCartesian();
+      Scalar x = 0, y = 0, z = 0, e = 0;
+      for (size_type i = 0; i < size(); ++i) {
+         x += cart.fX[i];
+         y += cart.fY[i];
+         z += cart.fZ[i];
+         e += cart.fE[i];
+      }
+      return LorentzVector_t(ROOT::Math::PxPyPzE4D<Scalar>(x, y, z, e));
+   }
+
+   /// Return the collection boosted with the velocity (bx, by, bz), with the conventions of ROOT::Math::VectorUtil::boost
+   LorentzVectorCollection Boost(Scalar bx, Scalar by, Scalar bz) const
+   {
+      auto cart = ToCartesian();
+      const Scalar b2 = bx * bx + by * by + bz * bz;
+      const Scalar gamma = 1 / std::sqrt(1 - b2);
+      const Scalar gamma2 = b2 > 0 ? (gamma - 1) / b2 : Scalar(0);
+      Scalar *x = cart.fX.data(), *y = cart.fY.data(), *z = cart.fZ.data(), *e = cart.fE.data();
+      for (size_type i = 0; i < size(); ++i) {
+         const Scalar bp = bx * x[i] + by * y[i] + bz * z[i];
+         const Scalar f = gamma2 * bp + gamma * e[i];
+         x[i] += f * bx;
+         y[i] += f * by;
+         z[i] += f * bz;
+         e[i] = gamma * (e[i] + bp);
+      }
+      LorentzVectorCollection ret;
+      Traits_t::FromCartesian(cart, ret.fColumns);
+      return ret;
+   }
+};
+
+/// Return the collection v boosted with the velocity (bx, by, bz)
+template <typename CoordSystem, typename T>
+LorentzVectorCollection<CoordSystem> Boost(const LorentzVectorCollection<CoordSystem> &v, T bx, T by, T bz)
+{
+   using Scalar = typename CoordSystem::Scalar;
+   return v.Boost(Scalar(bx), Scalar(by), Scalar(bz));
+}
+
+/// Return the invariant mass of the sum of all the vectors of the collection
+template <typename CoordSystem>
+typename CoordSystem::Scalar InvariantMass(const LorentzVectorCollection<CoordSystem> &v)
+{
+   return v.Sum().M();
+}
+
+/// Return the invariant masses of the pairs of vectors (v1[i], v2[i])
+template <typename CoordSystem1, typename CoordSystem2>
+RVec<typename CoordSystem1::Scalar>
+InvariantMasses(const LorentzVectorCollection<CoordSystem1> &v1, const LorentzVectorCollection<CoordSystem2> &v2)
+{
+   using Scalar = typename CoordSystem1::Scalar;
+   const auto size =
+      ::ROOT::Internal::VecOps::GetVectorsSize("InvariantMasses", v1.Column(0), v2.Column(0));
+   // a single conversion per collection
+   const auto c1 = v1.ToCartesian();
+   const auto c2 = v2.ToCartesian();
+   RVec<Scalar> masses(size);
+   for (std::size_t i = 0; i < size; ++i) {
+      const Scalar e = c1.fE[i] + c2.fE[i];
+      const Scalar x = c1.fX[i] + c2.fX[i];
+      const Scalar y = c1.fY[i] + c2.fY[i];
+      const Scalar z = c1.fZ[i] + c2.fZ[i];
+      masses[i] = ::ROOT::Internal::VecOps::MassFromEP2(e, x * x + y * y + z * z);
+   }
+   return masses;
+}
+
+/// Return the distances \f$\Delta R\f$ on the \f$\eta\f$-\f$\phi\f$ plane of the pairs of vectors (v1[i], v2[i])
+template <typename CoordSystem1, typename CoordSystem2>
+RVec<typename CoordSystem1::Scalar>
+DeltaR(const LorentzVectorCollection<CoordSystem1> &v1, const LorentzVectorCollection<CoordSystem2> &v2)
+{
+   ::ROOT::Internal::VecOps::GetVectorsSize("DeltaR", v1.Column(0), v2.Column(0));
+   // eta and phi are stored columns or computed from the three momentum components, no conversion needed
+   return DeltaR(v1.Eta(), v2.Eta(), v1.Phi(), v2.Phi());
+}
+
+} // namespace VecOps
+} // namespace ROOT
+
+#endif
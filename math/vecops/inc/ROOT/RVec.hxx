@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <new>
 #include <numeric> // for inner_product
@@ -101,6 +102,99 @@ auto MapFromTuple(Tuple_t &&t, std::index_sequence<Is...>)
    return MapImpl(std::get<tupleSizeM1>(t), std::get<Is>(t)...);
 }
 
+/// \cond
+// Helpers for the operators and mathematical functions taking temporary RVecs: the result is written
+// in the buffer of a temporary argument when it has the type of the result and owns its memory, so that
+// an expression like `sqrt(px * px + py * py)` only allocates memory for the results of `px * px` and `py * py`.
+template <typename R, typename T, typename F>
+RVec<R> TransformTemporaryImpl(RVec<T> &&v, F &f, std::false_type)
+{
+   RVec<R> ret(v.size());
+   std::transform(v.begin(), v.end(), ret.begin(), f);
+   return ret;
+}
+
+template <typename R, typename T, typename F>
+RVec<R> TransformTemporaryImpl(RVec<T> &&v, F &f, std::true_type)
+{
+   if (IsAdoptingMemory(v))
+      return TransformTemporaryImpl<R>(std::move(v), f, std::false_type{});
+   std::transform(v.begin(), v.end(), v.begin(), f);
+   return std::move(v);
+}
+
+/// Return the RVec with the elements f(v[i]), using the buffer of v if possible.
+template <typename R, typename T, typename F>
+RVec<R> TransformTemporary(RVec<T> &&v, F &&f)
+{
+   return TransformTemporaryImpl<R>(std::move(v), f, std::is_same<R, T>{});
+}
+
+template <typename R, typename T0, typename T1, typename F>
+RVec<R> TransformTemporaryImpl(const RVec<T0> &v0, const RVec<T1> &v1, F &f, std::false_type)
+{
+   RVec<R> ret(v0.size());
+   std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), f);
+   return ret;
+}
+
+template <typename R, typename T0, typename T1, typename F>
+RVec<R> TransformTemporaryImpl(RVec<T0> &&v0, const RVec<T1> &v1, F &f, std::true_type)
+{
+   if (IsAdoptingMemory(v0))
+      return TransformTemporaryImpl<R>(static_cast<const RVec<T0> &>(v0), v1, f, std::false_type{});
+   std::transform(v0.begin(), v0.end(), v1.begin(), v0.begin(), f);
+   return std::move(v0);
+}
+
+template <typename R, typename T0, typename T1, typename F>
+RVec<R> TransformTemporaryImpl(const RVec<T0> &v0, RVec<T1> &&v1, F &f, std::true_type)
+{
+   if (IsAdoptingMemory(v1))
+      return TransformTemporaryImpl<R>(v0, static_cast<const RVec<T1> &>(v1), f, std::false_type{});
+   std::transform(v0.begin(), v0.end(), v1.begin(), v1.begin(), f);
+   return std::move(v1);
+}
+
+/// Return the RVec with the elements f(v0[i], v1[i]), using the buffer of v0 if possible.
+/// The two RVecs must have the same size.
+template <typename R, typename T0, typename T1, typename F>
+RVec<R> TransformTemporary(RVec<T0> &&v0, const RVec<T1> &v1, F &&f)
+{
+   return TransformTemporaryImpl<R>(std::move(v0), v1, f, std::is_same<R, T0>{});
+}
+
+/// Return the RVec with the elements f(v0[i], v1[i]), using the buffer of v1 if possible.
+/// The two RVecs must have the same size.
+template <typename R, typename T0, typename T1, typename F>
+RVec<R> TransformTemporary(const RVec<T0> &v0, RVec<T1> &&v1, F &&f)
+{
+   return TransformTemporaryImpl<R>(v0, std::move(v1), f, std::is_same<R, T1>{});
+}
+
+template <typename R, typename T0, typename T1, typename F>
+RVec<R> TransformTemporariesImpl(RVec<T0> &&v0, RVec<T1> &&v1, F &f, std::false_type)
+{
+   return TransformTemporary<R>(static_cast<const RVec<T0> &>(v0), std::move(v1), f);
+}
+
+template <typename R, typename T0, typename T1, typename F>
+RVec<R> TransformTemporariesImpl(RVec<T0> &&v0, RVec<T1> &&v1, F &f, std::true_type)
+{
+   if (IsAdoptingMemory(v0))
+      return TransformTemporary<R>(static_cast<const RVec<T0> &>(v0), std::move(v1), f);
+   return TransformTemporary<R>(std::move(v0), static_cast<const RVec<T1> &>(v1), f);
+}
+
+/// Return the RVec with the elements f(v0[i], v1[i]), using the buffer of v0 or v1 if possible.
+/// The two RVecs must have the same size.
+template <typename R, typename T0, typename T1, typename F>
+RVec<R> TransformTemporary(RVec<T0> &&v0, RVec<T1> &&v1, F &&f)
+{
+   return TransformTemporariesImpl<R>(std::move(v0), std::move(v1), f, std::is_same<R, T0>{});
+}
+/// \endcond
+
 /// Return the next power of two (in 64-bits) that is strictly greater than A.
 /// Return zero on overflow.
 inline uint64_t NextPowerOf2(uint64_t A)
@@ -114,6 +208,69 @@ inline uint64_t NextPowerOf2(uint64_t A)
    return A + 1;
 }
 
+/// \brief A cache of the heap buffers of RVecs, to recycle the memory of the RVecs destroyed in a loop.
+///
+/// While a RVecBufferPoolScope is active on a thread, the RVecs allocating a buffer on that thread take it from
+/// the pool and the RVecs destroyed on that thread give their buffer back to the pool, instead of calling malloc
+/// and free. RDataFrame activates the pool of the processing slot while it processes an entry, so that the memory of
+/// the RVecs returned by the Defines for one entry is reused for the next entry.
+///
+/// All RVec buffers up to kMaxPooledBytes are allocated with a size rounded up to a power of two (at least
+/// kMinPooledBytes), and their capacity is the number of elements that fit in it: this is what allows to find the
+/// size class of a buffer from the capacity of the RVec when it is released, also for the buffers allocated while
+/// no pool was active. The pool keeps at most kMaxCachedBytes; it is not thread-safe.
+class RVecBufferPool {
+public:
+   static constexpr std::size_t kMinPooledBytes = 64;
+   static constexpr std::size_t kMaxPooledBytes = 1 << 20;
+   static constexpr std::size_t kMaxCachedBytes = 8 << 20;
+
+private:
+   static constexpr unsigned int kNSizeClasses = 15; // from kMinPooledBytes to kMaxPooledBytes
+
+   std::vector<void *> fBuffers[kNSizeClasses]; ///< The cached buffers, per size class
+   std::size_t fCachedBytes = 0;
+   std::uint64_t fNRequests = 0; ///< Number of buffers requested
+   std::uint64_t fNReused = 0;   ///< Number of requests served with a cached buffer
+
+public:
+   RVecBufferPool() = default;
+   RVecBufferPool(const RVecBufferPool &) = delete;
+   RVecBufferPool &operator=(const RVecBufferPool &) = delete;
+   ~RVecBufferPool() { Clear(); }
+
+   /// Return a buffer of at least minBytes bytes, whose actual size is stored in bytes.
+   void *Allocate(std::size_t minBytes, std::size_t &bytes);
+   /// Keep the buffer, which holds the given number of bytes rounded up to the size class, for later use.
+   /// Return false if the buffer could not be cached and must be freed.
+   bool Recycle(void *buffer, std::size_t bytes);
+   /// Free all cached buffers.
+   void Clear();
+
+   std::uint64_t GetNRequests() const { return fNRequests; }
+   std::uint64_t GetNReused() const { return fNReused; }
+   void ResetCounters() { fNRequests = fNReused = 0; }
+
+   static std::size_t GetBufferSize(std::size_t minBytes);
+};
+
+/// RAII object that makes the RVecs allocated and destroyed on the current thread use the given pool.
+class RVecBufferPoolScope {
+   RVecBufferPool *fPrevious;
+
+public:
+   explicit RVecBufferPoolScope(RVecBufferPool &pool);
+   RVecBufferPoolScope(const RVecBufferPoolScope &) = delete;
+   RVecBufferPoolScope &operator=(const RVecBufferPoolScope &) = delete;
+   ~RVecBufferPoolScope();
+};
+
+/// Allocate the heap buffer of an RVec, of at least minBytes bytes; its actual size is stored in bytes.
+void *AllocateBuffer(std::size_t minBytes, std::size_t &bytes);
+/// Release a buffer returned by AllocateBuffer, with a capacity of capacityBytes (the capacity of the RVec times the
+/// size of its elements).
+void FreeBuffer(void *buffer, std::size_t capacityBytes);
+
 /// This is all the stuff common to all SmallVectors.
 class SmallVectorBase {
 public:
@@ -150,6 +307,9 @@ protected:
    /// If true, the RVec is in "memory adoption" mode, i.e. it is acting as a view on a memory buffer it does not own.
    bool Owns() const { return fCapacity != -1; }
 
+   /// Used by the operators taking a temporary RVec, which can write their result in its buffer only if it is owned.
+   friend bool IsAdoptingMemory(const SmallVectorBase &v) { return !v.Owns(); }
+
 public:
    size_t size() const { return fSize; }
    size_t capacity() const noexcept { return Owns() ? fCapacity : fSize; }
@@ -386,8 +546,8 @@ void SmallVectorTemplateBase<T, TriviallyCopyable>::grow(size_t MinSize)
    // Always grow, even from zero.
    size_t NewCapacity = size_t(NextPowerOf2(this->capacity() + 2));
    NewCapacity = std::min(std::max(NewCapacity, MinSize), this->SizeTypeMax());
-   T *NewElts = static_cast<T *>(malloc(NewCapacity * sizeof(T)));
-   R__ASSERT(NewElts != nullptr);
+   std::size_t NewBytes;
+   T *NewElts = static_cast<T *>(AllocateBuffer(NewCapacity * sizeof(T), NewBytes));
 
    // Move the elements over.
    this->uninitialized_move(this->begin(), this->end(), NewElts);
@@ -398,11 +558,11 @@ void SmallVectorTemplateBase<T, TriviallyCopyable>::grow(size_t MinSize)
 
       // If this wasn't grown from the inline copy, deallocate the old space.
       if (!this->isSmall())
-         free(this->begin());
+         FreeBuffer(this->begin(), this->capacity() * sizeof(T));
    }
 
    this->fBeginX = NewElts;
-   this->fCapacity = NewCapacity;
+   this->fCapacity = std::min(NewBytes / sizeof(T), this->SizeTypeMax());
 }
 
 /// SmallVectorTemplateBase<TriviallyCopyable = true> - This is where we put
@@ -540,7 +700,7 @@ public:
       // Subclass has already destructed this vector's elements.
       // If this wasn't grown from the inline copy, deallocate the old space.
       if (!this->isSmall() && this->Owns())
-         free(this->begin());
+         ::ROOT::Internal::VecOps::FreeBuffer(this->begin(), this->capacity() * sizeof(T));
    }
 
    // also give up adopted memory if applicable
@@ -1008,7 +1168,7 @@ RVecImpl<T> &RVecImpl<T>::operator=(RVecImpl<T> &&RHS)
       if (this->Owns()) {
          this->destroy_range(this->begin(), this->end());
          if (!this->isSmall())
-            free(this->begin());
+            ::ROOT::Internal::VecOps::FreeBuffer(this->begin(), this->capacity() * sizeof(T));
       }
       this->fBeginX = RHS.fBeginX;
       this->fSize = RHS.fSize;
@@ -1510,6 +1670,13 @@ RVec<T> operator OP(const RVec<T> &v)                                          \
    for (auto &x : ret)                                                         \
       x = OP x;                                                                \
 return ret;                                                                    \
+}                                                                              \
+                                                                               \
+template <typename T>                                                          \
+RVec<T> operator OP(RVec<T> &&v)                                               \
+{                                                                              \
+   auto op = [](const T &x) { return OP x; };                                  \
+   return ROOT::Internal::VecOps::TransformTemporary<T>(std::move(v), op);     \
 }                                                                              \
 
 RVEC_UNARY_OPERATOR(+)
@@ -1558,6 +1725,60 @@ auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                       \
    std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), op);          \
    return ret;                                                                 \
 }                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(RVec<T0> &&v, const T1 &y)                                    \
+  -> RVec<decltype(v[0] OP y)>                                                 \
+{                                                                              \
+   auto op = [&y](const T0 &x) { return x OP y; };                             \
+   return ROOT::Internal::VecOps::TransformTemporary<decltype(v[0] OP y)>(     \
+      std::move(v), op);                                                       \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(const T0 &x, RVec<T1> &&v)                                    \
+  -> RVec<decltype(x OP v[0])>                                                 \
+{                                                                              \
+   auto op = [&x](const T1 &y) { return x OP y; };                             \
+   return ROOT::Internal::VecOps::TransformTemporary<decltype(x OP v[0])>(     \
+      std::move(v), op);                                                       \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(RVec<T0> &&v0, const RVec<T1> &v1)                            \
+  -> RVec<decltype(v0[0] OP v1[0])>                                            \
+{                                                                              \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   return ROOT::Internal::VecOps::TransformTemporary<decltype(v0[0] OP v1[0])>(\
+      std::move(v0), v1, op);                                                  \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(const RVec<T0> &v0, RVec<T1> &&v1)                            \
+  -> RVec<decltype(v0[0] OP v1[0])>                                            \
+{                                                                              \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   return ROOT::Internal::VecOps::TransformTemporary<decltype(v0[0] OP v1[0])>(\
+      v0, std::move(v1), op);                                                  \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(RVec<T0> &&v0, RVec<T1> &&v1)                                 \
+  -> RVec<decltype(v0[0] OP v1[0])>                                            \
+{                                                                              \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   return ROOT::Internal::VecOps::TransformTemporary<decltype(v0[0] OP v1[0])>(\
+      std::move(v0), std::move(v1), op);                                       \
+}                                                                              \
 
 RVEC_BINARY_OPERATOR(+)
 RVEC_BINARY_OPERATOR(-)
@@ -1642,6 +1863,53 @@ auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                       \
    std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), op);          \
    return ret;                                                                 \
 }                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+RVec<int> operator OP(RVec<T0> &&v, const T1 &y)                               \
+{                                                                              \
+   auto op = [y](const T0 &x) -> int { return x OP y; };                       \
+   return ROOT::Internal::VecOps::TransformTemporary<int>(std::move(v), op);   \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+RVec<int> operator OP(const T0 &x, RVec<T1> &&v)                               \
+{                                                                              \
+   auto op = [x](const T1 &y) -> int { return x OP y; };                       \
+   return ROOT::Internal::VecOps::TransformTemporary<int>(std::move(v), op);   \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+RVec<int> operator OP(RVec<T0> &&v0, const RVec<T1> &v1)                       \
+{                                                                              \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) -> int { return x OP y; };           \
+   return ROOT::Internal::VecOps::TransformTemporary<int>(                     \
+      std::move(v0), v1, op);                                                  \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+RVec<int> operator OP(const RVec<T0> &v0, RVec<T1> &&v1)                       \
+{                                                                              \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) -> int { return x OP y; };           \
+   return ROOT::Internal::VecOps::TransformTemporary<int>(                     \
+      v0, std::move(v1), op);                                                  \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+RVec<int> operator OP(RVec<T0> &&v0, RVec<T1> &&v1)                            \
+{                                                                              \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) -> int { return x OP y; };           \
+   return ROOT::Internal::VecOps::TransformTemporary<int>(std::move(v0),       \
+                                                          std::move(v1), op);  \
+}                                                                              \
 
 RVEC_LOGICAL_OPERATOR(<)
 RVEC_LOGICAL_OPERATOR(>)
@@ -1682,6 +1950,14 @@ using PromoteTypes = decltype(PromoteType<U>() + PromoteType<V>());
       auto f = [](const T &x) { return FUNC(x); };                             \
       std::transform(v.begin(), v.end(), ret.begin(), f);                      \
       return ret;                                                              \
+   }                                                                          \
+                                                                               \
+   template <typename T>                                                       \
+   RVec<PromoteType<T>> NAME(RVec<T> &&v)                                      \
+   {                                                                           \
+      auto f = [](const T &x) { return FUNC(x); };                             \
+      return ROOT::Internal::VecOps::TransformTemporary<PromoteType<T>>(       \
+         std::move(v), f);                                                     \
    }
 
 #define RVEC_BINARY_FUNCTION(NAME, FUNC)                                       \
@@ -1713,6 +1989,55 @@ using PromoteTypes = decltype(PromoteType<U>() + PromoteType<V>());
       auto f = [](const T0 &x, const T1 &y) { return FUNC(x, y); };            \
       std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), f);        \
       return ret;                                                              \
+   }                                                                           \
+                                                                               \
+   template <typename T0, typename T1>                                         \
+   RVec<PromoteTypes<T0, T1>> NAME(const T0 &x, RVec<T1> &&v)                  \
+   {                                                                           \
+      auto f = [&x](const T1 &y) { return FUNC(x, y); };                       \
+      return ROOT::Internal::VecOps::TransformTemporary<PromoteTypes<T0, T1>>( \
+         std::move(v), f);                                                     \
+   }                                                                           \
+                                                                               \
+   template <typename T0, typename T1>                                         \
+   RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&v, const T1 &y)                  \
+   {                                                                           \
+      auto f = [&y](const T0 &x) { return FUNC(x, y); };                       \
+      return ROOT::Internal::VecOps::TransformTemporary<PromoteTypes<T0, T1>>( \
+         std::move(v), f);                                                     \
+   }                                                                           \
+                                                                               \
+   template <typename T0, typename T1>                                         \
+   RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&v0, const RVec<T1> &v1)          \
+   {                                                                           \
+      if (v0.size() != v1.size())                                              \
+         throw std::runtime_error(ERROR_MESSAGE(NAME));                        \
+                                                                               \
+      auto f = [](const T0 &x, const T1 &y) { return FUNC(x, y); };            \
+      return ROOT::Internal::VecOps::TransformTemporary<PromoteTypes<T0, T1>>( \
+         std::move(v0), v1, f);                                                \
+   }                                                                           \
+                                                                               \
+   template <typename T0, typename T1>                                         \
+   RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &v0, RVec<T1> &&v1)          \
+   {                                                                           \
+      if (v0.size() != v1.size())                                              \
+         throw std::runtime_error(ERROR_MESSAGE(NAME));                        \
+                                                                               \
+      auto f = [](const T0 &x, const T1 &y) { return FUNC(x, y); };            \
+      return ROOT::Internal::VecOps::TransformTemporary<PromoteTypes<T0, T1>>( \
+         v0, std::move(v1), f);                                                \
+   }                                                                           \
+                                                                               \
+   template <typename T0, typename T1>                                         \
+   RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&v0, RVec<T1> &&v1)               \
+   {                                                                           \
+      if (v0.size() != v1.size())                                              \
+         throw std::runtime_error(ERROR_MESSAGE(NAME));                        \
+                                                                               \
+      auto f = [](const T0 &x, const T1 &y) { return FUNC(x, y); };            \
+      return ROOT::Internal::VecOps::TransformTemporary<PromoteTypes<T0, T1>>( \
+         std::move(v0), std::move(v1), f);                                     \
    }                                                                           \
 
 #define RVEC_STD_UNARY_FUNCTION(F) RVEC_UNARY_FUNCTION(F, std::F)
@@ -2835,7 +3160,8 @@ std::ostream &operator<<(std::ostream &os, const RVec<T> &v)
 #if (_VECOPS_USE_EXTERN_TEMPLATES)
 
 #define RVEC_EXTERN_UNARY_OPERATOR(T, OP) \
-   extern template RVec<T> operator OP<T>(const RVec<T> &);
+   extern template RVec<T> operator OP<T>(const RVec<T> &); \
+   extern template RVec<T> operator OP<T>(RVec<T> &&);
 
 #define RVEC_EXTERN_BINARY_OPERATOR(T, OP)                                     \
    extern template auto operator OP<T, T>(const T &x, const RVec<T> &v)        \
@@ -2843,6 +3169,16 @@ std::ostream &operator<<(std::ostream &os, const RVec<T> &v)
    extern template auto operator OP<T, T>(const RVec<T> &v, const T &y)        \
       -> RVec<decltype(v[0] OP y)>;                                            \
    extern template auto operator OP<T, T>(const RVec<T> &v0, const RVec<T> &v1)\
+      -> RVec<decltype(v0[0] OP v1[0])>;                                       \
+   extern template auto operator OP<T, T>(const T &x, RVec<T> &&v)             \
+      -> RVec<decltype(x OP v[0])>;                                            \
+   extern template auto operator OP<T, T>(RVec<T> &&v, const T &y)             \
+      -> RVec<decltype(v[0] OP y)>;                                            \
+   extern template auto operator OP<T, T>(RVec<T> &&v0, const RVec<T> &v1)    \
+      -> RVec<decltype(v0[0] OP v1[0])>;                                       \
+   extern template auto operator OP<T, T>(const RVec<T> &v0, RVec<T> &&v1)    \
+      -> RVec<decltype(v0[0] OP v1[0])>;                                       \
+   extern template auto operator OP<T, T>(RVec<T> &&v0, RVec<T> &&v1)         \
       -> RVec<decltype(v0[0] OP v1[0])>;
 
 #define RVEC_EXTERN_ASSIGN_OPERATOR(T, OP)                           \
@@ -2852,7 +3188,12 @@ std::ostream &operator<<(std::ostream &os, const RVec<T> &v)
 #define RVEC_EXTERN_LOGICAL_OPERATOR(T, OP)                                 \
    extern template RVec<int> operator OP<T, T>(const RVec<T> &, const T &); \
    extern template RVec<int> operator OP<T, T>(const T &, const RVec<T> &); \
-   extern template RVec<int> operator OP<T, T>(const RVec<T> &, const RVec<T> &);
+   extern template RVec<int> operator OP<T, T>(const RVec<T> &, const RVec<T> &); \
+   extern template RVec<int> operator OP<T, T>(RVec<T> &&, const T &);      \
+   extern template RVec<int> operator OP<T, T>(const T &, RVec<T> &&);      \
+   extern template RVec<int> operator OP<T, T>(RVec<T> &&, const RVec<T> &); \
+   extern template RVec<int> operator OP<T, T>(const RVec<T> &, RVec<T> &&); \
+   extern template RVec<int> operator OP<T, T>(RVec<T> &&, RVec<T> &&);
 
 #define RVEC_EXTERN_FLOAT_TEMPLATE(T)   \
    extern template class RVec<T>;       \
@@ -2932,14 +3273,20 @@ RVEC_EXTERN_FLOAT_TEMPLATE(double)
 #undef RVEC_EXTERN_FLOAT_TEMPLATE
 
 #define RVEC_EXTERN_UNARY_FUNCTION(T, NAME, FUNC) \
-   extern template RVec<PromoteType<T>> NAME(const RVec<T> &);
+   extern template RVec<PromoteType<T>> NAME(const RVec<T> &); \
+   extern template RVec<PromoteType<T>> NAME(RVec<T> &&);
 
 #define RVEC_EXTERN_STD_UNARY_FUNCTION(T, F) RVEC_EXTERN_UNARY_FUNCTION(T, F, std::F)
 
 #define RVEC_EXTERN_BINARY_FUNCTION(T0, T1, NAME, FUNC)                            \
    extern template RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &, const T1 &); \
    extern template RVec<PromoteTypes<T0, T1>> NAME(const T0 &, const RVec<T1> &); \
-   extern template RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &, const RVec<T1> &);
+   extern template RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &, const RVec<T1> &); \
+   extern template RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&, const T1 &);      \
+   extern template RVec<PromoteTypes<T0, T1>> NAME(const T0 &, RVec<T1> &&);      \
+   extern template RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&, const RVec<T1> &); \
+   extern template RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &, RVec<T1> &&); \
+   extern template RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&, RVec<T1> &&);
 
 #define RVEC_EXTERN_STD_BINARY_FUNCTION(T, F) RVEC_EXTERN_BINARY_FUNCTION(T, T, F, std::F)
 
@@ -68,20 +68,119 @@ void ROOT::Internal::VecOps::SmallVectorBase::grow_pod(void *FirstEl, size_t Min
    NewCapacity = std::min(std::max(NewCapacity, MinSize), SizeTypeMax());
 
    void *NewElts;
-   if (fBeginX == FirstEl || !this->Owns()) {
-      NewElts = malloc(NewCapacity * TSize);
+   size_t NewBytes;
+   if (fBeginX != FirstEl && this->Owns() && capacity() * TSize > RVecBufferPool::kMaxPooledBytes) {
+      // Large buffers are not pooled: grow the allocated space.
+      NewBytes = NewCapacity * TSize;
+      NewElts = realloc(this->fBeginX, NewBytes);
       R__ASSERT(NewElts != nullptr);
+   } else {
+      NewElts = AllocateBuffer(NewCapacity * TSize, NewBytes);
 
       // Copy the elements over.  No need to run dtors on PODs.
       memcpy(NewElts, this->fBeginX, size() * TSize);
-   } else {
-      // If this wasn't grown from the inline copy, grow the allocated space.
-      NewElts = realloc(this->fBeginX, NewCapacity * TSize);
-      R__ASSERT(NewElts != nullptr);
+
+      // If this wasn't grown from the inline copy, release the old space.
+      if (fBeginX != FirstEl && this->Owns())
+         FreeBuffer(this->fBeginX, capacity() * TSize);
    }
 
    this->fBeginX = NewElts;
-   this->fCapacity = NewCapacity;
+   this->fCapacity = std::min(NewBytes / TSize, SizeTypeMax());
+}
+
+namespace {
+/// The pool used by the RVecs on this thread, if any
+thread_local ROOT::Internal::VecOps::RVecBufferPool *gCurrentBufferPool = nullptr;
+
+/// Index of the smallest size class holding at least the given number of bytes (at most kMaxPooledBytes)
+unsigned int GetSizeClass(std::size_t bytes)
+{
+   using ROOT::Internal::VecOps::RVecBufferPool;
+   unsigned int sizeClass = 0;
+   for (std::size_t classBytes = RVecBufferPool::kMinPooledBytes; classBytes < bytes; classBytes *= 2)
+      ++sizeClass;
+   return sizeClass;
+}
+} // namespace
+
+std::size_t ROOT::Internal::VecOps::RVecBufferPool::GetBufferSize(std::size_t minBytes)
+{
+   if (minBytes > kMaxPooledBytes)
+      return minBytes;
+   return kMinPooledBytes << GetSizeClass(minBytes);
+}
+
+void *ROOT::Internal::VecOps::RVecBufferPool::Allocate(std::size_t minBytes, std::size_t &bytes)
+{
+   ++fNRequests;
+   bytes = GetBufferSize(minBytes);
+   if (minBytes <= kMaxPooledBytes) {
+      auto &buffers = fBuffers[GetSizeClass(minBytes)];
+      if (!buffers.empty()) {
+         void *buffer = buffers.back();
+         buffers.pop_back();
+         fCachedBytes -= bytes;
+         ++fNReused;
+         return buffer;
+      }
+   }
+   void *buffer = malloc(bytes);
+   R__ASSERT(buffer != nullptr);
+   return buffer;
+}
+
+bool ROOT::Internal::VecOps::RVecBufferPool::Recycle(void *buffer, std::size_t bytes)
+{
+   if (bytes > kMaxPooledBytes)
+      return false;
+   const auto sizeClass = GetSizeClass(bytes);
+   const auto classBytes = kMinPooledBytes << sizeClass;
+   if (fCachedBytes + classBytes > kMaxCachedBytes)
+      return false;
+   fBuffers[sizeClass].push_back(buffer);
+   fCachedBytes += classBytes;
+   return true;
+}
+
+void ROOT::Internal::VecOps::RVecBufferPool::Clear()
+{
+   for (auto &buffers : fBuffers) {
+      for (void *buffer : buffers)
+         free(buffer);
+      buffers.clear();
+   }
+   fCachedBytes = 0;
+}
+
+ROOT::Internal::VecOps::RVecBufferPoolScope::RVecBufferPoolScope(RVecBufferPool &pool)
+   : fPrevious(gCurrentBufferPool)
+{
+   gCurrentBufferPool = &pool;
+}
+
+ROOT::Internal::VecOps::RVecBufferPoolScope::~RVecBufferPoolScope()
+{
+   gCurrentBufferPool = fPrevious;
+}
+
+void *ROOT::Internal::VecOps::AllocateBuffer(std::size_t minBytes, std::size_t &bytes)
+{
+   if (gCurrentBufferPool != nullptr)
+      return gCurrentBufferPool->Allocate(minBytes, bytes);
+   bytes = RVecBufferPool::GetBufferSize(minBytes);
+   void *buffer = malloc(bytes);
+   R__ASSERT(buffer != nullptr);
+   return buffer;
+}
+
+void ROOT::Internal::VecOps::FreeBuffer(void *buffer, std::size_t capacityBytes)
+{
+   // The buffer size is the size class of capacityBytes: the capacity of the RVec is the number of elements
+   // fitting in the buffer, so the buffer is less than one element larger than capacityBytes, and the only
+   // power of two in that range is the smallest one not smaller than capacityBytes.
+   if (gCurrentBufferPool == nullptr || !gCurrentBufferPool->Recycle(buffer, capacityBytes))
+      free(buffer);
 }
 
 #if (_VECOPS_USE_EXTERN_TEMPLATES)
@@ -90,17 +189,28 @@ namespace ROOT {
 namespace VecOps {
 
 #define RVEC_DECLARE_UNARY_OPERATOR(T, OP) \
-   template RVec<T> operator OP(const RVec<T> &);
+   template RVec<T> operator OP(const RVec<T> &); \
+   template RVec<T> operator OP(RVec<T> &&);
 
 #define RVEC_DECLARE_BINARY_OPERATOR(T, OP)                                              \
    template auto operator OP(const RVec<T> &v, const T &y) -> RVec<decltype(v[0] OP y)>; \
    template auto operator OP(const T &x, const RVec<T> &v) -> RVec<decltype(x OP v[0])>; \
-   template auto operator OP(const RVec<T> &v0, const RVec<T> &v1) -> RVec<decltype(v0[0] OP v1[0])>;
+   template auto operator OP(const RVec<T> &v0, const RVec<T> &v1) -> RVec<decltype(v0[0] OP v1[0])>; \
+   template auto operator OP(RVec<T> &&v, const T &y) -> RVec<decltype(v[0] OP y)>;                  \
+   template auto operator OP(const T &x, RVec<T> &&v) -> RVec<decltype(x OP v[0])>;                  \
+   template auto operator OP(RVec<T> &&v0, const RVec<T> &v1) -> RVec<decltype(v0[0] OP v1[0])>;     \
+   template auto operator OP(const RVec<T> &v0, RVec<T> &&v1) -> RVec<decltype(v0[0] OP v1[0])>;     \
+   template auto operator OP(RVec<T> &&v0, RVec<T> &&v1) -> RVec<decltype(v0[0] OP v1[0])>;
 
 #define RVEC_DECLARE_LOGICAL_OPERATOR(T, OP)                   \
    template RVec<int> operator OP(const RVec<T> &, const T &); \
    template RVec<int> operator OP(const T &, const RVec<T> &); \
-   template RVec<int> operator OP(const RVec<T> &, const RVec<T> &);
+   template RVec<int> operator OP(const RVec<T> &, const RVec<T> &); \
+   template RVec<int> operator OP(RVec<T> &&, const T &);            \
+   template RVec<int> operator OP(const T &, RVec<T> &&);            \
+   template RVec<int> operator OP(RVec<T> &&, const RVec<T> &);      \
+   template RVec<int> operator OP(const RVec<T> &, RVec<T> &&);      \
+   template RVec<int> operator OP(RVec<T> &&, RVec<T> &&);
 
 #define RVEC_DECLARE_ASSIGN_OPERATOR(T, OP)             \
    template RVec<T> &operator OP(RVec<T> &, const T &); \
@@ -177,14 +287,20 @@ RVEC_DECLARE_FLOAT_TEMPLATE(float)
 RVEC_DECLARE_FLOAT_TEMPLATE(double)
 
 #define RVEC_DECLARE_UNARY_FUNCTION(T, NAME, FUNC) \
-   template RVec<PromoteType<T>> NAME(const RVec<T> &);
+   template RVec<PromoteType<T>> NAME(const RVec<T> &); \
+   template RVec<PromoteType<T>> NAME(RVec<T> &&);
 
 #define RVEC_DECLARE_STD_UNARY_FUNCTION(T, F) RVEC_DECLARE_UNARY_FUNCTION(T, F, ::std::F)
 
 #define RVEC_DECLARE_BINARY_FUNCTION(T0, T1, NAME, FUNC) \
    template RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &v, const T1 &y); \
    template RVec<PromoteTypes<T0, T1>> NAME(const T0 &x, const RVec<T1> &v); \
-   template RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &v0, const RVec<T1> &v1);
+   template RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &v0, const RVec<T1> &v1); \
+   template RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&v, const T1 &y);               \
+   template RVec<PromoteTypes<T0, T1>> NAME(const T0 &x, RVec<T1> &&v);               \
+   template RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&v0, const RVec<T1> &v1);       \
+   template RVec<PromoteTypes<T0, T1>> NAME(const RVec<T0> &v0, RVec<T1> &&v1);       \
+   template RVec<PromoteTypes<T0, T1>> NAME(RVec<T0> &&v0, RVec<T1> &&v1);
 
 #define RVEC_DECLARE_STD_BINARY_FUNCTION(T, F) RVEC_DECLARE_BINARY_FUNCTION(T, T, F, ::std::F)
 
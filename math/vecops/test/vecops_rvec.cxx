@@ -2,6 +2,9 @@
 #include <Math/LorentzVector.h>
 #include <Math/PtEtaPhiM4D.h>
 #include <Math/Vector4Dfwd.h>
+#include <Math/Vector3D.h>
+#include <Math/VectorUtil.h>
+#include <ROOT/RLorentzVectorCollection.hxx>
 #include <ROOT/RVec.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TFile.h>
@@ -9,6 +12,7 @@
 #include <TTree.h>
 #include <TSystem.h>
 #include <TLorentzVector.h>
+#include <memory>
 #include <vector>
 #include <sstream>
 #include <cmath>
@@ -282,6 +286,48 @@ TEST(VecOps, MathVectorInPlace)
    CheckEqual(div, ref / vec);
 }
 
+TEST(VecOps, MathTemporaries)
+{
+   // operations on temporary RVecs reuse their buffer for the result
+   RVec<double> px(100), py(100);
+   for (std::size_t i = 0; i < px.size(); ++i) {
+      px[i] = 0.1 * i;
+      py[i] = 1. - 0.2 * i;
+   }
+   RVec<double> ref(px.size());
+   for (std::size_t i = 0; i < px.size(); ++i)
+      ref[i] = std::sqrt(px[i] * px[i] + py[i] * py[i]);
+   CheckEqual(sqrt(px * px + py * py), ref);
+   CheckEqual(-(px * px) + 2. * (py * py) - 3., -px * px + 2. * py * py - 3.);
+   CheckEqual(pow(px + 1., py * 0.5), pow(px + 1., RVec<double>(py * 0.5)));
+   CheckEqual(atan2(px * 1., py), atan2(px, py));
+
+   RVec<double> tmp = px * 2.;
+   const auto *data = tmp.data();
+   auto res = std::move(tmp) + px;
+   EXPECT_EQ(res.data(), data);
+   CheckEqual(res, 3. * px);
+
+   auto mask = (px > 2.) && (py < 0.);
+   CheckEqual(mask, (px > 2.) * (py < 0.));
+
+   // the result is not written in the buffer of RVecs adopting memory
+   std::vector<double> buf(px.begin(), px.end());
+   auto res2 = RVec<double>(buf.data(), buf.size()) * 2.;
+   CheckEqual(res2, 2. * px);
+   CheckEqual(RVec<double>(buf.begin(), buf.end()), px);
+   auto res3 = exp(RVec<double>(buf.data(), buf.size())) + RVec<double>(buf.data(), buf.size());
+   CheckEqual(res3, exp(px) + px);
+   CheckEqual(RVec<double>(buf.begin(), buf.end()), px);
+
+   // the type of the result differs from the type of the temporary
+   RVec<float> f{1.f, 2.f, 3.f};
+   CheckEqual(f * 1.5 + RVec<double>{1., 1., 1.}, RVec<double>{2.5, 4., 5.5});
+   CheckEqual(sqrt(RVec<int>{1, 4, 9}), RVec<double>{1., 2., 3.});
+
+   EXPECT_THROW(std::move(tmp) + RVec<double>(3), std::runtime_error);
+}
+
 TEST(VecOps, Filter)
 {
    RVec<int> v{0, 1, 2, 3, 4, 5};
@@ -1202,6 +1248,55 @@ struct ThrowingCopy {
    ThrowingCopy &operator=(ThrowingCopy &&) = default;
 };
 
+TEST(VecOps, BufferPool)
+{
+   using ROOT::Internal::VecOps::RVecBufferPool;
+   using ROOT::Internal::VecOps::RVecBufferPoolScope;
+
+   RVecBufferPool pool;
+   std::vector<double> buf(1000, 1.);
+   const double *reused = nullptr;
+   {
+      RVecBufferPoolScope scope(pool);
+      // the inline buffer and adopted memory do not use the pool
+      RVec<double> small(2);
+      RVec<double> adopting(buf.data(), buf.size());
+      EXPECT_EQ(pool.GetNRequests(), 0u);
+
+      for (int i = 0; i < 10; ++i) {
+         RVec<double> v(100 + i, double(i));
+         v.push_back(1.);
+         EXPECT_GE(v.capacity(), v.size());
+         if (i == 0)
+            reused = v.data();
+         else
+            EXPECT_EQ(v.data(), reused);
+         CheckEqual(v * 2., RVec<double>(v.begin(), v.end()) * 2.);
+      }
+      RVec<double> x(adopting);
+      x.resize(3000);
+   }
+   EXPECT_GT(pool.GetNRequests(), 10u);
+   EXPECT_GT(pool.GetNReused(), 10u);
+   EXPECT_LE(pool.GetNReused(), pool.GetNRequests());
+   EXPECT_EQ(buf, std::vector<double>(1000, 1.));
+
+   // buffers allocated outside of the scope can be recycled, those allocated inside can be freed outside
+   auto outside = std::make_unique<RVec<float>>(300);
+   auto *outsideData = outside->data();
+   RVec<float> inside;
+   {
+      RVecBufferPoolScope scope(pool);
+      outside.reset();
+      RVec<float> v(400);
+      EXPECT_EQ(v.data(), outsideData);
+      inside.resize(5000);
+   }
+   pool.ResetCounters();
+   EXPECT_EQ(pool.GetNRequests(), 0u);
+   pool.Clear();
+}
+
 // RVec does not guarantee exception safety, but we still want to test
 // that we don't segfault or otherwise crash if element construction or move throws.
 TEST(VecOps, NoExceptionSafety)
@@ -1239,3 +1334,101 @@ TEST(VecOps, NoExceptionSafety)
    ROOT::RVec<ThrowingCopy> v10(p3, 2);
    EXPECT_THROW(v10.push_back(*p3), std::runtime_error);
 }
+
+TEST(VecOps, LorentzVectorCollection)
+{
+   RVec<double> mass = {50, 50, 0, 10, 100};
+   RVec<double> pt = {0, 5, 5, 10, 10};
+   RVec<double> eta = {0.0, 0.0, -1.0, 0.5, 2.5};
+   RVec<double> phi = {0.0, 0.0, 1.0, -0.5, -2.4};
+
+   LorentzVectorCollection<ROOT::Math::PtEtaPhiM4D<double>> coll(pt, eta, phi, mass);
+   EXPECT_EQ(coll.size(), 5u);
+   EXPECT_THROW((LorentzVectorCollection<ROOT::Math::PtEtaPhiM4D<double>>(pt, eta, phi, {1.})), std::runtime_error);
+
+   const auto px = coll.Px();
+   const auto py = coll.Py();
+   const auto pz = coll.Pz();
+   const auto e = coll.E();
+   const auto pt2 = coll.Pt();
+   const auto eta2 = coll.Eta();
+   const auto phi2 = coll.Phi();
+   const auto mass2 = coll.M();
+   const auto aos = coll.Vectors();
+   for (std::size_t i = 0; i < pt.size(); i++) {
+      ROOT::Math::PtEtaPhiMVector p(pt[i], eta[i], phi[i], mass[i]);
+      CheckEqual(aos[i], p);
+      EXPECT_NEAR(p.Px(), px[i], 1e-10);
+      EXPECT_NEAR(p.Py(), py[i], 1e-10);
+      EXPECT_NEAR(p.Pz(), pz[i], 1e-10);
+      EXPECT_NEAR(p.E(), e[i], 1e-10);
+      EXPECT_NEAR(p.Pt(), pt2[i], 1e-10);
+      EXPECT_NEAR(p.Eta(), eta2[i], 1e-10);
+      EXPECT_NEAR(p.Phi(), phi2[i], 1e-10);
+      EXPECT_NEAR(p.M(), mass2[i], 1e-8);
+   }
+
+   // conversion to and from other coordinate systems
+   const auto cartesian = coll.As<ROOT::Math::PxPyPzE4D<double>>();
+   const auto cartesianM = coll.As<ROOT::Math::PxPyPzM4D<double>>();
+   const auto back = cartesian.As<ROOT::Math::PtEtaPhiE4D<double>>().As<ROOT::Math::PtEtaPhiM4D<double>>();
+   for (std::size_t i = 0; i < pt.size(); i++) {
+      ROOT::Math::PxPyPzEVector p(coll[i]);
+      EXPECT_NEAR(p.Px(), cartesian[i].Px(), 1e-10);
+      EXPECT_NEAR(p.E(), cartesian[i].E(), 1e-10);
+      EXPECT_NEAR(p.M(), cartesianM[i].M(), 1e-8);
+      EXPECT_NEAR(pt[i], back[i].Pt(), 1e-10);
+      EXPECT_NEAR(eta[i], back[i].Eta(), 1e-10);
+      EXPECT_NEAR(mass[i], back[i].M(), 1e-8);
+   }
+
+   // the round trip through the array of structures gives back the same columns
+   const LorentzVectorCollection<ROOT::Math::PtEtaPhiM4D<double>> coll2(aos);
+   CheckEqual(coll2.Column(0), pt);
+   CheckEqual(coll2.Column(3), mass);
+}
+
+TEST(VecOps, LorentzVectorCollectionKinematics)
+{
+   RVec<double> mass1 = {50, 50, 50, 50, 100};
+   RVec<double> pt1 = {0, 5, 5, 10, 10};
+   RVec<double> eta1 = {0.0, 0.0, -1.0, 0.5, 2.5};
+   RVec<double> phi1 = {0.0, 0.0, 0.0, -0.5, -2.4};
+
+   RVec<double> mass2 = {40, 40, 40, 40, 30};
+   RVec<double> pt2 = {0, 5, 5, 10, 2};
+   RVec<double> eta2 = {0.0, 0.0, 0.5, 0.4, 1.2};
+   RVec<double> phi2 = {0.0, 0.0, 0.0, 0.5, 2.4};
+
+   LorentzVectorCollection<ROOT::Math::PtEtaPhiM4D<double>> coll1(pt1, eta1, phi1, mass1);
+   LorentzVectorCollection<ROOT::Math::PtEtaPhiM4D<double>> coll2(pt2, eta2, phi2, mass2);
+
+   // same results as the functions taking the columns
+   const auto invMass = InvariantMasses(coll1, coll2);
+   const auto invMassRef = InvariantMasses(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2);
+   const auto invMassCart = InvariantMasses(coll1.As<ROOT::Math::PxPyPzE4D<double>>(), coll2);
+   for (std::size_t i = 0; i < mass1.size(); i++) {
+      EXPECT_NEAR(invMassRef[i], invMass[i], 1e-4);
+      EXPECT_NEAR(invMass[i], invMassCart[i], 1e-8);
+   }
+   EXPECT_NEAR(InvariantMass(pt1, eta1, phi1, mass1), InvariantMass(coll1), 1e-4);
+   CheckEqual(DeltaR(coll1, coll2), DeltaR(eta1, eta2, phi1, phi2));
+
+   ROOT::Math::PtEtaPhiMVector sum;
+   for (std::size_t i = 0; i < mass1.size(); i++)
+      sum += coll1[i];
+   const auto sum2 = coll1.Sum();
+   EXPECT_NEAR(sum.Px(), sum2.Px(), 1e-10);
+   EXPECT_NEAR(sum.Pz(), sum2.Pz(), 1e-10);
+   EXPECT_NEAR(sum.E(), sum2.E(), 1e-10);
+
+   const auto boosted = Boost(coll1, 0.1, -0.2, 0.5);
+   for (std::size_t i = 0; i < mass1.size(); i++) {
+      const auto p = ROOT::Math::VectorUtil::boost(coll1[i], ROOT::Math::XYZVector(0.1, -0.2, 0.5));
+      EXPECT_NEAR(p.Px(), boosted[i].Px(), 1e-8);
+      EXPECT_NEAR(p.Py(), boosted[i].Py(), 1e-8);
+      EXPECT_NEAR(p.Pz(), boosted[i].Pz(), 1e-8);
+      EXPECT_NEAR(p.E(), boosted[i].E(), 1e-8);
+      EXPECT_NEAR(mass1[i], boosted[i].M(), 1e-8);
+   }
+}
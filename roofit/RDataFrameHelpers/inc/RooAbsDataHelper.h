@@ -22,6 +22,7 @@
 #include <RooArgSet.h>
 #include <RooDataSet.h>
 #include <RooDataHist.h>
+#include <RooVectorDataStore.h>
 
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RDF/ActionHelpers.hxx>
@@ -33,6 +34,7 @@
 #include <cstddef>
 #include <string>
 #include <stdexcept>
+#include <type_traits>
 
 class TTreeReader;
 
@@ -63,6 +65,11 @@ class TTreeReader;
 /// ```
 /// \warning Variables in the dataset and columns in RDataFrame are **matched by position, not by name**.
 /// This enables the easy exchanging of columns that should be filled into the dataset.
+///
+/// If the dataset only holds unweighted real values (see RooVectorDataStore::canAppendColumns()), the values are
+/// collected in one column per variable and processing slot, which are handed to the dataset when the event loop
+/// finishes. The columns of the first slot are moved into the dataset without copying them. Like when setting the
+/// variables, values outside of the range of a variable are clipped to the range.
 template<class DataSet_t>
 class RooAbsDataHelper : public ROOT::Detail::RDF::RActionImpl<RooAbsDataHelper<DataSet_t>> {
 public:
@@ -75,6 +82,10 @@ private:
   std::vector<std::vector<double>> _events; // One vector of values per data-processing slot
   const std::size_t _eventSize; // Number of variables in dataset
 
+  RooVectorDataStore* _columnStore = nullptr; // Store that takes the values column by column, if possible
+  std::vector<std::vector<std::vector<double>>> _columns; // One vector of values per variable and slot
+  std::vector<const RooAbsRealLValue*> _columnVars; // The variables of the columns, whose ranges the values are clipped to
+
 public:
 
   /// Construct a helper to create RooDataSet/RooDataHist.
@@ -88,6 +99,17 @@ public:
   {
     const auto nSlots = ROOT::IsImplicitMTEnabled() ? ROOT::GetThreadPoolSize() : 1;
     _events.resize(nSlots);
+
+    if (std::is_same<DataSet_t, RooDataSet>::value) {
+      auto store = dynamic_cast<RooVectorDataStore*>(_dataset->store());
+      if (store && store->canAppendColumns()) {
+        _columnStore = store;
+        _columns.assign(nSlots, std::vector<std::vector<double>>(_eventSize));
+        for (const auto var : *_dataset->get()) {
+          _columnVars.push_back(static_cast<const RooAbsRealLValue*>(var));
+        }
+      }
+    }
   }
 
 
@@ -96,7 +118,10 @@ public:
   _dataset{ std::move(other._dataset) },
   _mutex_dataset(),
   _events{ std::move(other._events) },
-  _eventSize{ other._eventSize }
+  _eventSize{ other._eventSize },
+  _columnStore{ other._columnStore },
+  _columns{ std::move(other._columns) },
+  _columnVars{ std::move(other._columnVars) }
   {
 
   }
@@ -128,6 +153,18 @@ public:
       + " columns.");
     }
 
+    if (_columnStore) {
+      auto& columns = _columns[slot];
+      std::size_t j = 0;
+      for (auto&& val : {values...}) {
+        // Clip to the range like RooRealVar::setVal() does in FillDataSet()
+        double clipped;
+        _columnVars[j]->inRange(val, nullptr, &clipped);
+        columns[j++].push_back(clipped);
+      }
+      return;
+    }
+
     auto& vector = _events[slot];
     for (auto&& val : {values...}) {
       vector.push_back(val);
@@ -142,6 +179,12 @@ public:
 
   /// Empty all buffers into the dataset/hist to finish processing.
   void Finalize() {
+    for (auto& columns : _columns) {
+      // Moving the first columns into the empty dataset doesn't copy them
+      _columnStore->appendColumns(std::move(columns));
+      columns.clear();
+    }
+
     for (auto& vector : _events) {
       FillDataSet(vector, _eventSize);
       vector.clear();
@@ -10,6 +10,10 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 TEST(RooAbsDataHelper, MTConstruction)
 {
 #ifdef R__USE_IMT
@@ -76,3 +80,38 @@ TEST(RooAbsDataHelper, MTConstruction)
   EXPECT_NEAR(rooDataHist->moment(y, 2.), 0.25, 1.E-2); // Variance is affected in a binned distribution
 }
 
+/// Values outside of the range of the variables are clipped, as when they are added to the dataset one by one.
+TEST(RooAbsDataHelper, OutOfRangeValues)
+{
+  constexpr std::size_t nEvent = 100;
+  ROOT::RDataFrame d(nEvent);
+  auto dd = d.Define("x", [](ULong64_t entry) { return -20. + 0.4 * entry; }, {"rdfentry_"})
+               .Define("y", [](ULong64_t entry) { return 0.1 * entry; }, {"rdfentry_"});
+
+  RooRealVar x("x", "x", -5., 5.);
+  RooRealVar y("y", "y", 0., 2.);
+
+  auto rooDataSet = dd.Book<double, double>(RooDataSetHelper("dataset", "dataset", RooArgSet(x, y)), {"x", "y"});
+
+  RooDataSet expected("expected", "expected", RooArgSet(x, y));
+  for (std::size_t i = 0; i < nEvent; ++i) {
+    x.setVal(-20. + 0.4 * i);
+    y.setVal(0.1 * i);
+    expected.add(RooArgSet(x, y));
+  }
+
+  // With implicit multi-threading, the order of the events is not fixed
+  auto sortedRows = [](const RooDataSet &data) {
+    std::vector<std::pair<double, double>> rows;
+    for (int i = 0; i < data.numEntries(); ++i) {
+      const RooArgSet *row = data.get(i);
+      rows.emplace_back(static_cast<RooRealVar *>(row->find("x"))->getVal(),
+                        static_cast<RooRealVar *>(row->find("y"))->getVal());
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  };
+
+  ASSERT_EQ(rooDataSet->numEntries(), expected.numEntries());
+  EXPECT_EQ(sortedRows(*rooDataSet), sortedRows(expected));
+}
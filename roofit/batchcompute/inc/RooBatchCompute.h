@@ -7,6 +7,8 @@
 #include "BracketAdapter.h"
 #include "DllImport.h" //for R__EXTERN, needed for windows
 
+#include <vector>
+
 class RooAbsReal;
 class RooListProxy;
 
@@ -23,6 +25,22 @@ class RooListProxy;
  * on a specific platform.
  */
 namespace RooBatchCompute {
+  /**
+   * \brief Description of one axis of a histogram, for the histogram lookup functions of RooBatchComputeInterface.
+   *
+   * Bins are either uniform between `xmin` and `xmax`, or delimited by the `nBins + 1` entries of `boundaries`.
+   * Events outside of [`xmin`, `xmax`] get a value of zero.
+   */
+  struct HistogramAxis {
+    RooSpan<const double> values; ///< Coordinates of the events on this axis. If empty, `fixedBin` is used for all events.
+    std::size_t stride = 1;       ///< Distance in the bin content array between neighbouring bins of this axis
+    int nBins = 1;
+    double xmin = 0.;
+    double xmax = 1.;
+    const double* boundaries = nullptr; ///< Bin boundaries of non-uniform binnings, nullptr for uniform binnings
+    int fixedBin = 0;
+  };
+
   /**
    * \brief The interface which should be implemented to provide optimised computation functions for implementations of RooAbsReal::evaluateSpan().
    *
@@ -45,14 +63,17 @@ namespace RooBatchCompute {
     virtual RooSpan<double> computeCBShape(const RooAbsReal*, RunContext&, RooSpan<const double> m, RooSpan<const double> m0, RooSpan<const double> sigma, RooSpan<const double> alpha, RooSpan<const double> n) = 0;
     virtual void computeChebychev(size_t batchSize, double * __restrict output, const double * __restrict const xData, double xmin, double xmax, std::vector<double> coef) = 0;
     virtual RooSpan<double> computeChiSquare(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> ndof) = 0;
+    virtual void computeCoefficientSum(size_t batchSize, double * __restrict output, const std::vector<RooSpan<const double>>& inputs, const std::vector<double>& coefs) = 0;
     virtual RooSpan<double> computeDstD0BG(const RooAbsReal*, RunContext&, RooSpan<const double> dm, RooSpan<const double> dm0, RooSpan<const double> C, RooSpan<const double> A, RooSpan<const double> B) = 0;
     virtual RooSpan<double> computeExponential(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> c) = 0;
     virtual RooSpan<double> computeGamma(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> gamma, RooSpan<const double> beta, RooSpan<const double> mu) = 0;
     virtual RooSpan<double> computeGaussian(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> sigma) = 0;
+    virtual void computeHistogram(size_t batchSize, double * __restrict output, const std::vector<HistogramAxis>& axes, const double * __restrict binContents, const double * __restrict binVolumes, int intOrder, bool cdfBoundaries) = 0;
     virtual RooSpan<double> computeJohnson(const RooAbsReal*, RunContext&, RooSpan<const double> mass, RooSpan<const double> mu, RooSpan<const double> lambda, RooSpan<const double> gamma, RooSpan<const double> delta, double massThreshold) = 0;
     virtual RooSpan<double> computeLandau(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> sigma) = 0;
     virtual RooSpan<double> computeLognormal(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> m0, RooSpan<const double> k) = 0;
     virtual RooSpan<double> computeNovosibirsk(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> peak, RooSpan<const double> width, RooSpan<const double> tail) = 0;
+    virtual void computePiecewiseInterpolation(size_t batchSize, double * __restrict sum, RooSpan<const double> nominal, RooSpan<const double> low, RooSpan<const double> high, double param, int interpCode) = 0;
     virtual RooSpan<double> computePoisson(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> mean, bool protectNegative, bool noRounding) = 0;
     virtual void computePolynomial(size_t batchSize, double * __restrict output, const double * __restrict const xData, int lowestOrder, std::vector<BracketAdapterWithMask> &coef) = 0;
     virtual RooSpan<double> computeVoigtian(const RooAbsReal*, RunContext&, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> width, RooSpan<const double> sigma) = 0;
@@ -2,6 +2,8 @@
 #include "RooBatchCompute.h"
 #include "RooMath.h"
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
 
 namespace RooBatchCompute {
@@ -251,6 +253,36 @@ namespace RooBatchCompute {
     }
   };
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /// Sum of inputs weighted with coefficients, as needed in RooAddPdf and RooRealSumPdf.
+    /// Inputs with a single value are broadcast. The output is processed in blocks, such that it stays in the cache
+    /// while the inputs are added one after the other.
+    void startComputationCoefficientSum(size_t batchSize, double * __restrict output, const std::vector<RooSpan<const double>>& inputs, const std::vector<double>& coefs)
+    {
+      constexpr size_t block = 1024;
+      for (size_t begin=0; begin<batchSize; begin+=block) {
+        const size_t stop = std::min(batchSize, begin+block);
+        for (size_t i=begin; i<stop; i++) {
+          output[i] = 0.0;
+        }
+        for (size_t k=0; k<inputs.size(); k++) {
+          const double coef = coefs[k];
+          const double * __restrict const input = inputs[k].data();
+          if (inputs[k].size() > 1) {
+            for (size_t i=begin; i<stop; i++) {
+              output[i] += coef*input[i];
+            }
+          } else {
+            const double value = coef*input[0];
+            for (size_t i=begin; i<stop; i++) {
+              output[i] += value;
+            }
+          }
+        }
+      }
+    }
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     struct DstD0BGComputer {
@@ -348,6 +380,107 @@ namespace RooBatchCompute {
       }
     };
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /// Bin number of `x` on a histogram axis. Values outside of the axis are put in the first or last bin, as in
+    /// RooUniformBinning::binNumber() and RooBinning::binNumber().
+    inline int histogramBin(const HistogramAxis& axis, double x)
+    {
+      int bin;
+      if (axis.boundaries) {
+        bin = std::upper_bound(axis.boundaries, axis.boundaries+axis.nBins+1, x) - axis.boundaries - 1;
+      } else {
+        bin = static_cast<int>((x-axis.xmin) / ((axis.xmax-axis.xmin)/axis.nBins));
+      }
+      return std::max(0, std::min(axis.nBins-1, bin));
+    }
+
+    inline double histogramBinCenter(const HistogramAxis& axis, int bin)
+    {
+      if (axis.boundaries) return 0.5*(axis.boundaries[bin] + axis.boundaries[bin+1]);
+      return axis.xmin + (bin+0.5)*(axis.xmax-axis.xmin)/axis.nBins;
+    }
+
+    /// Histogram lookup as in RooDataHist::weightFast(). With `intOrder = 0`, the content of the bin that contains the
+    /// coordinates is returned. With `intOrder = 1`, the contents are linearly interpolated between the bin centres
+    /// along the only axis that has values, mirroring the histogram at its boundaries, or, with `cdfBoundaries`,
+    /// assuming zero below and one above the histogram, like RooDataHist::interpolateDim().
+    /// If `binVolumes` is not null, bin contents are divided by the bin volumes.
+    void startComputationHistogram(size_t batchSize, double * __restrict output, const std::vector<HistogramAxis>& axes, const double * __restrict binContents, const double * __restrict binVolumes, int intOrder, bool cdfBoundaries)
+    {
+      constexpr size_t block = 1024;
+      size_t index[block];
+      double inRange[block];
+
+      auto content = [=](size_t idx) {
+        return binVolumes ? binContents[idx] / binVolumes[idx] : binContents[idx];
+      };
+
+      for (size_t begin=0; begin<batchSize; begin+=block) {
+        const size_t stop = std::min(batchSize, begin+block) - begin;
+        for (size_t i=0; i<stop; i++) {
+          index[i] = 0;
+          inRange[i] = 1.0;
+        }
+
+        const HistogramAxis* interpolationAxis = nullptr;
+        for (const auto& axis : axes) {
+          if (axis.values.empty()) {
+            for (size_t i=0; i<stop; i++) index[i] += axis.stride*axis.fixedBin;
+            continue;
+          }
+          if (intOrder > 0) interpolationAxis = &axis;
+
+          const double * __restrict const x = axis.values.data();
+          const size_t mask = axis.values.size() > 1 ? ~static_cast<size_t>(0) : 0;
+          for (size_t i=0; i<stop; i++) {
+            const double xi = x[(begin+i) & mask];
+            const bool isInRange = xi >= axis.xmin && xi <= axis.xmax;
+            inRange[i] *= isInRange;
+            index[i] += axis.stride * histogramBin(axis, isInRange ? xi : axis.xmin);
+          }
+        }
+
+        if (interpolationAxis == nullptr) {
+          for (size_t i=0; i<stop; i++) {
+            output[begin+i] = inRange[i] * content(index[i]);
+          }
+          continue;
+        }
+
+        const HistogramAxis& axis = *interpolationAxis;
+        const size_t mask = axis.values.size() > 1 ? ~static_cast<size_t>(0) : 0;
+        for (size_t i=0; i<stop; i++) {
+          if (inRange[i] == 0.0) {
+            output[begin+i] = 0.0;
+            continue;
+          }
+          const double xi = axis.values[(begin+i) & mask];
+          const int binC = histogramBin(axis, xi);
+          const int binLo = binC - (xi < histogramBinCenter(axis, binC) ? 1 : 0);
+          const size_t offset = index[i] - axis.stride*binC;
+
+          double xarr[2], yarr[2];
+          for (int k=0; k<2; k++) {
+            const int bin = binLo + k;
+            if (bin >= 0 && bin < axis.nBins) {
+              xarr[k] = histogramBinCenter(axis, bin);
+              yarr[k] = content(offset + axis.stride*bin);
+            } else if (bin >= axis.nBins) {
+              const int mirrorBin = 2*axis.nBins - bin - 1;
+              xarr[k] = cdfBoundaries ? axis.xmax + 1e-10*(bin - axis.nBins + 1) : 2*axis.xmax - histogramBinCenter(axis, mirrorBin);
+              yarr[k] = cdfBoundaries ? 1.0 : content(offset + axis.stride*mirrorBin);
+            } else {
+              const int mirrorBin = -bin - 1;
+              xarr[k] = cdfBoundaries ? axis.xmin - mirrorBin*1e-10 : 2*axis.xmin - histogramBinCenter(axis, mirrorBin);
+              yarr[k] = cdfBoundaries ? 0.0 : content(offset + axis.stride*mirrorBin);
+            }
+          }
+          output[begin+i] = yarr[0] + (xi-xarr[0]) * (yarr[1]-yarr[0]) / (xarr[1]-xarr[0]);
+        }
+      }
+    }
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     struct JohnsonComputer {
@@ -527,6 +660,79 @@ namespace RooBatchCompute {
       }
     };
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /// Add the effect of one nuisance parameter to the interpolated histogram `sum`, as in
+    /// PiecewiseInterpolation::evaluate(). The interpolation code must be valid, i.e. between 0 and 5.
+    template<class Tnom, class Tlow, class Thigh>
+    void startComputationPiecewiseInterpolation(size_t batchSize, double * __restrict sum, Tnom nominal, Tlow low, Thigh high, double param, int interpCode)
+    {
+      switch (interpCode) {
+      case 0:
+        // piece-wise linear
+        for (size_t i=0; i<batchSize; i++) {
+          sum[i] += param>0 ? param*(high[i]-nominal[i]) : param*(nominal[i]-low[i]);
+        }
+        break;
+      case 1:
+        // piece-wise log
+        for (size_t i=0; i<batchSize; i++) {
+          sum[i] *= param>=0 ? std::pow(high[i]/nominal[i], +param) : std::pow(low[i]/nominal[i], -param);
+        }
+        break;
+      case 2:
+      case 3:
+        // parabolic with linear extrapolation; code 3 is the parabolic version of log-normal, which is computed in
+        // the same way
+        for (size_t i=0; i<batchSize; i++) {
+          const double a = 0.5*(high[i]+low[i])-nominal[i];
+          const double b = 0.5*(high[i]-low[i]);
+          if (param > 1.0) {
+            sum[i] += (2*a+b)*(param-1)+high[i]-nominal[i];
+          } else if (param < -1.0) {
+            sum[i] += -1*(2*a-b)*(param+1)+low[i]-nominal[i];
+          } else {
+            sum[i] += a*param*param + b*param;
+          }
+        }
+        break;
+      case 4:
+        // polynomial interpolation with linear extrapolation
+        for (size_t i=0; i<batchSize; i++) {
+          if (param > 1.0) {
+            sum[i] += param*(high[i]-nominal[i]);
+          } else if (param < -1.0) {
+            sum[i] += param*(nominal[i]-low[i]);
+          } else {
+            const double eps_plus = high[i]-nominal[i];
+            const double eps_minus = nominal[i]-low[i];
+            const double S = 0.5*(eps_plus+eps_minus);
+            const double A = 0.0625*(eps_plus-eps_minus);
+            const double val = nominal[i] + param*(S + param*A*(15.0 + param*param*(-10.0 + param*param*3.0)));
+            sum[i] += (val < 0.0 ? 0.0 : val) - nominal[i];
+          }
+        }
+        break;
+      case 5:
+        for (size_t i=0; i<batchSize; i++) {
+          if (param > 1.0 || param < -1.0) {
+            sum[i] += param>0 ? param*(high[i]-nominal[i]) : param*(nominal[i]-low[i]);
+          } else if (nominal[i] != 0) {
+            const double eps_plus = high[i]-nominal[i];
+            const double eps_minus = nominal[i]-low[i];
+            const double S = (eps_plus+eps_minus)/2;
+            const double A = (eps_plus-eps_minus)/2;
+            const double a = S;
+            const double b = 3*A/2;
+            const double d = -A/2;
+            const double val = nominal[i] + a*param + b*param*param + d*param*param*param*param;
+            sum[i] += (val < 0.0 ? 0.0 : val) - nominal[i];
+          }
+        }
+        break;
+      }
+    }
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     struct PoissonComputer {
@@ -724,6 +930,9 @@ namespace RooBatchCompute {
         RooSpan<double> computeChiSquare(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> ndof)  override {
           return startComputation(caller, evalData, ChiSquareComputer{}, x, ndof);
         }
+        void computeCoefficientSum(size_t batchSize, double * __restrict output, const std::vector<RooSpan<const double>>& inputs, const std::vector<double>& coefs)  override {
+          startComputationCoefficientSum(batchSize, output, inputs, coefs);
+        }
         RooSpan<double> computeDstD0BG(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> dm, RooSpan<const double> dm0, RooSpan<const double> C, RooSpan<const double> A, RooSpan<const double> B)  override {
           return startComputation(caller, evalData, DstD0BGComputer{}, dm, dm0, C, A, B);
         }
@@ -736,6 +945,9 @@ namespace RooBatchCompute {
         RooSpan<double> computeGaussian(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> sigma)  override {
           return startComputation(caller, evalData, GaussianComputer{}, x, mean, sigma);
         }
+        void computeHistogram(size_t batchSize, double * __restrict output, const std::vector<HistogramAxis>& axes, const double * __restrict binContents, const double * __restrict binVolumes, int intOrder, bool cdfBoundaries)  override {
+          startComputationHistogram(batchSize, output, axes, binContents, binVolumes, intOrder, cdfBoundaries);
+        }
         RooSpan<double> computeJohnson(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> mass, RooSpan<const double> mu, RooSpan<const double> lambda, RooSpan<const double> gamma, RooSpan<const double> delta, double massThreshold)  override {
           return startComputation(caller, evalData, JohnsonComputer{massThreshold}, mass, mu, lambda, gamma, delta);
         }
@@ -748,6 +960,13 @@ namespace RooBatchCompute {
         RooSpan<double> computeNovosibirsk(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> peak, RooSpan<const double> width, RooSpan<const double> tail)  override {
           return startComputation(caller, evalData, NovosibirskComputer{}, x, peak, width, tail);
         }
+        void computePiecewiseInterpolation(size_t batchSize, double * __restrict sum, RooSpan<const double> nominal, RooSpan<const double> low, RooSpan<const double> high, double param, int interpCode)  override {
+          if (nominal.size() > 1 && low.size() > 1 && high.size() > 1) {
+            startComputationPiecewiseInterpolation(batchSize, sum, nominal.data(), low.data(), high.data(), param, interpCode);
+          } else {
+            startComputationPiecewiseInterpolation(batchSize, sum, BracketAdapterWithMask(nominal), BracketAdapterWithMask(low), BracketAdapterWithMask(high), param, interpCode);
+          }
+        }
         RooSpan<double> computePoisson(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, bool protectNegative, bool noRounding)  override {
           return startComputation(caller, evalData, PoissonComputer{protectNegative, noRounding}, x, mean);
         }
@@ -592,38 +592,26 @@ Double_t ParamHistFunc::evaluate() const
 /// \param[in/out] evalData Input/output data for evaluating the ParamHistFunc.
 /// \param[in] normSet Normalisation set passed on to objects that are serving values to us.
 RooSpan<double> ParamHistFunc::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
-  std::vector<double> oldValues;
   std::vector<RooSpan<const double>> data;
   std::size_t batchSize = 0;
 
   // Retrieve data for all variables
   for (auto arg : _dataVars) {
     const auto* var = static_cast<RooRealVar*>(arg);
-    oldValues.push_back(var->getVal());
     data.push_back(var->getValues(evalData, normSet));
     batchSize = std::max(batchSize, data.back().size());
   }
 
-  // Run computation for each entry in the dataset
-  RooSpan<double> output = evalData.makeBatch(this, batchSize);
-
-  for (std::size_t i = 0; i < batchSize; ++i) {
-    for (unsigned int j = 0; j < _dataVars.size(); ++j) {
-      assert(i < data[j].size());
-      auto& var = static_cast<RooRealVar&>(_dataVars[j]);
-      var.setCachedValue(data[j][i], /*notifyClients=*/false);
-    }
-
-    const auto index = _dataSet.getIndex(_dataVars, /*fast=*/true);
-    const RooRealVar& param = getParameter(index);
-    output[i] = param.getVal();
+  // The parameters take the role of the bin contents of the histogram
+  std::vector<double> binContents(numBins());
+  for (std::size_t i = 0; i < binContents.size(); ++i) {
+    binContents[i] = getParameter(i).getVal();
   }
 
-  // Restore old values
-  for (unsigned int j = 0; j < _dataVars.size(); ++j) {
-    auto& var = static_cast<RooRealVar&>(_dataVars[j]);
-    var.setCachedValue(oldValues[j], /*notifyClients=*/false);
-  }
+  // Look up the bin of each entry in the dataset
+  RooSpan<double> output = evalData.makeBatch(this, batchSize);
+  _dataSet.weights(output, _dataVars, data, /*intOrder=*/0, /*correctForBinSize=*/false, /*cdfBoundaries=*/false,
+                   binContents.data());
 
   return output;
 }
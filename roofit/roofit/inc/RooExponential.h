@@ -34,6 +34,9 @@ public:
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const override;
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const override;
 
+  bool translate(RooCodeGenContext& ctx) const override;
+  std::string translateAnalyticalIntegral(Int_t code, const char* rangeName, RooCodeGenContext& ctx) const override;
+
 protected:
   RooRealProxy x;
   RooRealProxy c;
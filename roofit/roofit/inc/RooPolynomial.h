@@ -40,6 +40,9 @@ public:
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
 
+  virtual bool translate(RooCodeGenContext& ctx) const ;
+  virtual std::string translateAnalyticalIntegral(Int_t code, const char* rangeName, RooCodeGenContext& ctx) const ;
+
 protected:
 
   RooRealProxy _x;
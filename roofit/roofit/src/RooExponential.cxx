@@ -29,6 +29,8 @@ range and values of the arguments.
 
 #include "RooRealVar.h"
 #include "RooBatchCompute.h"
+#include "RooCodeGenContext.h"
+#include "RooNumber.h"
 
 
 #include <cmath>
@@ -88,6 +90,37 @@ Double_t RooExponential::analyticalIntegral(Int_t code, const char* rangeName) c
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute multiple values of Exponential distribution.
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the unnormalised exponential, like evaluate().
+
+bool RooExponential::translate(RooCodeGenContext& ctx) const
+{
+  ctx.addResult(this, "TMath::Exp(" + ctx.getResult(c.arg()) + " * " + ctx.getResult(x.arg()) + ")");
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the integrals of analyticalIntegral(). An infinite integration
+/// limit contributes zero, assuming that the integral converges.
+
+std::string RooExponential::translateAnalyticalIntegral(Int_t code, const char* rangeName, RooCodeGenContext& ctx) const
+{
+  assert(code == 1 || code ==2);
+
+  const std::string& constant = ctx.getResult(code == 1 ? c.arg() : x.arg());
+  auto& integrand = code == 1 ? x : c;
+  const double max = integrand.max(rangeName);
+  const double min = integrand.min(rangeName);
+
+  auto expAt = [&](double limit) -> std::string {
+    if (RooNumber::isInfinite(limit)) return "0.";
+    return "TMath::Exp(" + constant + " * " + RooCodeGenContext::literal(limit) + ")";
+  };
+
+  return "(" + constant + " == 0. ? " + RooCodeGenContext::literal(max - min) + " : (" + expAt(max) + " - " +
+         expAt(min) + ") / " + constant + ")";
+}
+
 RooSpan<double> RooExponential::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
   return RooBatchCompute::dispatch->computeExponential(this, evalData, x->getValues(evalData, normSet), c->getValues(evalData, normSet));
 }
@@ -26,6 +26,8 @@ Plain Gaussian p.d.f
 #include "RooMath.h"
 #include "RooHelpers.h"
 #include "RooBatchCompute.h"
+#include "RooCodeGenContext.h"
+#include "RooNumber.h"
 
 
 ClassImp(RooGaussian);
@@ -114,6 +116,42 @@ Double_t RooGaussian::analyticalIntegral(Int_t code, const char* rangeName) cons
   );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the unnormalised Gaussian, like evaluate().
+
+bool RooGaussian::translate(RooCodeGenContext& ctx) const
+{
+  const std::string& xVal = ctx.getResult(x.arg());
+  const std::string& meanVal = ctx.getResult(mean.arg());
+  const std::string& sigmaVal = ctx.getResult(sigma.arg());
+  ctx.addResult(this, "TMath::Exp(-0.5 * (" + xVal + " - " + meanVal + ") * (" + xVal + " - " + meanVal + ") / ("
+                          + sigmaVal + " * " + sigmaVal + "))");
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the integrals of analyticalIntegral(). Infinite integration
+/// limits are replaced by the asymptotic values of the error function, such that their
+/// derivatives are well defined.
+
+std::string RooGaussian::translateAnalyticalIntegral(Int_t code, const char* rangeName, RooCodeGenContext& ctx) const
+{
+  assert(code==1 || code==2);
+
+  const RooRealProxy& integrand = code == 1 ? x : mean;
+  const std::string& centre = ctx.getResult(code == 1 ? mean.arg() : x.arg());
+  const std::string& sigmaVal = ctx.getResult(sigma.arg());
+  const std::string xscale = "(" + RooCodeGenContext::literal(TMath::Sqrt2()) + " * " + sigmaVal + ")";
+
+  auto erfAt = [&](double limit) -> std::string {
+    if (RooNumber::isInfinite(limit)) return limit > 0. ? "1." : "(-1.)";
+    return "TMath::Erf((" + RooCodeGenContext::literal(limit) + " - " + centre + ") / " + xscale + ")";
+  };
+
+  return RooCodeGenContext::literal(std::sqrt(TMath::TwoPi())) + " * " + sigmaVal + " * 0.5 * (" +
+         erfAt(integrand.max(rangeName)) + " - " + erfAt(integrand.min(rangeName)) + ")";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooGaussian::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const
@@ -34,6 +34,7 @@ RooPolynomial::RooPolynomial(const char*, const char*, RooAbsReal&, const RooArg
 #include "RooArgList.h"
 #include "RooMsgService.h"
 #include "RooBatchCompute.h"
+#include "RooCodeGenContext.h"
 
 #include "TError.h"
 #include <vector>
@@ -199,3 +200,44 @@ Double_t RooPolynomial::analyticalIntegral(Int_t code, const char* rangeName) co
   return max * std::pow(xmax, 1 + lowestOrder) - min * std::pow(xmin, 1 + lowestOrder) +
       (lowestOrder ? (xmax - xmin) : 0.);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the polynomial, using Horner's method like evaluate().
+bool RooPolynomial::translate(RooCodeGenContext& ctx) const
+{
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    ctx.addResult(this, lowestOrder ? "1." : "0.");
+    return true;
+  }
+
+  const std::string& x = ctx.getResult(_x.arg());
+  std::string retVal = ctx.getResult(_coefList[sz - 1]);
+  for (unsigned i = sz - 1; i--; ) retVal = "(" + ctx.getResult(_coefList[i]) + " + " + x + " * " + retVal + ")";
+  for (int i = 0; i < lowestOrder; ++i) retVal += " * " + x;
+  ctx.addResult(this, retVal + (lowestOrder ? " + 1." : ""));
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the integral of analyticalIntegral().
+std::string RooPolynomial::translateAnalyticalIntegral(Int_t code, const char* rangeName, RooCodeGenContext& ctx) const
+{
+  R__ASSERT(code==1) ;
+
+  const Double_t xmin = _x.min(rangeName), xmax = _x.max(rangeName);
+  const int lowestOrder = _lowestOrder;
+  const unsigned sz = _coefList.getSize();
+  if (!sz) return RooCodeGenContext::literal(xmax - xmin);
+
+  auto primitiveAt = [&](double xval) {
+    const std::string xLit = RooCodeGenContext::literal(xval);
+    auto coef = [&](unsigned i) { return ctx.getResult(_coefList[i]) + " / " + std::to_string(i + 1 + lowestOrder) + "."; };
+    std::string result = "(" + coef(sz - 1) + ")";
+    for (unsigned i = sz - 1; i--; ) result = "(" + coef(i) + " + " + xLit + " * " + result + ")";
+    return result + " * " + RooCodeGenContext::literal(std::pow(xval, 1 + lowestOrder));
+  };
+
+  return primitiveAt(xmax) + " - " + primitiveAt(xmin) + (lowestOrder ? " + " + RooCodeGenContext::literal(xmax - xmin) : "");
+}
@@ -40,6 +40,7 @@ public:
   }
 
   virtual Double_t operator()(const Double_t xvector[]) const = 0;
+  virtual RooSpan<const double> getValues(std::vector<RooSpan<const double>> coordinates) const;
   virtual Double_t getMinLimit(UInt_t dimension) const = 0;
   virtual Double_t getMaxLimit(UInt_t dimension) const = 0;
 
@@ -77,6 +78,7 @@ protected:
   mutable Int_t _ncall ; // Function call counter
   UInt_t _dimension;     // Number of observables
   Bool_t _valid;         // Is binding in valid state?
+  mutable std::vector<double> _batchValues; //! Results of the default getValues()
    ClassDef(RooAbsFunc,0) // Abstract real-valued function interface
 };
 
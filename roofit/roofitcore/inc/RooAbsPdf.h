@@ -277,6 +277,7 @@ public:
   double expectedEvents(const RooArgSet& nset) const {
     return expectedEvents(&nset) ; 
   }
+  virtual std::string translateExpectedEvents(RooCodeGenContext& ctx) const;
 
   // Printing interface (human readable)
   virtual void printValue(std::ostream& os) const ;
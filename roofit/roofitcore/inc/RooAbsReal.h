@@ -42,6 +42,8 @@ class RooFitResult ;
 class RooAbsMoment ;
 class RooDerivative ;
 class RooVectorDataStore ;
+class RooCodeGenContext ;
+class RooSharedValueCache ;
 namespace RooBatchCompute{
 class BatchInterfaceAccessor;
 struct RunContext;
@@ -176,6 +178,10 @@ public:
   }
   Bool_t getForceNumInt() const { return _forceNumInt ; }
 
+  // Code generation for automatic differentiation, see RooCodeGenContext
+  virtual bool translate(RooCodeGenContext& ctx) const;
+  virtual std::string translateAnalyticalIntegral(Int_t code, const char* rangeName, RooCodeGenContext& ctx) const;
+
   // Chi^2 fits to histograms
   virtual RooFitResult* chi2FitTo(RooDataHist& data, const RooCmdArg& arg1=RooCmdArg::none(),  const RooCmdArg& arg2=RooCmdArg::none(),  
                               const RooCmdArg& arg3=RooCmdArg::none(),  const RooCmdArg& arg4=RooCmdArg::none(), const RooCmdArg& arg5=RooCmdArg::none(),  
@@ -578,6 +584,9 @@ protected:
   mutable RooArgSet* _lastNSet ; //!
   static Bool_t _hideOffset ; // Offset hiding flag
 
+  friend class RooSharedValueCache ;
+  RooSharedValueCache* _sharedValueCache = nullptr ; //! Cache that shares the value with clones in other channels
+
   ClassDef(RooAbsReal,2) // Abstract real-valued variable
 };
 
@@ -30,6 +30,7 @@ class RooAbsData ;
 class RooAbsReal ;
 class RooSimultaneous ;
 class RooRealMPFE ;
+class RooSharedValueCache ;
 
 class RooAbsTestStatistic ;
 typedef RooAbsTestStatistic* pRooAbsTestStatistic ;
@@ -78,6 +79,11 @@ public:
   virtual Double_t offset() const { return _offset.Sum() ; }
   virtual Double_t offsetCarry() const { return _offset.Carry(); }
 
+  /// Cache for the values that are shared between the channels of a RooSimultaneous, or nullptr if none are shared.
+  const RooSharedValueCache* sharedValueCache() const { return _sharedValueCache ; }
+  static void setShareValuesBetweenChannels(Bool_t flag) ;
+  static Bool_t shareValuesBetweenChannels() ;
+
 protected:
 
   virtual void printCompactTreeHook(std::ostream& os, const char* indent="") ;
@@ -135,6 +141,7 @@ protected:
 
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, std::string const& rangeName, std::string const& addCoefRangeName) ;    
+  void initSharedValueCache() ;
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, std::string const& rangeName, std::string const& addCoefRangeName) ;
 
   mutable Bool_t _init = false;   //! Is object initialized  
@@ -149,6 +156,7 @@ protected:
   Int_t          _nGof = 0    ; // Number of sub-contexts 
   pRooAbsTestStatistic* _gofArray = nullptr; //! Array of sub-contexts representing part of the combined test statistic
   std::vector<RooFit::MPSplit> _gofSplitMode ; //! GOF MP Split mode specified by component (when Auto is active)
+  RooSharedValueCache* _sharedValueCache = nullptr; //! Values of functions shared between the sub-contexts
   
   // Parallel mode data
   Int_t          _nCPU = 1;   //  Number of processors to use in parallel calculation mode
@@ -90,6 +90,9 @@ public:
   CacheMode canNodeBeCached() const override { return RooAbsArg::NotAdvised ; };
   void setCacheAndTrackHints(RooArgSet&) override;
 
+  bool translate(RooCodeGenContext& ctx) const override;
+  std::string translateExpectedEvents(RooCodeGenContext& ctx) const override;
+
 protected:
 
   void selectNormalization(const RooArgSet* depSet=0, bool force=false) override;
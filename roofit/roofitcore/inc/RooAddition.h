@@ -57,6 +57,8 @@ public:
 
   virtual void enableOffsetting(Bool_t) ;
 
+  virtual bool translate(RooCodeGenContext& ctx) const;
+
 protected:
 
   RooArgList   _ownedList ;      // List of owned components
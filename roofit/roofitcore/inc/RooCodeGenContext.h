@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_CODE_GEN_CONTEXT
+#define ROO_CODE_GEN_CONTEXT
+
+#include "RooArgList.h"
+#include "RooArgSet.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class RooAbsArg;
+class RooAbsPdf;
+
+class RooCodeGenContext {
+public:
+  RooCodeGenContext(const std::string& name, const RooArgSet& observables, const RooArgSet& normSet,
+                    const RooArgList& parameters);
+  RooCodeGenContext(const RooCodeGenContext&) = delete;
+  RooCodeGenContext& operator=(const RooCodeGenContext&) = delete;
+
+  // Interface for RooAbsReal::translate() and friends
+  const std::string& getResult(const RooAbsArg& arg);
+  std::string getNormalizedResult(const RooAbsPdf& pdf);
+  void addResult(const RooAbsArg* owner, const std::string& expression);
+  void addToCodeBody(const RooAbsArg* owner, const std::string& code);
+  std::string getTmpVarName();
+  std::string addColumn(std::function<double()> fill);
+  std::string addIntArray(const std::vector<int>& values);
+  int parameterIndex(const RooAbsArg& arg) const;
+  /// The observables over which PDFs are normalised.
+  const RooArgSet& normSet() const { return _normSet; }
+  bool fail(const RooAbsArg& arg, const std::string& reason);
+
+  static std::string literal(double value);
+
+  // Interface for the generators of the functions
+  /// False if any of the objects could not be translated.
+  bool isValid() const { return _failure.empty(); }
+  /// Reason why the translation failed.
+  const std::string& failure() const { return _failure; }
+  /// Parameters of the generated function, in the order of the `params` array.
+  const RooArgList& parameters() const { return _parameters; }
+  /// Number of values per event that need to be filled into the `obs` array.
+  std::size_t numColumns() const { return _columns.size(); }
+  void fillColumns(double* output, std::size_t stride) const;
+  /// Declarations that need to precede the generated function.
+  const std::string& declarations() const { return _declarations; }
+  /// Code that only depends on parameters, and needs to be computed once per function call.
+  const std::string& globalCode() const { return _globalCode; }
+  /// Code that depends on the observables, and needs to be computed in the loop over events.
+  const std::string& loopCode() const { return _loopCode; }
+
+private:
+  bool dependsOnEvent(const RooAbsArg& arg) const;
+  std::string declare(bool inLoop, const std::string& expression);
+
+  std::string _name;
+  RooArgSet _observables;
+  RooArgSet _normSet;
+  RooArgList _parameters;
+  std::map<const RooAbsArg*, std::string> _results;
+  std::map<const RooAbsArg*, std::string> _normalizedResults;
+  std::vector<std::function<double()>> _columns;
+  std::string _declarations;
+  std::string _globalCode;
+  std::string _loopCode;
+  std::string _failure;
+  std::size_t _tmpVarCounter = 0;
+};
+
+#endif
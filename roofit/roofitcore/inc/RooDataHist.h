@@ -110,6 +110,8 @@ public:
   /// Return weight of i-th bin. \see getIndex()
   double weight(std::size_t i) const { return _wgt[i]; }
   double weightFast(const RooArgSet& bin, int intOrder, bool correctForBinSize, bool cdfBoundaries);
+  bool weights(RooSpan<double> output, const RooAbsCollection& bin, const std::vector<RooSpan<const double>>& coordinates,
+               int intOrder, bool correctForBinSize, bool cdfBoundaries, const double* binContents = nullptr);
   Double_t weight(const RooArgSet& bin, Int_t intOrder=1, Bool_t correctForBinSize=kFALSE, Bool_t cdfBoundaries=kFALSE, Bool_t oneSafe=kFALSE);
   /// Return squared weight sum of i-th bin. \see getIndex()
   double weightSquared(std::size_t i) const { return get_sumw2(i); }
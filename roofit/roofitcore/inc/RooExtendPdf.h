@@ -45,6 +45,9 @@ public:
   virtual ExtendMode extendMode() const { return CanBeExtended ; }
   virtual Double_t expectedEvents(const RooArgSet* nset) const ;
 
+  virtual bool translate(RooCodeGenContext& ctx) const ;
+  virtual std::string translateExpectedEvents(RooCodeGenContext& ctx) const ;
+
 protected:
 
   RooTemplateProxy<RooAbsPdf>  _pdf;        // Input p.d.f
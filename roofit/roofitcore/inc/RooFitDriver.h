@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_FIT_DRIVER
+#define ROO_FIT_DRIVER
+
+#include "RooSpan.h"
+#include "RunContext.h"
+
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+class RooAbsArg;
+class RooAbsData;
+class RooAbsPdf;
+class RooAbsReal;
+class RooArgSet;
+
+class RooFitDriver {
+public:
+  RooFitDriver(const RooAbsPdf& topNode, const RooArgSet& observables);
+  RooFitDriver(const RooFitDriver&) = delete;
+  RooFitDriver& operator=(const RooFitDriver&) = delete;
+
+  RooSpan<const double> getLogProbabilities(const RooAbsData& data, std::size_t firstEvent, std::size_t nEvents,
+                                            const RooArgSet* normSet);
+
+  /// The RunContext holding the results of the last evaluation.
+  RooBatchCompute::RunContext& runContext() { return _evalData; }
+  /// Number of nodes that were recomputed in the last evaluation.
+  std::size_t nRecomputed() const { return _nRecomputed; }
+  /// Number of nodes of the computation graph.
+  std::size_t nNodes() const { return _nodes.size(); }
+
+private:
+  struct NodeInfo {
+    RooAbsArg* arg = nullptr;
+    RooAbsReal* real = nullptr;          ///< Set if the node serves real values
+    std::vector<std::size_t> servers;    ///< Indices of the servers of this node in _nodes
+    bool isObservable = false;           ///< Values come from the dataset
+    bool isParameter = false;            ///< A RooRealVar that is not an observable
+    bool dirty = true;
+    double lastValue = std::numeric_limits<double>::quiet_NaN(); ///< Last value of nodes without servers
+    RooSpan<const double> span;          ///< Result of the last evaluation
+  };
+
+  struct DataSpan {
+    const RooAbsReal* owner;
+    const double* data;
+    std::size_t size;
+    bool operator==(const DataSpan& other) const {
+      return owner == other.owner && data == other.data && size == other.size;
+    }
+  };
+
+  void sortTopologically(RooAbsArg& node, std::unordered_map<const RooAbsArg*, std::size_t>& indices);
+
+  const RooAbsPdf& _topNode;
+  std::vector<NodeInfo> _nodes; ///< Servers before clients
+  RooBatchCompute::RunContext _evalData;
+  const RooAbsData* _lastData = nullptr;
+  const RooArgSet* _lastNormSet = nullptr;
+  std::size_t _lastFirstEvent = std::numeric_limits<std::size_t>::max();
+  std::size_t _lastNEvents = 0;
+  std::vector<DataSpan> _lastDataSpans; ///< Spans of data that were provided by the dataset in the last evaluation
+  std::size_t _nRecomputed = 0;
+};
+
+#endif
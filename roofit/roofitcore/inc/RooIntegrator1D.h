@@ -19,6 +19,8 @@
 #include "RooAbsIntegrator.h"
 #include "RooNumIntConfig.h"
 
+#include <vector>
+
 class RooIntegrator1D : public RooAbsIntegrator {
 public:
 
@@ -67,11 +69,13 @@ protected:
   Double_t _epsAbs ;     // Absolute convergence tolerance
   Double_t _epsRel ;     // Relative convergence tolerance
   Bool_t _doExtrap ;     // Apply conversion step?
+  Bool_t _batchMode ;    // Evaluate all points of a refinement step in one batch?
   enum { _nPoints = 5 };
 
   // Numerical integrator support functions
   Double_t addTrapezoids(Int_t n) ;
   Double_t addMidpoints(Int_t n) ;
+  Double_t sumIntegrand() ;
   void extrapolate(Int_t n) ;
   
   // Numerical integrator workspace
@@ -89,6 +93,7 @@ protected:
   Double_t* xvec(Double_t& xx) { _x[0] = xx ; return _x ; }
 
   Double_t *_x ; //! do not persist
+  std::vector<double> _xBatch ; //! Points of the current refinement step in batch mode
 
   ClassDef(RooIntegrator1D,0) // 1-dimensional numerical integration engine
 };
@@ -28,6 +28,7 @@ class RooFitResult ;
 class RooPlot ;
 class RooRealVar ;
 class RooAbsMCStudyModule ;
+namespace RooFit { class BidirMMapPipe; }
 
 class RooMCStudy : public TNamed {
 public:
@@ -103,6 +104,9 @@ protected:
   RooPlot* makeFrameAndPlotCmd(const RooRealVar& param, RooLinkedList& cmdList, Bool_t symRange=kFALSE) const ;
 
   Bool_t run(Bool_t generate, Bool_t fit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) ;
+  Bool_t runInWorkers(Int_t nSamples, Int_t nEvtPerSample) ;
+  void workerLoop(RooFit::BidirMMapPipe& pipe, Int_t nEvtPerSample, UInt_t baseSeed) ;
+  RooAbsData* generateSample(Int_t nEvtPerSample, Int_t sampleNum) ;
   Bool_t fitSample(RooAbsData* genSample) ;
   RooFitResult* doFit(RooAbsData* genSample) ;	
 
@@ -142,6 +146,7 @@ protected:
   Bool_t      _verboseGen       ; // Verbose generation?
   Bool_t      _perExptGenParams ; // Do generation parameter change per event?
   Bool_t      _silence          ; // Silent running mode?
+  Int_t       _nWorkers         ; // Number of processes that generate and fit toys in parallel
 
   std::list<RooAbsMCStudyModule*> _modList ; // List of additional study modules ;
 
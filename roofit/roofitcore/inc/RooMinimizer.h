@@ -205,8 +205,9 @@ RooMinimizer::RooMinimizer(std::shared_ptr<RooFit::TestStatistics::RooAbsL> like
 // static function
 template <typename LikelihoodWrapperT, typename LikelihoodGradientWrapperT>
 std::unique_ptr<RooMinimizer> RooMinimizer::create(std::shared_ptr<RooFit::TestStatistics::RooAbsL> likelihood) {
-   return std::make_unique<RooMinimizer>(likelihood, static_cast<LikelihoodWrapperT*>(nullptr),
-                                         static_cast<LikelihoodGradientWrapperT*>(nullptr));
+   // the constructor is private, so std::make_unique cannot be used
+   return std::unique_ptr<RooMinimizer>(new RooMinimizer(likelihood, static_cast<LikelihoodWrapperT*>(nullptr),
+                                                         static_cast<LikelihoodGradientWrapperT*>(nullptr)));
 }
 
 #endif
@@ -23,9 +23,7 @@
 #include <utility>
 
 class RooRealSumPdf ;
-namespace RooBatchCompute {
-struct RunContext;
-}
+class RooFitDriver ;
 
 class RooNLLVar : public RooAbsOptTestStatistic {
 public:
@@ -64,7 +62,7 @@ public:
   using ComputeResult = std::pair<ROOT::Math::KahanSum<double>, double>;
 
   static RooNLLVar::ComputeResult computeBatchedFunc(const RooAbsPdf *pdfClone, RooAbsData *dataClone,
-                                                     std::unique_ptr<RooBatchCompute::RunContext> &evalData,
+                                                     std::unique_ptr<RooFitDriver> &driver,
                                                  RooArgSet *normSet, bool weightSq, std::size_t stepSize,
                                                  std::size_t firstEvent, std::size_t lastEvent);
   static RooNLLVar::ComputeResult computeScalarFunc(const RooAbsPdf *pdfClone, RooAbsData *dataClone, RooArgSet *normSet,
@@ -74,6 +72,7 @@ public:
 protected:
 
   virtual Bool_t processEmptyDataSets() const { return _extended ; }
+  virtual Bool_t setDataSlave(RooAbsData& data, Bool_t cloneData=kTRUE, Bool_t ownNewDataAnyway=kFALSE) ;
   virtual Double_t evaluatePartition(std::size_t firstEvent, std::size_t lastEvent, std::size_t stepSize) const;
 
   static RooArgSet _emptySet ; // Supports named argument constructor
@@ -90,7 +89,7 @@ private:
 
   mutable std::vector<Double_t> _binw ; //!
   mutable RooRealSumPdf* _binnedPdf{nullptr}; //!
-  mutable std::unique_ptr<RooBatchCompute::RunContext> _evalData; //! Struct to store function evaluation workspaces.
+  mutable std::unique_ptr<RooFitDriver> _driver; //! Drives batch evaluations and holds their workspaces.
    
   ClassDef(RooNLLVar,3) // Function representing (extended) -log(L) of p.d.f and dataset
 };
@@ -70,6 +70,9 @@ public:
   virtual ExtendMode extendMode() const ;
   virtual Double_t expectedEvents(const RooArgSet* nset) const ; 
 
+  virtual bool translate(RooCodeGenContext& ctx) const ;
+  virtual std::string translateExpectedEvents(RooCodeGenContext& ctx) const ;
+
   const RooArgList& pdfList() const { return _pdfList ; }
 
   virtual Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const;
@@ -59,6 +59,8 @@ public:
   virtual CacheMode canNodeBeCached() const { return RooAbsArg::NotAdvised ; } ;
   virtual void setCacheAndTrackHints(RooArgSet&) ;
 
+  virtual bool translate(RooCodeGenContext& ctx) const;
+
 protected:
 
   RooListProxy _compRSet ;
@@ -22,7 +22,9 @@
 #include "RooRealProxy.h"
 #include "RooSetProxy.h"
 #include "RooListProxy.h"
+#include <deque>
 #include <list>
+#include <vector>
 
 class RooArgSet ;
 class TH1F ;
@@ -71,6 +73,10 @@ public:
 
   static Int_t getCacheAllNumeric() ;
 
+  static void setNumericMemoSize(std::size_t n) ;
+
+  static std::size_t getNumericMemoSize() ;
+
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const {
     // Forward plot sampling hint of integrand
     return _function.arg().plotSamplingHint(obs,xlo,xhi) ;
@@ -135,10 +141,18 @@ protected:
   TNamed* _rangeName ; 
   
   mutable RooArgSet* _params ; //! cache for set of parameters
+  mutable RooArgSet* _branchNodes ; //! cache for the real-valued branch nodes of the integrand
 
   Bool_t _cacheNum ;           // Cache integral if numeric
   static Int_t _cacheAllNDim ; //! Cache all integrals with given numeric dimension
 
+  bool memoKey(std::vector<double>& key) const ;
+
+  using MemoEntry = std::pair<std::vector<double>,Double_t> ;
+  mutable std::deque<MemoEntry> _memo ; //! Results of the most recent numeric integrations, newest first
+  mutable std::vector<double> _memoKey ; //! Work space for the key of the current integration
+  static std::size_t _memoSize ; //! Number of numeric integration results remembered per integral
+
   ClassDef(RooRealIntegral,3) // Real-valued function representing an integral over a RooAbsReal object
 };
 
@@ -49,6 +49,8 @@ public:
   /// is the sum of all coefficients.
   virtual Double_t expectedEvents(const RooArgSet* nset) const ;
 
+  virtual bool translate(RooCodeGenContext& ctx) const;
+
   virtual Bool_t selfNormalized() const { return getAttribute("BinnedLikelihoodActive") ; }
 
   void printMetaArgs(std::ostream& os) const ;
@@ -0,0 +1,73 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_SHARED_VALUE_CACHE
+#define ROO_SHARED_VALUE_CACHE
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class RooAbsArg;
+class RooAbsReal;
+class RooArgSet;
+
+class RooSharedValueCache {
+public:
+  /// Number of evaluations that were served from the cache, and that needed a computation.
+  struct Statistics {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+  };
+
+  RooSharedValueCache() = default;
+  RooSharedValueCache(const RooSharedValueCache&) = delete;
+  RooSharedValueCache& operator=(const RooSharedValueCache&) = delete;
+  ~RooSharedValueCache();
+
+  static bool isEligible(const RooAbsReal& node, const RooArgSet& observables);
+  bool registerNode(RooAbsReal& node);
+  void clear();
+
+  double getValue(const RooAbsReal& node);
+
+  /// Number of distinct values that are shared.
+  std::size_t size() const { return _entries.size(); }
+  /// Total number of registered nodes.
+  std::size_t nNodes() const { return _nodes.size(); }
+  const Statistics& statistics() const { return _statistics; }
+  Statistics statistics(const char* name) const;
+  void printStatistics(std::ostream& os) const;
+
+private:
+  struct Entry {
+    std::string className;
+    std::vector<const RooAbsReal*> leaves; ///< Parameters that the value depends on, shared by all nodes
+    std::vector<double> leafValues;        ///< Values of the leaves at the last computation
+    double value = 0.;
+    bool valid = false;
+    std::vector<RooAbsReal*> nodes;
+    Statistics statistics;
+  };
+
+  std::map<std::string, std::unique_ptr<Entry>> _entries;
+  std::unordered_map<const RooAbsReal*, Entry*> _nodes;
+  Statistics _statistics;
+};
+
+#endif
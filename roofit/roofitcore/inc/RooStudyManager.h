@@ -26,6 +26,7 @@ class RooPlot ;
 class RooRealVar ;
 class RooWorkspace ;
 class RooAbsStudy ;
+namespace RooFit { class BidirMMapPipe; }
 #include "RooStudyPackage.h" 
 #include <list>
 #include <string>
@@ -45,6 +46,9 @@ public:
   void runProof(Int_t nExperiments, const char* proofHost="", Bool_t showGui=kTRUE) ;
   static void closeProof(Option_t *option = "s") ;
 
+  // Parallel running in local worker processes
+  Bool_t runLocal(Int_t nExperiments, Int_t nWorkers=0) ;
+
   // Batch running
   void prepareBatchInput(const char* studyName, Int_t nExpPerJob, Bool_t unifiedInput) ;
   void processBatchOutput(const char* filePat) ;
@@ -56,6 +60,7 @@ protected:
 
   void aggregateData(TList* olist) ;
   void expandWildCardSpec(const char* spec, std::list<std::string>& result) ;
+  void workerLoop(RooFit::BidirMMapPipe& pipe, UInt_t baseSeed, Int_t workerId) ;
 
   RooStudyPackage* _pkg ;
 
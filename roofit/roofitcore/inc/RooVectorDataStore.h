@@ -108,6 +108,11 @@ public:
   // Add rows 
   virtual void append(RooAbsDataStore& other) override;
 
+  // Add rows column by column, without loading them into the variables
+  Bool_t canAppendColumns() const;
+  void appendColumns(const std::vector<RooSpan<const double>>& columns);
+  void appendColumns(std::vector<std::vector<double>>&& columns);
+
   // General & bookkeeping methods
   virtual Int_t numEntries() const override { return static_cast<int>(size()); }
   virtual Double_t sumEntries() const override { return _sumWeight ; }
@@ -291,6 +296,19 @@ public:
       _vec.reserve(siz);
     }
 
+    /// Append `values`. If this vector is empty, the memory of `values` is taken over without copying.
+    void append(std::vector<double>&& values) {
+      if (_vec.empty()) {
+        _vec = std::move(values);
+      } else {
+        _vec.insert(_vec.end(), values.begin(), values.end());
+      }
+    }
+
+    void append(RooSpan<const double> values) {
+      _vec.insert(_vec.end(), values.begin(), values.end());
+    }
+
     const std::vector<double>& data() const {
       return _vec;
     }
@@ -633,6 +651,7 @@ public:
   std::vector<double> _weights;
 
   void setAllBuffersNative() ;
+  std::vector<RealVector*> columnTargets(std::size_t nColumns) const;
 
   Double_t _sumWeight ; 
   Double_t _sumWeightCarry;
@@ -134,6 +134,13 @@ public:
 
   Bool_t writeToFile(const char* fileName, Bool_t recreate=kTRUE) ;
 
+  /// When writing the workspace, store its datasets as separate keys next to it. They are then
+  /// only read from the file when they are accessed, see data() and allData().
+  void setLazyData(Bool_t flag) { _lazyDataWrite = flag ; }
+  Bool_t lazyData() const { return _lazyDataWrite ; }
+  /// Number of datasets that are still in the file from which the workspace was read.
+  Int_t numLazyData() const { return _lazyData.GetSize() ; }
+
   /// Make internal collection use an unordered_map for
   /// faster searching. Important when large trees are
   /// imported / or modified in the workspace.
@@ -253,6 +260,7 @@ public:
 
     Bool_t isValidCPPID(const char *name);
     void exportObj(TObject *obj);
+    RooAbsData *loadLazyData(const char *name = nullptr) const;
     void unExport();
 
     friend class CodeRepo;
@@ -274,6 +282,7 @@ public:
     RooLinkedList _genObjects;                   // List of generic objects
     RooLinkedList _studyMods;                    // List if StudyManager modules
     std::map<std::string, RooArgSet> _namedSets; // Map of named RooArgSets
+    RooLinkedList _lazyData;                     // Names (and key names as titles) of datasets stored next to the workspace
 
     WSDir *_dir; //! Transient ROOT directory representation of workspace
 
@@ -287,7 +296,10 @@ public:
     Bool_t _openTrans;       //! Is there a transaction open?
     RooArgSet _sandboxNodes; //! Sandbox for incoming objects in a transaction
 
-    ClassDef(RooWorkspace, 8) // Persistable project container for (composite) pdfs, functions, variables and datasets
+    Bool_t _lazyDataWrite = kFALSE; //! Write datasets as separate keys?
+    std::string _lazyDataFile;      //! File from which the lazy datasets are read
+
+    ClassDef(RooWorkspace, 9) // Persistable project container for (composite) pdfs, functions, variables and datasets
 } ;
 
 #endif
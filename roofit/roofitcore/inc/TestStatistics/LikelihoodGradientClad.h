@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOT_ROOFIT_TESTSTATISTICS_LikelihoodGradientClad
+#define ROOT_ROOFIT_TESTSTATISTICS_LikelihoodGradientClad
+
+#include <TestStatistics/LikelihoodGradientWrapper.h>
+
+#include "RooArgList.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RooFit {
+namespace TestStatistics {
+
+class LikelihoodGradientClad : public LikelihoodGradientWrapper {
+public:
+   /// Signature of the functions that are generated for the likelihood terms and of their gradients.
+   using Function = double (*)(double *params, double *obs);
+   using GradientFunction = void (*)(double *params, double *obs, double *grad);
+
+   LikelihoodGradientClad(std::shared_ptr<RooAbsL> likelihood,
+                          std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean, std::size_t N_dim,
+                          RooMinimizer *minimizer);
+   inline LikelihoodGradientClad *clone() const override { return new LikelihoodGradientClad(*this); }
+
+   void fillGradient(double *grad) override;
+
+   using LikelihoodGradientWrapper::synchronizeParameterSettings;
+   void synchronizeParameterSettings(ROOT::Math::IMultiGenFunction *function,
+                                     const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings) override;
+
+   /// The generated gradient is computed with respect to the RooFit parameters, so it needs Minuit-external values.
+   inline bool usesMinuitInternalValues() override { return false; }
+
+   double evaluate();
+   /// The code that was generated for the likelihood terms, for debugging.
+   inline const std::string &getCode() const { return code_; }
+
+private:
+   struct Term {
+      RooArgList parameters;
+      std::vector<double> params;
+      std::vector<double> obs; ///< Per-event values of the observables, filled once
+      Function function = nullptr;
+      GradientFunction gradient = nullptr;
+      std::vector<std::size_t> minuit_index; ///< Position of each parameter in the Minuit gradient
+   };
+
+   void addTerm(const RooAbsL &likelihood);
+   void jitTerm(Term &term, const std::string &name, const std::string &code);
+
+   std::vector<std::shared_ptr<Term>> terms_; ///< Shared between clones, the jitted code does not change
+   std::string code_;
+   std::size_t N_dim_;
+   std::vector<double> term_grad_;
+};
+
+} // namespace TestStatistics
+} // namespace RooFit
+
+#endif // ROOT_ROOFIT_TESTSTATISTICS_LikelihoodGradientClad
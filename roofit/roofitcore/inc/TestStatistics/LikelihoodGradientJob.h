@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOT_ROOFIT_TESTSTATISTICS_LikelihoodGradientJob
+#define ROOT_ROOFIT_TESTSTATISTICS_LikelihoodGradientJob
+
+#include <TestStatistics/LikelihoodGradientWrapper.h>
+#include <TestStatistics/LikelihoodWorkers.h>
+
+#include "Minuit2/NumericalDerivator.h"
+
+#include <memory>
+#include <vector>
+
+namespace RooFit {
+namespace TestStatistics {
+
+class LikelihoodGradientJob : public LikelihoodGradientWrapper {
+public:
+   LikelihoodGradientJob(std::shared_ptr<RooAbsL> likelihood,
+                         std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean, std::size_t N_dim,
+                         RooMinimizer *minimizer);
+   inline LikelihoodGradientJob *clone() const override { return new LikelihoodGradientJob(*this); }
+
+   void fillGradient(double *grad) override;
+
+   void synchronizeWithMinimizer(const ROOT::Math::MinimizerOptions &options) override;
+   using LikelihoodGradientWrapper::synchronizeParameterSettings;
+   void synchronizeParameterSettings(ROOT::Math::IMultiGenFunction *function,
+                                     const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings) override;
+   void updateMinuitInternalParameterValues(const std::vector<double> &minuit_internal_x) override;
+   void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt) override;
+
+   /// The NumericalDerivator works in Minuit-internal parameter space, like Minuit2 itself.
+   inline bool usesMinuitInternalValues() override { return true; }
+
+private:
+   std::shared_ptr<LikelihoodWorkers> workers_;
+   LikelihoodWorkers::DerivatorOptions options_;
+   std::vector<ROOT::Fit::ParameterSettings> parameter_settings_;
+   std::vector<double> minuit_internal_x_;
+   std::vector<ROOT::Minuit2::DerivatorElement> grad_;
+};
+
+} // namespace TestStatistics
+} // namespace RooFit
+
+#endif // ROOT_ROOFIT_TESTSTATISTICS_LikelihoodGradientJob
@@ -20,6 +20,7 @@
 #include <Fit/ParameterSettings.h>
 #include <Math/IFunctionfwd.h>
 #include "Math/MinimizerOptions.h"
+#include "RooAbsArg.h" // enum ConstOpCode
 
 #include <vector>
 #include <memory> // shared_ptr
@@ -50,6 +51,9 @@ public:
    /// but that the specific calculator does need. This function can be implemented to receive these Minuit-internal values.
    virtual void updateMinuitInternalParameterValues(const std::vector<double>& minuit_internal_x);
    virtual void updateMinuitExternalParameterValues(const std::vector<double>& minuit_external_x);
+   /// The likelihood itself is optimized through the LikelihoodWrapper; this function must be implemented by
+   /// calculators that work on copies of the likelihood, e.g. in other processes.
+   virtual void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt);
 
    /// \brief Implement usesMinuitInternalValues to return true when you want Minuit to send this class Minuit-internal values, or return false when you want "regular" Minuit-external values.
    ///
@@ -0,0 +1,47 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOT_ROOFIT_LikelihoodJob
+#define ROOT_ROOFIT_LikelihoodJob
+
+#include <TestStatistics/LikelihoodWrapper.h>
+
+#include "Math/Util.h" // KahanSum
+
+#include <memory>
+
+namespace RooFit {
+namespace TestStatistics {
+
+// forward declaration
+class LikelihoodWorkers;
+
+class LikelihoodJob : public LikelihoodWrapper {
+public:
+   LikelihoodJob(std::shared_ptr<RooAbsL> likelihood, std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean);
+   inline LikelihoodJob *clone() const override { return new LikelihoodJob(*this); }
+
+   void evaluate() override;
+   inline ROOT::Math::KahanSum<double> getResult() const override { return result; }
+   void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt) override;
+
+private:
+   ROOT::Math::KahanSum<double> result;
+   std::shared_ptr<LikelihoodWorkers> workers_;
+};
+
+}
+}
+
+#endif // ROOT_ROOFIT_LikelihoodJob
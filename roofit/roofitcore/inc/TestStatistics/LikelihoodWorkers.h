@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOT_ROOFIT_TESTSTATISTICS_LikelihoodWorkers
+#define ROOT_ROOFIT_TESTSTATISTICS_LikelihoodWorkers
+
+#include "RooAbsArg.h" // enum ConstOpCode
+#include "RooArgList.h"
+
+#include <Fit/ParameterSettings.h>
+#include "Math/Util.h" // KahanSum
+#include "Minuit2/NumericalDerivator.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace RooFit {
+
+// forward declaration
+class BidirMMapPipe;
+
+namespace TestStatistics {
+
+// forward declaration
+class RooAbsL;
+
+class LikelihoodWorkers {
+public:
+   /// Settings of the numerical derivative calculation, as derived from the Minuit strategy.
+   struct DerivatorOptions {
+      double step_tolerance = 0.5;
+      double grad_tolerance = 0.1;
+      unsigned int n_cycles = 2;
+      double error_level = 1;
+   };
+
+   static std::shared_ptr<LikelihoodWorkers> getInstance(const std::shared_ptr<RooAbsL> &likelihood);
+   static void setDefaultNWorkers(std::size_t n_workers);
+   static std::size_t getDefaultNWorkers();
+
+   LikelihoodWorkers(std::shared_ptr<RooAbsL> likelihood, std::size_t n_workers);
+   LikelihoodWorkers(const LikelihoodWorkers &) = delete;
+   LikelihoodWorkers &operator=(const LikelihoodWorkers &) = delete;
+   ~LikelihoodWorkers();
+
+   inline std::size_t getNWorkers() const { return n_workers_; }
+
+   ROOT::Math::KahanSum<double> evaluate();
+   void calculateGradient(const std::vector<double> &minuit_internal_x,
+                          const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings,
+                          const DerivatorOptions &options, std::vector<ROOT::Minuit2::DerivatorElement> &gradient);
+   void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt);
+
+private:
+   enum class Message : int { terminate, evaluate, gradient, constOptimize };
+
+   void start();
+   void terminate();
+   void workerLoop(std::size_t worker_id);
+   void sendParameterValues(BidirMMapPipe &pipe) const;
+   void sendConstOptimizations(BidirMMapPipe &pipe) const;
+   void receiveParameterValues(BidirMMapPipe &pipe);
+   std::size_t collectEvalErrors(BidirMMapPipe &pipe) const;
+   ROOT::Math::KahanSum<double> evaluatePartition(std::size_t worker_id, std::size_t n_workers);
+   void calculatePartialDerivatives(std::size_t worker_id, std::size_t n_workers, const std::vector<double> &minuit_internal_x,
+                                    const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings,
+                                    const std::vector<std::size_t> &parameter_indices, const DerivatorOptions &options,
+                                    std::vector<ROOT::Minuit2::DerivatorElement> &gradient);
+
+   std::shared_ptr<RooAbsL> likelihood_;
+   RooArgList parameters_; ///< All parameters of the likelihood; the same objects live on in the forked workers
+   std::size_t n_workers_;
+   std::vector<std::unique_ptr<BidirMMapPipe>> pipes_;
+   /// Constant term optimizations to be sent to the running workers with the next request
+   std::vector<std::pair<RooAbsArg::ConstOpCode, bool>> pending_const_optimizations_;
+};
+
+} // namespace TestStatistics
+} // namespace RooFit
+
+#endif // ROOT_ROOFIT_TESTSTATISTICS_LikelihoodWorkers
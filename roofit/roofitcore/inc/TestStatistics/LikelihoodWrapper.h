@@ -79,7 +79,7 @@ public:
    virtual void updateMinuitExternalParameterValues(const std::vector<double>& minuit_external_x);
 
    // The following functions are necessary from MinuitFcnGrad to reach likelihood properties:
-   void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt);
+   virtual void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt);
    double defaultErrorLevel() const;
    virtual std::string GetName() const;
    virtual std::string GetTitle() const;
@@ -74,6 +74,7 @@ public:
    inline void setOptimizeConstOnFunction(RooAbsArg::ConstOpCode opcode, Bool_t doAlsoTrackingOpt) override
    {
       likelihood->constOptimizeTestStatistic(opcode, doAlsoTrackingOpt);
+      gradient->constOptimizeTestStatistic(opcode, doAlsoTrackingOpt);
    }
 
 private:
@@ -122,6 +122,12 @@ public:
    inline std::size_t getNComponents() const { return N_components_; }
    inline bool isExtended() const { return extended_; }
    inline void setSimCount(std::size_t value) { sim_count_ = value; }
+   inline std::size_t getSimCount() const { return sim_count_; }
+
+   // necessary in LikelihoodGradientClad to translate the likelihood
+   inline RooAbsPdf *getPdf() const { return pdf_.get(); }
+   inline RooAbsData *getData() const { return data_.get(); }
+   inline const RooArgSet *getNormSet() const { return normSet_.get(); }
 
 protected:
    // Note: pdf_ and data_ can be constructed in two ways, one of which implies ownership and the other does not.
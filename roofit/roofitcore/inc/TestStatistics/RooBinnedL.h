@@ -19,6 +19,7 @@
 
 #include <TestStatistics/RooAbsL.h>
 #include "RooAbsReal.h"
+#include <memory>
 #include <vector>
 
 // forward declarations
@@ -33,10 +34,23 @@ public:
    RooBinnedL(RooAbsPdf *pdf, RooAbsData *data);
    ROOT::Math::KahanSum<double>
    evaluatePartition(Section bins, std::size_t components_begin, std::size_t components_end) override;
+   inline const std::vector<double> &getBinWidths() const { return _binw; }
+   /// Whether only the non-empty bins are evaluated, see the class documentation.
+   inline bool usesSparseBins() const { return _totalYield != nullptr; }
 
 private:
+   void initSparseBins(const RooArgSet &observables);
+   ROOT::Math::KahanSum<double> evaluateSparse(Section bins);
+
    mutable bool _first = true;        //!
    mutable std::vector<double> _binw; //!
+
+   // Sparse evaluation, only used when the model's integral is analytic and many bins are empty
+   std::unique_ptr<RooAbsReal> _totalYield; //! Integral of the model over all bins
+   std::vector<std::size_t> _nonEmptyBins;  //! Indices of the bins with non-zero weight, sorted
+   std::vector<double> _nonEmptyWeights;    //! Weights of these bins
+   std::vector<double> _lnGammaWeights;     //! log(Gamma(N+1)) of these weights
+   std::vector<double> _terms;              //! Per-bin terms of the current evaluation
 };
 
 } // namespace TestStatistics
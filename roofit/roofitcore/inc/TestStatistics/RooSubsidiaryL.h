@@ -49,6 +49,9 @@ public:
 
    void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt) override;
 
+   inline const RooArgList &getSubsidiaryPdfs() const { return subsidiary_pdfs_; }
+   inline const RooArgSet &getParameterSet() const { return parameter_set_; }
+
 private:
    std::string parent_pdf_name_;
    RooArgList subsidiary_pdfs_{"subsidiary_pdfs"}; // Set of subsidiary PDF or "constraint" terms
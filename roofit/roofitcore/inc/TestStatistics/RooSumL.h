@@ -42,6 +42,9 @@ public:
 
    void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt) override;
 
+   // necessary in LikelihoodWorkers to find the components without events
+   inline const RooAbsL &getComponent(std::size_t ix) const { return *components_[ix]; }
+
 private:
    std::vector<std::unique_ptr<RooAbsL>> components_;
 };
@@ -23,9 +23,7 @@
 class RooAbsPdf;
 class RooAbsData;
 class RooArgSet;
-namespace RooBatchCompute {
-struct RunContext;
-}
+class RooFitDriver;
 
 namespace RooFit {
 namespace TestStatistics {
@@ -36,6 +34,7 @@ public:
                 bool useBatchedEvaluations = false);
    RooUnbinnedL(const RooUnbinnedL &other);
    bool setApplyWeightSquared(bool flag);
+   inline bool applyWeightSquared() const { return apply_weight_squared; }
 
    ROOT::Math::KahanSum<double>
    evaluatePartition(Section events, std::size_t components_begin, std::size_t components_end) override;
@@ -45,7 +44,7 @@ private:
    bool apply_weight_squared = false;                              // Apply weights squared?
    mutable bool _first = true;                                     //!
    bool useBatchedEvaluations_ = false;
-   mutable std::unique_ptr<RooBatchCompute::RunContext> evalData_; //! Struct to store function evaluation workspaces.
+   mutable std::unique_ptr<RooFitDriver> driver_;                  //! Drives batch evaluations and holds their workspaces.
 };
 
 } // namespace TestStatistics
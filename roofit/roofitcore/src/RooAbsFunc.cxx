@@ -32,12 +32,40 @@ the getMinLimit() and getMaxLimit() methods.
 
 #include "RooAbsFunc.h"
 
+#include <algorithm>
+
 using namespace std;
 
 ClassImp(RooAbsFunc);
 ;
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function at all points given in `coordinates`. The ordinal position
+/// in the vector corresponds to the dimension of the function. Spans of size 1 are
+/// broadcast to all points. This default implementation calls operator() for every
+/// point. Bindings that can compute many points at once, like RooRealBinding, override it.
+/// \return Span with one function value per point. It is valid until the next call.
+RooSpan<const double> RooAbsFunc::getValues(std::vector<RooSpan<const double>> coordinates) const
+{
+  std::size_t nPoints = 0;
+  for (const auto& coord : coordinates) {
+    nPoints = std::max(nPoints, coord.size());
+  }
+
+  std::vector<double> x(_dimension);
+  _batchValues.resize(nPoints);
+  for (std::size_t i = 0; i < nPoints; ++i) {
+    for (unsigned int dim = 0; dim < _dimension; ++dim) {
+      x[dim] = coordinates[dim].size() == 1 ? coordinates[dim][0] : coordinates[dim][i];
+    }
+    _batchValues[i] = (*this)(x.data());
+  }
+
+  return {_batchValues};
+}
+
+
 
 
 
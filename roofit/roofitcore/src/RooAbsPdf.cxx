@@ -3241,6 +3241,18 @@ Double_t RooAbsPdf::expectedEvents(const RooArgSet*) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate C++ code for the expected number of events with the observables in
+/// RooCodeGenContext::normSet(). This is the code generation equivalent of expectedEvents().
+/// \return The expression for the number of events, or an empty string if code generation is not supported.
+
+std::string RooAbsPdf::translateExpectedEvents(RooCodeGenContext& /*ctx*/) const
+{
+  return "";
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change global level of verbosity for p.d.f. evaluations
 
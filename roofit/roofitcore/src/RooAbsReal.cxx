@@ -83,6 +83,7 @@
 #include "RooCachedReal.h"
 #include "RooHelpers.h"
 #include "RunContext.h"
+#include "RooSharedValueCache.h"
 #include "ValueChecking.h"
 
 #include "ROOT/StringUtils.hxx"
@@ -280,7 +281,7 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
   }
 
   if (isValueDirtyAndClear()) {
-    _value = traceEval(nullptr) ;
+    _value = _sharedValueCache ? _sharedValueCache->getValue(*this) : traceEval(nullptr) ;
     //     clearValueDirty() ;
   }
   //   cout << "RooAbsReal::getValV(" << GetName() << ") writing _value = " << _value << endl ;
@@ -434,6 +435,32 @@ Double_t RooAbsReal::analyticalIntegral(Int_t code, const char* /*rangeName*/) c
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate C++ code that computes the value of this object, for compiling and
+/// differentiating the likelihood with Clad. Implementations retrieve the expressions
+/// for the values of their servers with RooCodeGenContext::getResult(), and register
+/// their own value with RooCodeGenContext::addResult(). PDFs generate code for their
+/// unnormalised values, like in evaluate().
+/// \return False if code generation is not supported, which is the default.
+
+bool RooAbsReal::translate(RooCodeGenContext& /*ctx*/) const
+{
+  return false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate C++ code for the analytical integral with the given code, as returned by
+/// getAnalyticalIntegral(). This is the code generation equivalent of analyticalIntegral().
+/// \return The expression for the integral, or an empty string if code generation is not supported.
+
+std::string RooAbsReal::translateAnalyticalIntegral(Int_t /*code*/, const char* /*rangeName*/, RooCodeGenContext& /*ctx*/) const
+{
+  return "";
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the label associated with the variable
 
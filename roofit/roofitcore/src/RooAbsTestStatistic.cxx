@@ -49,6 +49,8 @@ combined in the main thread.
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
 #include "RooAbsCategoryLValue.h"
+#include "RooAbsOptTestStatistic.h"
+#include "RooSharedValueCache.h"
 
 #include "TTimeStamp.h"
 #include "TClass.h"
@@ -159,6 +161,9 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _mpfeArray ;
   }
 
+  // The shared values refer to the nodes of the sub-contexts
+  delete _sharedValueCache ;
+
   if (SimMaster == _gofOpMode && _init) {
     for (Int_t i = 0; i < _nGof; ++i) delete _gofArray[i];
     delete[] _gofArray ;
@@ -583,6 +588,82 @@ void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
 
   dsetList->Delete(); // delete the content.
   delete dsetList;
+
+  if (shareValuesBetweenChannels()) {
+    initSharedValueCache() ;
+  }
+}
+
+
+namespace {
+  Bool_t& shareValuesBetweenChannelsFlag() {
+    static Bool_t flag = kTRUE ;
+    return flag ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// If enabled, which is the default, the functions of the parameters that are used in several channels
+/// of a RooSimultaneous are only evaluated once per parameter change, and not once per channel.
+/// See RooSharedValueCache. Only test statistics that are created afterwards are affected.
+
+void RooAbsTestStatistic::setShareValuesBetweenChannels(Bool_t flag)
+{
+  shareValuesBetweenChannelsFlag() = flag ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check whether the values of functions are shared between channels, see setShareValuesBetweenChannels().
+
+Bool_t RooAbsTestStatistic::shareValuesBetweenChannels()
+{
+  return shareValuesBetweenChannelsFlag() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register all functions that appear in the models of more than one sub-context with a RooSharedValueCache,
+/// such that they are only recomputed if one of their parameters changed, instead of once per channel.
+
+void RooAbsTestStatistic::initSharedValueCache()
+{
+  delete _sharedValueCache ;
+  _sharedValueCache = nullptr ;
+  if (_nGof < 2) return ;
+
+  std::vector<RooAbsReal*> candidates ;
+  std::map<std::string,Int_t> nChannels ;
+  for (Int_t i = 0; i < _nGof; ++i) {
+    auto gof = dynamic_cast<RooAbsOptTestStatistic*>(_gofArray[i]) ;
+    if (!gof) continue ;
+    RooArgSet branches ;
+    gof->function().branchNodeServerList(&branches) ;
+    for (const auto arg : branches) {
+      auto real = dynamic_cast<RooAbsReal*>(arg) ;
+      if (real && RooSharedValueCache::isEligible(*real, *gof->data().get())) {
+        candidates.push_back(real) ;
+        ++nChannels[real->GetName()] ;
+      }
+    }
+  }
+
+  _sharedValueCache = new RooSharedValueCache ;
+  for (auto real : candidates) {
+    if (nChannels[real->GetName()] > 1) {
+      _sharedValueCache->registerNode(*real) ;
+    }
+  }
+
+  if (_sharedValueCache->nNodes() == 0) {
+    delete _sharedValueCache ;
+    _sharedValueCache = nullptr ;
+    return ;
+  }
+
+  coutI(Optimization) << "RooAbsTestStatistic::initSimMode(" << GetName() << ") values of " << _sharedValueCache->size()
+                      << " functions are shared between " << _sharedValueCache->nNodes() << " nodes of the channels" << endl ;
 }
 
 
@@ -75,6 +75,7 @@ An (enforced) condition for this assumption is that each \f$ \mathrm{PDF}_i \f$
 #include "RooRealIntegral.h"
 #include "RooNaNPacker.h"
 #include "RooBatchCompute.h"
+#include "RooCodeGenContext.h"
 
 #include <algorithm>
 #include <memory>
@@ -790,29 +791,27 @@ RooSpan<double> RooAddPdf::evaluateSpan(RooBatchCompute::RunContext& evalData, c
   const RooArgSet* nset = normAndCache.first;
   CacheElem* cache = normAndCache.second;
 
-  RooSpan<double> output;
+  std::vector<RooSpan<const double>> pdfOutputs;
+  std::vector<double> coefs;
+  std::size_t batchSize = 0;
 
   for (unsigned int pdfNo = 0; pdfNo < _pdfList.size(); ++pdfNo) {
     const auto& pdf = static_cast<RooAbsPdf&>(_pdfList[pdfNo]);
-    auto pdfOutputs = pdf.getValues(evalData, nset);
-    if (output.empty() || (output.size() == 1 && pdfOutputs.size() > 1)) {
-      const double init = output.empty() ? 0. : output[0];
-      output = evalData.makeBatch(this, pdfOutputs.size());
-      std::fill(output.begin(), output.end(), init);
-    }
-    assert(output.size() == pdfOutputs.size());
-
-    const double coef = _coefCache[pdfNo] / (cache->_needSupNorm ?
-        static_cast<RooAbsReal*>(cache->_suppNormList.at(pdfNo))->getVal() :
-        1.);
+    auto values = pdf.getValues(evalData, nset);
+    assert(batchSize <= 1 || values.size() <= 1 || values.size() == batchSize);
+    batchSize = std::max(batchSize, values.size());
 
     if (pdf.isSelectedComp()) {
-      for (std::size_t i = 0; i < output.size(); ++i) { //CHECK_VECTORISE
-        output[i] += pdfOutputs[i] * coef;
-      }
+      pdfOutputs.push_back(values);
+      coefs.push_back(_coefCache[pdfNo] / (cache->_needSupNorm ?
+          static_cast<RooAbsReal*>(cache->_suppNormList.at(pdfNo))->getVal() :
+          1.));
     }
   }
 
+  RooSpan<double> output = evalData.makeBatch(this, batchSize);
+  RooBatchCompute::dispatch->computeCoefficientSum(batchSize, output.data(), pdfOutputs, coefs);
+
   return output;
 }
 
@@ -1021,6 +1020,91 @@ Double_t RooAddPdf::expectedEvents(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the sum of the normalised component PDFs. Coefficients are
+/// interpreted like in updateCoefficients(). Recursive fractions, and coefficients
+/// that need to be projected to a different range or set of observables, are not supported.
+
+bool RooAddPdf::translate(RooCodeGenContext& ctx) const
+{
+  if (_recursive || _refCoefRangeName || normRange()) {
+    return ctx.fail(*this, "recursive fractions and coefficient ranges are not supported");
+  }
+
+  std::unique_ptr<RooArgSet> normObs{getObservables(ctx.normSet())};
+  if (!_refCoefNorm.empty() && !_refCoefNorm.equals(*normObs)) {
+    return ctx.fail(*this, "projection of coefficients is not supported");
+  }
+  for (const auto arg : _pdfList) {
+    std::unique_ptr<RooArgSet> compObs{arg->getObservables(ctx.normSet())};
+    if (!compObs->equals(*normObs)) {
+      return ctx.fail(*this, "components with different observables are not supported");
+    }
+  }
+
+  std::vector<std::string> coefs;
+  if (_allExtendable) {
+    for (const auto arg : _pdfList) {
+      coefs.push_back(static_cast<const RooAbsPdf*>(arg)->translateExpectedEvents(ctx));
+      if (coefs.back().empty()) {
+        return ctx.fail(*arg, "no code generation for the expected number of events");
+      }
+    }
+  } else {
+    for (const auto arg : _coefList) {
+      coefs.push_back(ctx.getResult(*arg));
+    }
+  }
+
+  std::string coefSum;
+  for (const auto& coef : coefs) {
+    coefSum += (coefSum.empty() ? "" : " + ") + coef;
+  }
+  if (_allExtendable || _haveLastCoef) {
+    for (auto& coef : coefs) {
+      coef += " / (" + coefSum + ")";
+    }
+  } else {
+    coefs.push_back("(1. - (" + coefSum + "))");
+  }
+
+  std::string result;
+  for (std::size_t i = 0; i < _pdfList.size(); ++i) {
+    const auto& pdf = static_cast<const RooAbsPdf&>(_pdfList[i]);
+    result += (result.empty() ? "" : " + ") + coefs[i] + " * " + ctx.getNormalizedResult(pdf);
+  }
+  ctx.addResult(this, result);
+  return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the expected number of events, see expectedEvents().
+
+std::string RooAddPdf::translateExpectedEvents(RooCodeGenContext& ctx) const
+{
+  if (_refCoefRangeName || !(_allExtendable || _haveLastCoef)) {
+    return "";
+  }
+
+  std::string expectedTotal;
+  if (_allExtendable) {
+    for (const auto arg : _pdfList) {
+      const std::string nComp = static_cast<const RooAbsPdf*>(arg)->translateExpectedEvents(ctx);
+      if (nComp.empty()) {
+        return "";
+      }
+      expectedTotal += (expectedTotal.empty() ? "" : " + ") + nComp;
+    }
+  } else {
+    for (const auto arg : _coefList) {
+      expectedTotal += (expectedTotal.empty() ? "" : " + ") + ctx.getResult(*arg);
+    }
+  }
+  return expectedTotal;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface function used by test statistics to freeze choice of observables
 /// for interpretation of fraction coefficients
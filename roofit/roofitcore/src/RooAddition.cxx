@@ -37,6 +37,7 @@ in the two sets.
 #include "RooNLLVar.h"
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
+#include "RooCodeGenContext.h"
 
 #include <algorithm>
 #include <cmath>
@@ -179,6 +180,20 @@ Double_t RooAddition::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the sum of all terms.
+
+bool RooAddition::translate(RooCodeGenContext& ctx) const
+{
+  std::string result;
+  for (const auto arg : _set) {
+    result += (result.empty() ? "" : " + ") + ctx.getResult(*arg);
+  }
+  ctx.addResult(this, result.empty() ? "0." : result);
+  return true;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the default error level for MINUIT error analysis
 /// If the addition contains one or more RooNLLVars and 
@@ -0,0 +1,292 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file RooCodeGenContext.cxx
+\class RooCodeGenContext
+\ingroup Roofitcore
+
+Collects the C++ code that computes the value of a RooFit computation graph, such that the code can be
+compiled by the interpreter and differentiated by Clad.
+
+The generated code is the body of a function with the signature
+~~~{.cpp}
+double func(double* params, double* obs);
+~~~
+`params` holds the values of the parameters() of the graph, and `obs` holds `numColumns()` values for each of the
+`nEvents` events of the dataset, stored column by column. The code that the context collects is split into
+globalCode(), which only depends on the parameters, and loopCode(), which needs to run for every event inside a
+loop `for (int i = 0; i < nEvents; ++i)`.
+
+Objects of the graph are translated by getResult():
+- Parameters become `params[<index>]`.
+- Objects that don't depend on any parameter are evaluated by RooFit. If they depend on the observables, their values
+  are stored in a column of `obs`, otherwise they become constants. This covers the observables themselves, but also
+  e.g. histograms of the observables, which never need to be differentiated.
+- All other objects are asked to translate themselves with RooAbsReal::translate(). They get the expressions for their
+  servers from getResult(), and register their own result with addResult(). PDFs that are normalised over the
+  observables in normSet() are requested using getNormalizedResult(), which divides by the analytical integral
+  generated by RooAbsReal::translateAnalyticalIntegral().
+
+If an object cannot be translated, the context remembers the reason in failure(), and the generated code must not be
+used.
+**/
+
+#include "RooCodeGenContext.h"
+
+#include "RooAbsCategory.h"
+#include "RooAbsPdf.h"
+#include "RooAbsReal.h"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a context for translating a computation graph.
+/// \param[in] name Name of the function to be generated. Used to name auxiliary declarations.
+/// \param[in] observables Observables that change from event to event. Their values are read from `obs`.
+/// \param[in] normSet Observables to normalise PDFs over.
+/// \param[in] parameters Parameters of the graph. Their values are read from `params` in this order.
+RooCodeGenContext::RooCodeGenContext(const std::string& name, const RooArgSet& observables, const RooArgSet& normSet,
+                                     const RooArgList& parameters)
+    : _name{name}, _parameters{parameters}
+{
+  _observables.add(observables);
+  _normSet.add(normSet);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the expression for the value of `arg`, translating it and its servers if needed.
+/// PDFs are not normalised, see getNormalizedResult().
+const std::string& RooCodeGenContext::getResult(const RooAbsArg& arg)
+{
+  auto found = _results.find(&arg);
+  if (found != _results.end()) {
+    return found->second;
+  }
+
+  const int idx = parameterIndex(arg);
+  if (idx >= 0) {
+    return _results[&arg] = "params[" + std::to_string(idx) + "]";
+  }
+
+  const bool isDataOnly = !arg.dependsOnValue(_parameters);
+
+  if (auto category = dynamic_cast<const RooAbsCategory*>(&arg)) {
+    if (!isDataOnly) {
+      fail(arg, "categories that depend on parameters are not supported");
+      return _results[&arg] = "0.";
+    }
+    return _results[&arg] = dependsOnEvent(arg)
+                                ? addColumn([category]() { return static_cast<double>(category->getCurrentIndex()); })
+                                : literal(category->getCurrentIndex());
+  }
+
+  auto real = dynamic_cast<const RooAbsReal*>(&arg);
+  if (!real) {
+    fail(arg, "only real-valued objects and categories are supported");
+    return _results[&arg] = "0.";
+  }
+
+  if (isDataOnly) {
+    return _results[&arg] = dependsOnEvent(arg) ? addColumn([real]() { return real->getVal(); })
+                                                : literal(real->getVal());
+  }
+
+  if (!real->translate(*this) || _results.find(&arg) == _results.end()) {
+    fail(arg, "no code generation implemented for " + std::string(arg.ClassName()));
+    return _results[&arg] = "0.";
+  }
+
+  return _results[&arg];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the expression for the value of `pdf`, normalised over the observables in normSet().
+/// If the PDF is not self-normalised, its analytical integral over these observables is used.
+std::string RooCodeGenContext::getNormalizedResult(const RooAbsPdf& pdf)
+{
+  auto found = _normalizedResults.find(&pdf);
+  if (found != _normalizedResults.end()) {
+    return found->second;
+  }
+
+  std::unique_ptr<RooArgSet> normObs{pdf.getObservables(_normSet)};
+
+  if (!pdf.dependsOnValue(_parameters)) {
+    const RooArgSet* normSet = &_normSet;
+    return _normalizedResults[&pdf] = dependsOnEvent(pdf) ? addColumn([&pdf, normSet]() { return pdf.getVal(normSet); })
+                                                          : literal(pdf.getVal(normSet));
+  }
+
+  const std::string& value = getResult(pdf);
+  if (normObs->empty() || pdf.selfNormalized()) {
+    return _normalizedResults[&pdf] = value;
+  }
+
+  RooArgSet allVars{*normObs};
+  RooArgSet analVars;
+  const Int_t code = pdf.getAnalyticalIntegralWN(allVars, analVars, nullptr, nullptr);
+  std::string integral;
+  if (code != 0 && analVars.size() == normObs->size()) {
+    integral = pdf.translateAnalyticalIntegral(code, nullptr, *this);
+  }
+  if (integral.empty()) {
+    fail(pdf, "no analytical integral over the normalisation set available for " + std::string(pdf.ClassName()));
+    return _normalizedResults[&pdf] = value;
+  }
+
+  // The integral only needs to be computed once, unless the PDF is conditional on observables that are not integrated
+  RooArgSet conditionalObs;
+  for (const auto obs : _observables) {
+    if (!normObs->find(*obs)) {
+      conditionalObs.add(*obs);
+    }
+  }
+  const std::string norm = declare(!conditionalObs.empty() && pdf.dependsOnValue(conditionalObs), integral);
+
+  return _normalizedResults[&pdf] = declare(dependsOnEvent(pdf), value + " / " + norm);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the result of the translation of `owner`. The expression is stored in a temporary variable, which is
+/// declared inside or outside of the event loop, depending on whether `owner` depends on the observables.
+void RooCodeGenContext::addResult(const RooAbsArg* owner, const std::string& expression)
+{
+  _results[owner] = declare(dependsOnEvent(*owner), expression);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add statements that are needed to compute the result of `owner`, e.g. if the result is accumulated in
+/// a variable obtained from getTmpVarName().
+void RooCodeGenContext::addToCodeBody(const RooAbsArg* owner, const std::string& code)
+{
+  (dependsOnEvent(*owner) ? _loopCode : _globalCode) += code + "\n";
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new unique name for a temporary variable.
+std::string RooCodeGenContext::getTmpVarName()
+{
+  return "t" + std::to_string(_tmpVarCounter++);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Request a column of per-event values. The function `fill` is called for every event of the dataset after the
+/// values of the observables have been loaded.
+/// \return The expression for the value in the current event. It can only be used inside the event loop.
+std::string RooCodeGenContext::addColumn(std::function<double()> fill)
+{
+  _columns.push_back(std::move(fill));
+  return "obs[" + std::to_string(_columns.size() - 1) + " * nEvents + i]";
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare a constant array of integers, e.g. for mapping bin numbers to parameter indices.
+/// \return The name of the array.
+std::string RooCodeGenContext::addIntArray(const std::vector<int>& values)
+{
+  const std::string arrayName = _name + "_" + getTmpVarName();
+  std::ostringstream os;
+  os << "static const int " << arrayName << "[] = {";
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    os << (i == 0 ? "" : ", ") << values[i];
+  }
+  os << "};\n";
+  _declarations += os.str();
+  return arrayName;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of `arg` in the `params` array, or -1 if it is not a parameter.
+int RooCodeGenContext::parameterIndex(const RooAbsArg& arg) const
+{
+  return _parameters.index(&arg);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mark the translation as failed. Only the first reason is kept.
+/// \return Always false, such that translate() implementations can `return ctx.fail(*this, "...")`.
+bool RooCodeGenContext::fail(const RooAbsArg& arg, const std::string& reason)
+{
+  if (_failure.empty()) {
+    _failure = std::string(arg.GetName()) + ": " + reason;
+  }
+  return false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the values of all columns for the current event.
+/// \param[out] output Location of the first column for the current event.
+/// \param[in] stride Distance between the columns, i.e. the number of events.
+void RooCodeGenContext::fillColumns(double* output, std::size_t stride) const
+{
+  for (std::size_t i = 0; i < _columns.size(); ++i) {
+    output[i * stride] = _columns[i]();
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a C++ literal that reproduces `value` exactly.
+std::string RooCodeGenContext::literal(double value)
+{
+  if (std::isnan(value)) {
+    return "std::numeric_limits<double>::quiet_NaN()";
+  }
+  if (std::isinf(value)) {
+    return value > 0. ? "std::numeric_limits<double>::infinity()" : "(-std::numeric_limits<double>::infinity())";
+  }
+
+  std::ostringstream os;
+  os << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+  std::string result = os.str();
+  if (result.find_first_of(".e") == std::string::npos) {
+    result += ".";
+  }
+  return value < 0. ? "(" + result + ")" : result;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check whether the value of `arg` changes from event to event.
+bool RooCodeGenContext::dependsOnEvent(const RooAbsArg& arg) const
+{
+  return !_observables.empty() && arg.dependsOnValue(_observables);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store `expression` in a new temporary variable.
+/// \return The name of the variable.
+std::string RooCodeGenContext::declare(bool inLoop, const std::string& expression)
+{
+  const std::string tmp = getTmpVarName();
+  (inLoop ? _loopCode : _globalCode) += "const double " + tmp + " = " + expression + ";\n";
+  return tmp;
+}
@@ -56,6 +56,7 @@ See RooAbsData::plotOn().
 #include "RooPlot.h"
 #include "RooHistError.h"
 #include "RooCategory.h"
+#include "RooBatchCompute.h"
 #include "RooCmdConfig.h"
 #include "RooLinkedListIter.h"
 #include "RooTreeDataStore.h"
@@ -1112,6 +1113,58 @@ double RooDataHist::weightFast(const RooArgSet& bin, Int_t intOrder, Bool_t corr
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Look up the weights for a batch of coordinates, using the RooBatchCompute library.
+/// This is the batched version of weightFast(), which it reproduces for interpolation orders 0 and 1.
+/// \param[out] output Receives one weight per event.
+/// \param[in] bin Observables with the same layout as the variables of this histogram. For categories, and for real
+/// observables without coordinates, the current values are used.
+/// \param[in] coordinates Values of the real observables, one span per observable in `bin`. Spans may be empty or
+/// have a single element, which is used for all events.
+/// \param[in] intOrder Interpolation order. Only 0 and, for histograms with a single real observable, 1 are supported.
+/// \param[in] correctForBinSize Divide the weights by the bin volumes.
+/// \param[in] cdfBoundaries See weight().
+/// \param[in] binContents Use these values instead of the weights of the histogram, indexed like weight(std::size_t).
+/// \return False if the combination of arguments is not supported. Nothing was computed in that case, and the caller
+/// should fall back to weightFast().
+bool RooDataHist::weights(RooSpan<double> output, const RooAbsCollection& bin,
+                          const std::vector<RooSpan<const double>>& coordinates, int intOrder,
+                          bool correctForBinSize, bool cdfBoundaries, const double* binContents)
+{
+  checkInit() ;
+
+  if (intOrder < 0 || intOrder > 1 || (intOrder == 1 && getVarInfo().nRealVars != 1)) {
+    return false;
+  }
+  assert(bin.size() == _vars.size() && coordinates.size() == _vars.size());
+
+  std::vector<RooBatchCompute::HistogramAxis> axes(_vars.size());
+  for (unsigned int i=0; i < _vars.size(); ++i) {
+    auto& axis = axes[i];
+    axis.stride = _idxMult[i];
+    const RooAbsBinning* binning = _lvbins[i].get();
+    if (!binning) {
+      axis.fixedBin = static_cast<const RooAbsCategoryLValue*>(bin[i])->getBin(static_cast<const char*>(nullptr));
+      continue;
+    }
+
+    axis.nBins = binning->numBins();
+    axis.xmin = binning->lowBound();
+    axis.xmax = binning->highBound();
+    axis.boundaries = binning->isUniform() ? nullptr : binning->array();
+    if (coordinates[i].empty()) {
+      axis.fixedBin = binning->binNumber(static_cast<const RooAbsReal*>(bin[i])->getVal());
+    } else {
+      axis.values = coordinates[i];
+    }
+  }
+
+  RooBatchCompute::dispatch->computeHistogram(output.size(), output.data(), axes, binContents ? binContents : _wgt,
+                                              correctForBinSize ? _binv : nullptr, intOrder, cdfBoundaries);
+  return true;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the weight at given coordinates with optional interpolation.
 /// \param[in] bin Coordinates for which the weight should be calculated.
@@ -44,6 +44,7 @@ the nominal integration range \f$ \mathrm{normRegion}[x] \f$.
 #include "RooFormulaVar.h"
 #include "RooNameReg.h"
 #include "RooMsgService.h"
+#include "RooCodeGenContext.h"
 
 
 
@@ -154,3 +155,37 @@ Double_t RooExtendPdf::expectedEvents(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the value of the input p.d.f, which is normalised like
+/// evaluate(). Extension to a sub range is not supported.
+
+bool RooExtendPdf::translate(RooCodeGenContext& ctx) const
+{
+  if (_rangeName) {
+    return ctx.fail(*this, "extension in a sub range is not supported") ;
+  }
+  ctx.addResult(this, ctx.getNormalizedResult(*_pdf)) ;
+  return true ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the expected number of events, see expectedEvents().
+
+std::string RooExtendPdf::translateExpectedEvents(RooCodeGenContext& ctx) const
+{
+  if (_rangeName) {
+    return "" ;
+  }
+
+  std::string nExp = ctx.getResult(_n.arg()) ;
+  if (_pdf->canBeExtended()) {
+    const std::string pdfExp = _pdf->translateExpectedEvents(ctx) ;
+    if (pdfExp.empty()) {
+      return "" ;
+    }
+    nExp += " * " + pdfExp ;
+  }
+  return nExp ;
+}
@@ -0,0 +1,165 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file RooFitDriver.cxx
+\class RooFitDriver
+\ingroup Roofitcore
+
+Drives the batch evaluation of the log-probabilities of a PDF over a dataset.
+
+Evaluating a PDF with getValues() recurses through the computation graph, and every node requests the
+results of its servers from the RooBatchCompute::RunContext. When the RunContext is cleared before each
+evaluation, as RooNLLVar used to do, every node of the graph is recomputed every time, although during
+minimisation usually only one parameter changes between two evaluations.
+
+The RooFitDriver analyses the computation graph once, and sorts its nodes topologically. Before every
+evaluation, it compares the current values of the parameters with the ones of the previous evaluation,
+and propagates the changes from servers to clients. The results of the nodes that are not affected by
+the changes are put back into the RunContext, such that the evaluation only recurses into the part of the
+graph that is downstream of the changed parameters. The computations themselves still run in the
+evaluateSpan() functions of the nodes, which dispatch to the RooBatchCompute library. The memory for the
+results of each node stays allocated in the RunContext between evaluations.
+
+If the dataset, the range of events or the normalisation set change, all nodes are recomputed.
+The structure of the computation graph must not change during the lifetime of the driver. A dataset is
+only recognised by its address and the addresses of its data, so the owner of the driver has to discard
+it when it replaces the dataset, as RooNLLVar::setData() does.
+**/
+
+#include "RooFitDriver.h"
+
+#include "RooAbsCategory.h"
+#include "RooAbsData.h"
+#include "RooAbsPdf.h"
+#include "RooAbsReal.h"
+#include "RooArgSet.h"
+#include "RooRealVar.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Analyse the computation graph of `topNode`.
+/// \param[in] topNode The PDF to evaluate. It must stay alive and keep its servers during the lifetime of the driver.
+/// \param[in] observables The observables of the dataset. Values of these come from the dataset, while values of all
+/// other fundamental objects in the graph are parameters.
+RooFitDriver::RooFitDriver(const RooAbsPdf& topNode, const RooArgSet& observables) : _topNode{topNode}
+{
+  std::unordered_map<const RooAbsArg*, std::size_t> indices;
+  sortTopologically(const_cast<RooAbsPdf&>(topNode), indices);
+
+  for (auto& info : _nodes) {
+    info.isObservable = observables.find(*info.arg) != nullptr;
+    info.isParameter = !info.isObservable && info.servers.empty() && dynamic_cast<RooRealVar*>(info.arg) != nullptr;
+  }
+
+  _evalData.spans.reserve(2 * _nodes.size());
+  _evalData.ownedMemory.reserve(2 * _nodes.size());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Depth-first traversal of the servers of `node`, appending each node after its servers.
+
+void RooFitDriver::sortTopologically(RooAbsArg& node, std::unordered_map<const RooAbsArg*, std::size_t>& indices)
+{
+  if (indices.find(&node) != indices.end())
+    return;
+
+  std::vector<std::size_t> servers;
+  for (RooAbsArg* server : node.servers()) {
+    sortTopologically(*server, indices);
+    servers.push_back(indices[server]);
+  }
+
+  NodeInfo info;
+  info.arg = &node;
+  info.real = dynamic_cast<RooAbsReal*>(&node);
+  info.servers = std::move(servers);
+  indices[&node] = _nodes.size();
+  _nodes.push_back(std::move(info));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the log-probabilities of the PDF for the events [firstEvent, firstEvent + nEvents) of `data`,
+/// recomputing only the nodes that depend on parameters that changed since the last call.
+/// \return Span with the log-probabilities. The memory is owned by the driver's RunContext.
+
+RooSpan<const double> RooFitDriver::getLogProbabilities(const RooAbsData& data, std::size_t firstEvent,
+                                                        std::size_t nEvents, const RooArgSet* normSet)
+{
+  bool allDirty = &data != _lastData || normSet != _lastNormSet || firstEvent != _lastFirstEvent ||
+                  nEvents != _lastNEvents;
+  _lastData = &data;
+  _lastNormSet = normSet;
+  _lastFirstEvent = firstEvent;
+  _lastNEvents = nEvents;
+
+  _evalData.clear();
+  data.getBatches(_evalData, firstEvent, nEvents);
+
+  // The dataset may have been refilled or moved, or may have started or stopped caching values of nodes
+  std::vector<DataSpan> dataSpans;
+  dataSpans.reserve(_evalData.spans.size());
+  for (auto const& item : _evalData.spans) {
+    dataSpans.push_back({item.first, item.second.data(), item.second.size()});
+  }
+  std::sort(dataSpans.begin(), dataSpans.end(),
+            [](const DataSpan& a, const DataSpan& b) { return std::less<const RooAbsReal*>{}(a.owner, b.owner); });
+  allDirty |= dataSpans != _lastDataSpans;
+  _lastDataSpans = std::move(dataSpans);
+
+  _nRecomputed = 0;
+  for (auto& info : _nodes) {
+    bool dirty = allDirty;
+    if (info.servers.empty() && !info.isObservable) {
+      const double value = info.real ? info.real->getVal()
+                                     : (dynamic_cast<RooAbsCategory*>(info.arg)
+                                          ? static_cast<RooAbsCategory*>(info.arg)->getCurrentIndex() : 0.);
+      // compare as integers, so that a NaN that stays NaN does not trigger recomputations
+      dirty |= std::memcmp(&value, &info.lastValue, sizeof(double)) != 0;
+      info.lastValue = value;
+    }
+    for (std::size_t i = 0; !dirty && i < info.servers.size(); ++i) {
+      dirty = _nodes[info.servers[i]].dirty;
+    }
+    info.dirty = dirty;
+
+    if (!info.real || info.isObservable)
+      continue;
+    if (dirty && info.isParameter) {
+      // Same as RooRealVar::getValues(), but without searching the spans for a variable with the same name
+      auto output = _evalData.makeBatch(info.real, 1);
+      output[0] = info.real->getVal();
+    } else if (!dirty && !info.span.empty()) {
+      // Data that were cached in the dataset take precedence
+      _evalData.spans.emplace(info.real, info.span);
+    } else if (dirty) {
+      ++_nRecomputed;
+    }
+  }
+
+  auto results = _topNode.getLogProbabilities(_evalData, normSet);
+
+  for (auto& info : _nodes) {
+    if (info.real)
+      info.span = _evalData.getBatch(info.real);
+  }
+
+  return results;
+}
@@ -222,6 +222,11 @@ RooSpan<double> RooHistFunc::evaluateSpan(RooBatchCompute::RunContext& evalData,
 
   auto results = evalData.makeBatch(this, batchSize);
 
+  if (_dataHist->weights(results, _depList, inputValues, _intOrder, false, _cdfBoundaries)) {
+    return results;
+  }
+
+  // Interpolation orders that are not supported by the batched lookup
   for (std::size_t i = 0; i < batchSize; ++i) {
     bool skip = false;
 
@@ -36,6 +36,7 @@ discrete dimensions.
 #include "RooWorkspace.h"
 #include "RooGlobalFunc.h"
 #include "RooHelpers.h"
+#include "RunContext.h"
 
 #include "TError.h"
 #include "TBuffer.h"
@@ -223,6 +224,56 @@ Double_t RooHistPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute value of the HistPdf for every entry in `evalData`, using the batched histogram lookup of
+/// RooDataHist::weights(). Interpolation orders that the batched lookup does not support are computed
+/// entry by entry.
+/// \param[in/out] evalData Struct with input data. The computation results will be stored here.
+/// \param[in] normSet Set of observables to normalise over (ignored, normalisation happens in getValues()).
+RooSpan<double> RooHistPdf::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* /*normSet*/) const {
+  std::vector<RooSpan<const double>> inputValues;
+  std::size_t batchSize = 0;
+  for (const auto obs : _pdfObsList) {
+    auto realObs = dynamic_cast<const RooAbsReal*>(obs);
+    if (realObs) {
+      auto inputs = realObs->getValues(evalData, nullptr);
+      batchSize = std::max(batchSize, inputs.size());
+      inputValues.push_back(std::move(inputs));
+    } else {
+      inputValues.emplace_back();
+    }
+  }
+
+  auto results = evalData.makeBatch(this, batchSize);
+
+  if (!_dataHist->weights(results, _pdfObsList, inputValues, _intOrder, !_unitNorm, _cdfBoundaries)) {
+    for (std::size_t i = 0; i < batchSize; ++i) {
+      bool skip = false;
+
+      for (auto j = 0u; j < _histObsList.size(); ++j) {
+        const auto histObs = _histObsList[j];
+
+        if (i < inputValues[j].size()) {
+          histObs->setCachedValue(inputValues[j][i], false);
+          if (!histObs->inRange(nullptr)) {
+            skip = true;
+            break;
+          }
+        }
+      }
+
+      results[i] = skip ? 0. : _dataHist->weightFast(_histObsList, _intOrder, !_unitNorm, _cdfBoundaries);
+    }
+  }
+
+  for (double& val : results) {
+    val = std::max(val, 0.);
+  }
+
+  return results;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the total volume spanned by the observables of the RooHistPdf
 
@@ -61,12 +61,16 @@ void RooIntegrator1D::registerIntegrator(RooNumIntFactory& fact)
   extrap.defineType("None",0) ;
   extrap.defineType("Wynn-Epsilon",1) ;
   extrap.setLabel("Wynn-Epsilon") ;
+  RooCategory batchMode("batchMode","Evaluate the points of each refinement step in one batch") ;
+  batchMode.defineType("Off",0) ;
+  batchMode.defineType("On",1) ;
+  batchMode.setLabel("Off") ;
   RooRealVar maxSteps("maxSteps","Maximum number of steps",20) ;
   RooRealVar minSteps("minSteps","Minimum number of steps",999) ;
   RooRealVar fixSteps("fixSteps","Fixed number of steps",0) ;
 
   RooIntegrator1D* proto = new RooIntegrator1D() ;
-  fact.storeProtoIntegrator(proto,RooArgSet(sumRule,extrap,maxSteps,minSteps,fixSteps)) ;
+  fact.storeProtoIntegrator(proto,RooArgSet(sumRule,extrap,maxSteps,minSteps,fixSteps,batchMode)) ;
   RooNumIntConfig::defaultConfig().method1D().setLabel(proto->IsA()->GetName()) ;
 }
 
@@ -89,7 +93,7 @@ RooIntegrator1D::RooIntegrator1D() :
 
 RooIntegrator1D::RooIntegrator1D(const RooAbsFunc& function, SummationRule rule,
 				 Int_t maxSteps, Double_t eps) : 
-  RooAbsIntegrator(function), _rule(rule), _maxSteps(maxSteps),  _minStepsZero(999), _fixSteps(0), _epsAbs(eps), _epsRel(eps), _doExtrap(kTRUE)
+  RooAbsIntegrator(function), _rule(rule), _maxSteps(maxSteps),  _minStepsZero(999), _fixSteps(0), _epsAbs(eps), _epsRel(eps), _doExtrap(kTRUE), _batchMode(kFALSE)
 {
   _useIntegrandLimits= kTRUE;
   _valid= initialize();
@@ -111,7 +115,8 @@ RooIntegrator1D::RooIntegrator1D(const RooAbsFunc& function, Double_t xmin, Doub
   _fixSteps(0),
   _epsAbs(eps), 
   _epsRel(eps),
-  _doExtrap(kTRUE)
+  _doExtrap(kTRUE),
+  _batchMode(kFALSE)
 {
   _useIntegrandLimits= kFALSE;
   _xmin= xmin;
@@ -137,6 +142,7 @@ RooIntegrator1D::RooIntegrator1D(const RooAbsFunc& function, const RooNumIntConf
   _minStepsZero = (Int_t) configSet.getRealValue("minSteps",999) ;
   _fixSteps = (Int_t) configSet.getRealValue("fixSteps",0) ;
   _doExtrap = (Bool_t) configSet.getCatIndex("extrapolation",1) ;
+  _batchMode = (Bool_t) configSet.getCatIndex("batchMode",0) ;
 
   if (_fixSteps>_maxSteps) {
     oocoutE((TObject*)0,Integration) << "RooIntegrator1D::ctor() ERROR: fixSteps>maxSteps, fixSteps set to maxSteps" << endl ;
@@ -166,6 +172,7 @@ RooIntegrator1D::RooIntegrator1D(const RooAbsFunc& function, Double_t xmin, Doub
   _minStepsZero = (Int_t) configSet.getRealValue("minSteps",999) ;
   _fixSteps = (Int_t) configSet.getRealValue("fixSteps",0) ;  
   _doExtrap = (Bool_t) configSet.getCatIndex("extrapolation",1) ;
+  _batchMode = (Bool_t) configSet.getCatIndex("batchMode",0) ;
 
   _useIntegrandLimits= kFALSE;
   _xmin= xmin;
@@ -368,12 +375,24 @@ Double_t RooIntegrator1D::addMidpoints(Int_t n)
     del= _range/(3.*tnm);
     ddel= del+del;
     x= _xmin + 0.5*del;
-    for(sum= 0, j= 1; j <= it; j++) {
-      sum+= integrand(xvec(x));
-      x+= ddel;
-      sum+= integrand(xvec(x));
-      x+= del;
-    }      
+    if (_batchMode) {
+      _xBatch.resize(2*it) ;
+      for(j= 0; j < it; j++) {
+        _xBatch[2*j]= x;
+        x+= ddel;
+        _xBatch[2*j+1]= x;
+        x+= del;
+      }
+      sum= sumIntegrand() ;
+    }
+    else {
+      for(sum= 0, j= 1; j <= it; j++) {
+        sum+= integrand(xvec(x));
+        x+= ddel;
+        sum+= integrand(xvec(x));
+        x+= del;
+      }
+    }
     return (_savedResult= (_savedResult + _range*sum/tnm)/3.);
   }
 }
@@ -399,10 +418,17 @@ Double_t RooIntegrator1D::addTrapezoids(Int_t n)
     const double xmin = _xmin;
 
     double sum = 0.;
-    // TODO Replace by batch computation
-    for (int j=0; j<nInt; ++j) {
-      double x = xmin + (0.5+j)*del;
-      sum += integrand(xvec(x));
+    if (_batchMode) {
+      _xBatch.resize(nInt) ;
+      for (int j=0; j<nInt; ++j) {
+        _xBatch[j] = xmin + (0.5+j)*del;
+      }
+      sum = sumIntegrand() ;
+    } else {
+      for (int j=0; j<nInt; ++j) {
+        double x = xmin + (0.5+j)*del;
+        sum += integrand(xvec(x));
+      }
     }
 
     return (_savedResult= 0.5*(_savedResult + _range*sum/nInt));
@@ -411,6 +437,37 @@ Double_t RooIntegrator1D::addTrapezoids(Int_t n)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sum the integrand over all points in `_xBatch`. The points are passed to the
+/// function binding as a single batch, so that bindings like RooRealBinding can
+/// evaluate them with RooBatchCompute. The other coordinates, which are set when
+/// the integrator is nested in a multi-dimensional integration, are broadcast.
+/// If the binding cannot evaluate the batch, the points are evaluated one by one.
+
+Double_t RooIntegrator1D::sumIntegrand()
+{
+  std::vector<RooSpan<const double>> coordinates ;
+  coordinates.emplace_back(_xBatch) ;
+  for (UInt_t i=1 ; i<integrand()->getDimension() ; i++) {
+    coordinates.emplace_back(_x+i, 1) ;
+  }
+
+  double sum = 0. ;
+  RooSpan<const double> values = integrand()->getValues(coordinates) ;
+  if (values.size() == _xBatch.size()) {
+    for (double value : values) {
+      sum += value ;
+    }
+  } else {
+    for (double x : _xBatch) {
+      sum += integrand(xvec(x)) ;
+    }
+  }
+  return sum ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Extrapolate result to final value
 
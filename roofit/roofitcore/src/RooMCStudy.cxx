@@ -42,6 +42,9 @@ extra steps in the cycle. Output of these modules can be stored
 alongside the fit results in the aggregate results dataset.
 These study modules should derive from the class RooAbsMCStudyModule.
 
+With the NumCPU() option, samples are generated and fitted in parallel in forked worker
+processes, see RooMCStudy::RooMCStudy().
+
 Check the RooFit tutorials
 - rf801_mcstudy.C
 - rf802_mcstudy_addons.C
@@ -76,6 +79,19 @@ for usage examples.
 #include "RooPullVar.h"
 #include "RooMsgService.h"
 #include "RooProdPdf.h"
+#include "RooAbsCategoryLValue.h"
+
+#ifndef _WIN32
+#include "BidirMMapPipe.h"
+#endif
+
+#include "TBufferFile.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 using namespace std ;
 
@@ -108,6 +124,11 @@ fitting the PDF to data and accumulating the fit statistics.
          <td> Prototype data for the event generation. If the randOrder flag is set, the order of the dataset will be re-randomized for each generation
               cycle to protect against systematic biases if the number of generated events does not exactly match the number of events in the prototype dataset
               at the cost of reduced precision with mu equal to the specified number of events
+<tr><td> NumCPU(Int_t nWorkers)            <td> Generate and fit the samples in `nWorkers` forked processes. A worker gets the next sample as soon as
+                                                it finished the previous one. The random generator is seeded for each sample from the sample number and a
+                                                seed that is drawn once per run, so the results don't depend on the number of workers.
+                                                Only used by generateAndFit(), and not when the generated data is kept or written to files, or when study
+                                                modules are used. Not available on Windows.
 </table>
 */
 RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
@@ -136,6 +157,7 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
   pc.defineInt("verboseGen","Verbose",0,0) ;
   pc.defineInt("extendedGen","Extended",0,0) ;
   pc.defineInt("binGenData","Binned",0,0) ;
+  pc.defineInt("nWorkers","NumCPU",0,0) ;
   pc.defineString("fitOpts","FitOptions",0,"") ;
   pc.defineInt("dummy","FitOptArgs",0,0) ;
   pc.defineMutex("FitOptions","FitOptArgs") ; // can have either classic or new-style fit options
@@ -164,6 +186,7 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
   _extendedGen = pc.getInt("extendedGen") ;
   _binGenData = pc.getInt("binGenData") ;
   _randProto = pc.getInt("randProtoData") ;
+  _nWorkers = pc.getInt("nWorkers") ;
 
   // Process constraints specifications
   const RooArgSet* cParsTmp = pc.getSet("cPars") ;
@@ -346,7 +369,8 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& genModel, const RooAbsPdf& fitModel,
   _fitOptions(fitOptions),
   _canAddFitResults(kTRUE),
   _perExptGenParams(0),
-  _silence(kFALSE)
+  _silence(kFALSE),
+  _nWorkers(0)
 {
   // Decode generator options
   TString genOpt(genOptions) ;
@@ -462,6 +486,7 @@ void RooMCStudy::addModule(RooAbsMCStudyModule& module)
 /// When fitting only, data sets may optionally be read from ascii files, using the same file
 /// pattern.
 ///
+/// Returns true if an error occurred while processing the samples in worker processes.
 
 Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) 
 {
@@ -476,9 +501,24 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
     (*iter)->initializeRun(nSamples) ;
   }  
   
+  // Generated samples only need to be passed back from the workers if they are fitted and then discarded
+  Bool_t inWorkers = _nWorkers>0 && doGenerate && DoFit ;
+  if (inWorkers && (keepGenData || (asciiFilePat && *asciiFilePat) || !_modList.empty())) {
+    oocoutW(_fitModel,Generation) << "RooMCStudy::run: WARNING samples are processed serially, because the generated "
+                                  << "data is kept or written to files, or study modules are used" << endl ;
+    inWorkers = kFALSE ;
+  }
+#ifdef _WIN32
+  inWorkers = kFALSE ;
+#endif
+  Bool_t error = kFALSE ;
+  if (inWorkers) {
+    error = runInWorkers(nSamples,nEvtPerSample) ;
+  }
+
   Int_t prescale = nSamples>100 ? Int_t(nSamples/100) : 1 ;
 
-  while(nSamples--) {
+  while(!inWorkers && nSamples--) {
     
     if (nSamples%prescale==0) {
       oocoutP(_fitModel,Generation) << "RooMCStudy::run: " ;
@@ -492,68 +532,8 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
     Bool_t existingData = kFALSE ;
     if (doGenerate) {
       // Generate sample
-      Int_t nEvt(nEvtPerSample) ;
-
-      // Reset generator parameters to initial values
-      *_genParams = *_genInitParams ;
-
-      // If constraints are present, sample generator values from constraints
-      if (_constrPdf) {
-	RooDataSet* tmp = _constrGenContext->generate(1) ;
-	*_genParams = *tmp->get() ;
-	delete tmp ;
-      }
-
-      // Save generated parameters if required
-      if (_genParData) {
-	_genParData->add(*_genParams) ;
-      }
-
-      // Call module before-generation hook
-      list<RooAbsMCStudyModule*>::iterator iter2 ;
-      for (iter2=_modList.begin() ; iter2!= _modList.end() ; ++iter2) {
-	(*iter2)->processBeforeGen(nSamples) ;
-      }  
-
-      if (_binGenData) {
-
-	// Calculate the number of (extended) events for this run
-	if (_extendedGen) {
-	  _nExpGen = _genModel->expectedEvents(&_dependents) ;
-	  nEvt = RooRandom::randomGenerator()->Poisson(nEvtPerSample==0?_nExpGen:nEvtPerSample) ;
-	}	
+      _genSample = generateSample(nEvtPerSample,nSamples) ;
 
-	// Binned generation
-	_genSample = _genModel->generateBinned(_dependents,nEvt) ;
-
-      } else {
-
-	// Calculate the number of (extended) events for this run
-	if (_extendedGen) {
-	  _nExpGen = _genModel->expectedEvents(&_dependents) ;
-	  nEvt = RooRandom::randomGenerator()->Poisson(nEvtPerSample==0?_nExpGen:nEvtPerSample) ;
-	}
-	
-	// Optional randomization of protodata for this run
-	if (_randProto && _genProtoData && _genProtoData->numEntries()!=nEvt) {
-	  oocoutI(_fitModel,Generation) << "RooMCStudy: (Re)randomizing event order in prototype dataset (Nevt=" << nEvt << ")" << endl ;
-	  Int_t* newOrder = _genModel->randomizeProtoOrder(_genProtoData->numEntries(),nEvt) ;
-	  _genContext->setProtoDataOrder(newOrder) ;
-	  delete[] newOrder ;
-	}
-
-	coutP(Generation) << "RooMCStudy: now generating " << nEvt << " events" << endl ;
-	
-	// Actual generation of events
-	if (nEvt>0) {
-	  _genSample = _genContext->generate(nEvt) ;
-	} else {
-	  // Make empty dataset
-	  _genSample = new RooDataSet("emptySample","emptySample",_dependents) ;
-	}	
-      } 
-
-	
     //} else if (asciiFilePat && &asciiFilePat) { //warning: the address of 'asciiFilePat' will always evaluate as 'true'
     } else if (asciiFilePat) {
 
@@ -639,11 +619,339 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
     RooMsgService::instance().setGlobalKillBelow(oldLevel) ;
   }
 
-  return kFALSE ;
+  return error ;
+}
+
+
+
+
+
+
+namespace {
+
+/// Collect the values of `vars`. Real-valued variables contribute their value and their errors, such that
+/// setValues() can restore whether they have errors.
+std::vector<double> getValues(const RooArgSet& vars)
+{
+  std::vector<double> values ;
+  for (const auto arg : vars) {
+    if (auto var = dynamic_cast<const RooRealVar*>(arg)) {
+      values.push_back(var->getVal()) ;
+      values.push_back(var->hasError() ? var->getError() : -1.) ;
+      values.push_back(var->hasAsymError() ? var->getAsymErrorLo() : 1.) ;
+      values.push_back(var->hasAsymError() ? var->getAsymErrorHi() : -1.) ;
+    } else if (auto cat = dynamic_cast<const RooAbsCategory*>(arg)) {
+      values.push_back(cat->getCurrentIndex()) ;
+    } else if (auto real = dynamic_cast<const RooAbsReal*>(arg)) {
+      values.push_back(real->getVal()) ;
+    }
+  }
+  return values ;
+}
+
+/// Set the values that getValues() collected from a set with the same layout.
+void setValues(RooArgSet& vars, const std::vector<double>& values)
+{
+  auto value = values.begin() ;
+  for (const auto arg : vars) {
+    if (auto var = dynamic_cast<RooRealVar*>(arg)) {
+      var->setVal(value[0]) ;
+      var->setError(value[1]) ;
+      var->setAsymError(value[2],value[3]) ;
+      value += 4 ;
+    } else if (auto cat = dynamic_cast<RooAbsCategoryLValue*>(arg)) {
+      cat->setIndex(static_cast<RooAbsCategory::value_type>(*value++)) ;
+    } else if (dynamic_cast<RooAbsCategory*>(arg) || dynamic_cast<RooAbsReal*>(arg)) {
+      // not settable
+      ++value ;
+    }
+  }
+}
+
+#ifndef _WIN32
+
+void writeValues(RooFit::BidirMMapPipe& pipe, const std::vector<double>& values)
+{
+  pipe << values.size() ;
+  for (double value : values) {
+    pipe << value ;
+  }
+}
+
+void readValues(RooFit::BidirMMapPipe& pipe, std::vector<double>& values)
+{
+  std::size_t size ;
+  pipe >> size ;
+  values.resize(size) ;
+  for (double& value : values) {
+    pipe >> value ;
+  }
+}
+
+#endif
+
+/// What a worker sends back for every sample.
+struct SampleResult {
+  Bool_t fitOk = kFALSE ;
+  std::vector<double> genValues ; // Generator parameters, if they are stored
+  std::vector<double> fitValues ; // Fit parameters, NLL and number of events, if the fit converged
+  std::string fitResult ;         // Streamed RooFitResult, if the user requested to save it
+} ;
+
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and fit 'nSamples' samples in _nWorkers forked processes, which start from a copy of the
+/// models. A worker receives the number of the next sample to process as soon as it finished the previous one,
+/// so a few slow fits don't hold up the others. The random generator is seeded for each sample from the sample
+/// number, so the results don't depend on the number of workers or on the order in which samples are completed.
+/// The results are added to the datasets in the order of the sample numbers, as soon as all samples before them
+/// are done.
+
+Bool_t RooMCStudy::runInWorkers(Int_t nSamples, Int_t nEvtPerSample)
+{
+#ifndef _WIN32
+  using RooFit::BidirMMapPipe ;
+
+  const UInt_t baseSeed = 1 + RooRandom::integer(1000000000) ;
+
+  // Clear the eval error log prior to forking to avoid confusions
+  RooAbsReal::clearEvalErrorLog() ;
+  std::vector<std::unique_ptr<BidirMMapPipe>> pipes ;
+  for (Int_t i=0 ; i<std::min(_nWorkers,nSamples) ; ++i) {
+    std::unique_ptr<BidirMMapPipe> pipe(new BidirMMapPipe()) ;
+    if (pipe->isChild()) {
+      // the pipes to the other workers were already closed in the child by BidirMMapPipe
+      for (auto& other : pipes) {
+        other.release() ;
+      }
+      workerLoop(*pipe,nEvtPerSample,baseSeed) ;
+      pipe->close() ;
+      _exit(0) ;
+    }
+    pipes.push_back(std::move(pipe)) ;
+  }
+
+  // Samples are processed from the highest number down, like in the serial loop
+  Int_t nextSample = nSamples-1 ;
+  Int_t nextToStore = nSamples-1 ;
+  Int_t nRunning = 0 ;
+  BidirMMapPipe::PollVector poller ;
+  for (auto& pipe : pipes) {
+    *pipe << nextSample-- << BidirMMapPipe::flush ;
+    ++nRunning ;
+    poller.emplace_back(pipe.get(),BidirMMapPipe::Readable) ;
+  }
+
+  RooArgSet fitRow(*_fitParams) ;
+  fitRow.add(*_nllVar) ;
+  fitRow.add(*_ngenVar) ;
+
+  std::map<Int_t,SampleResult> results ;
+  Int_t prescale = nSamples>100 ? Int_t(nSamples/100) : 1 ;
+  Bool_t error = kFALSE ;
+  std::set<BidirMMapPipe*> lost ; // workers that exited, nothing can be sent to them anymore
+  while (nRunning>0 && !error) {
+    if (BidirMMapPipe::poll(poller,-1)<0) {
+      oocoutE(_fitModel,Generation) << "RooMCStudy::runInWorkers: ERROR polling the worker processes failed" << endl ;
+      error = kTRUE ;
+      break ;
+    }
+
+    for (auto& entry : poller) {
+      if (entry.revents & (BidirMMapPipe::Error | BidirMMapPipe::ReadEndOfFile | BidirMMapPipe::Invalid)) {
+        oocoutE(_fitModel,Generation) << "RooMCStudy::runInWorkers: ERROR lost connection to worker process "
+                                      << entry.pipe->pidOtherEnd() << endl ;
+        lost.insert(entry.pipe) ;
+        error = kTRUE ;
+      }
+    }
+    if (error) break ;
+
+    for (auto& entry : poller) {
+      if (!(entry.revents & BidirMMapPipe::Readable)) continue ;
+
+      BidirMMapPipe& pipe = *entry.pipe ;
+      Int_t sampleNum ;
+      pipe >> sampleNum ;
+      SampleResult& result = results[sampleNum] ;
+      pipe >> result.fitOk ;
+      readValues(pipe,result.genValues) ;
+      readValues(pipe,result.fitValues) ;
+      pipe >> result.fitResult ;
+      --nRunning ;
+
+      if (nextSample>=0) {
+        pipe << nextSample-- << BidirMMapPipe::flush ;
+        ++nRunning ;
+      }
+    }
+
+    // Store all results up to the first sample that is still running
+    for (auto found = results.find(nextToStore) ; found!=results.end() ; found = results.find(--nextToStore)) {
+      const SampleResult& result = found->second ;
+      if (nextToStore%prescale==0) {
+        oocoutP(_fitModel,Generation) << "RooMCStudy::runInWorkers: Generated and fitted sample " << nextToStore << endl ;
+      }
+
+      if (_genParData) {
+        setValues(*_genParams,result.genValues) ;
+        _genParData->add(*_genParams) ;
+      }
+      if (result.fitOk) {
+        setValues(fitRow,result.fitValues) ;
+        _fitParData->add(fitRow) ;
+      }
+      if (!result.fitResult.empty()) {
+        TBufferFile buffer(TBuffer::kRead,result.fitResult.size(),const_cast<char*>(result.fitResult.data()),kFALSE) ;
+        _fitResList.Add(buffer.ReadObject(RooFitResult::Class())) ;
+      }
+      results.erase(found) ;
+    }
+  }
+
+  for (auto& pipe : pipes) {
+    if (!lost.count(pipe.get())) {
+      *pipe << -1 << BidirMMapPipe::flush ;
+    }
+    pipe->close() ;
+  }
+
+  return error ;
+#else
+  (void)nSamples ;
+  (void)nEvtPerSample ;
+  return kTRUE ;
+#endif
 }
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Process the samples whose numbers the master process sends through `pipe`, until it sends a negative number.
+/// Each sample is generated with a random generator seeded from `baseSeed` and the sample number, fitted,
+/// and the results are sent back.
+
+void RooMCStudy::workerLoop(RooFit::BidirMMapPipe& pipe, Int_t nEvtPerSample, UInt_t baseSeed)
+{
+#ifndef _WIN32
+  RooArgSet fitRow(*_fitParams) ;
+  fitRow.add(*_nllVar) ;
+  fitRow.add(*_ngenVar) ;
+
+  Int_t sampleNum ;
+  while (pipe.good() && !pipe.eof()) {
+    pipe >> sampleNum ;
+    if (!pipe || sampleNum<0) return ;
+
+    RooRandom::randomGenerator()->SetSeed(baseSeed + sampleNum) ;
+    _genSample = generateSample(nEvtPerSample,sampleNum) ;
+    _ngenVar->setVal(_genSample->sumEntries()) ;
+
+    const Int_t nSavedFitResults = _fitResList.GetSize() ;
+    const Bool_t fitOk = !fitSample(_genSample) ;
+
+    pipe << sampleNum << fitOk ;
+    writeValues(pipe,_genParData ? getValues(*_genParams) : std::vector<double>()) ;
+    writeValues(pipe,fitOk ? getValues(fitRow) : std::vector<double>()) ;
+    std::string fitResult ;
+    if (_fitResList.GetSize()>nSavedFitResults) {
+      TObject* fr = _fitResList.Last() ;
+      TBufferFile buffer(TBuffer::kWrite) ;
+      buffer.WriteObject(fr) ;
+      fitResult.assign(buffer.Buffer(),buffer.Length()) ;
+      _fitResList.Remove(fr) ;
+      delete fr ;
+    }
+    pipe << fitResult << RooFit::BidirMMapPipe::flush ;
+
+    // The results are owned by the master process now
+    delete _genSample ;
+    _genSample = 0 ;
+    _fitParData->reset() ;
+    if (_genParData) _genParData->reset() ;
+  }
+#else
+  (void)pipe ;
+  (void)nEvtPerSample ;
+  (void)baseSeed ;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the sample with number `sampleNum`. If `nEvtPerSample` is zero, the expected number of events
+/// of the generator model is used in extended mode.
+
+RooAbsData* RooMCStudy::generateSample(Int_t nEvtPerSample, Int_t sampleNum)
+{
+  RooAbsData* genSample = 0 ;
+  Int_t nEvt(nEvtPerSample) ;
+
+  // Reset generator parameters to initial values
+  *_genParams = *_genInitParams ;
+
+  // If constraints are present, sample generator values from constraints
+  if (_constrPdf) {
+    RooDataSet* tmp = _constrGenContext->generate(1) ;
+    *_genParams = *tmp->get() ;
+    delete tmp ;
+  }
+
+  // Save generated parameters if required
+  if (_genParData) {
+    _genParData->add(*_genParams) ;
+  }
+
+  // Call module before-generation hook
+  list<RooAbsMCStudyModule*>::iterator iter2 ;
+  for (iter2=_modList.begin() ; iter2!= _modList.end() ; ++iter2) {
+    (*iter2)->processBeforeGen(sampleNum) ;
+  }
+
+  if (_binGenData) {
+
+    // Calculate the number of (extended) events for this run
+    if (_extendedGen) {
+      _nExpGen = _genModel->expectedEvents(&_dependents) ;
+      nEvt = RooRandom::randomGenerator()->Poisson(nEvtPerSample==0?_nExpGen:nEvtPerSample) ;
+    }
+
+    // Binned generation
+    genSample = _genModel->generateBinned(_dependents,nEvt) ;
+
+  } else {
+
+    // Calculate the number of (extended) events for this run
+    if (_extendedGen) {
+      _nExpGen = _genModel->expectedEvents(&_dependents) ;
+      nEvt = RooRandom::randomGenerator()->Poisson(nEvtPerSample==0?_nExpGen:nEvtPerSample) ;
+    }
+
+    // Optional randomization of protodata for this run
+    if (_randProto && _genProtoData && _genProtoData->numEntries()!=nEvt) {
+      oocoutI(_fitModel,Generation) << "RooMCStudy: (Re)randomizing event order in prototype dataset (Nevt=" << nEvt << ")" << endl ;
+      Int_t* newOrder = _genModel->randomizeProtoOrder(_genProtoData->numEntries(),nEvt) ;
+      _genContext->setProtoDataOrder(newOrder) ;
+      delete[] newOrder ;
+    }
+
+    coutP(Generation) << "RooMCStudy: now generating " << nEvt << " events" << endl ;
+
+    // Actual generation of events
+    if (nEvt>0) {
+      genSample = _genContext->generate(nEvt) ;
+    } else {
+      // Make empty dataset
+      genSample = new RooDataSet("emptySample","emptySample",_dependents) ;
+    }
+  }
+
+  return genSample ;
+}
 
 
 
@@ -40,6 +40,7 @@ In extended mode, a
 #include "RooRealVar.h"
 #include "RooProdPdf.h"
 #include "RooNaNPacker.h"
+#include "RooFitDriver.h"
 #include "RunContext.h"
 
 #ifdef ROOFIT_CHECK_CACHED_VALUES
@@ -243,6 +244,17 @@ RooNLLVar::~RooNLLVar()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Change the dataset. The batch evaluation driver is discarded, because it holds the results
+/// of the previous dataset and the observables of the function clone are replaced by the ones of the new dataset.
+
+Bool_t RooNLLVar::setDataSlave(RooAbsData& indata, Bool_t cloneData, Bool_t ownNewDataAnyway)
+{
+  _driver.reset();
+  return RooAbsOptTestStatistic::setDataSlave(indata, cloneData, ownNewDataAnyway);
+}
+
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -461,12 +473,12 @@ Double_t RooNLLVar::evaluatePartition(std::size_t firstEvent, std::size_t lastEv
 RooNLLVar::ComputeResult RooNLLVar::computeBatched(std::size_t stepSize, std::size_t firstEvent, std::size_t lastEvent) const
 {
   auto pdfClone = static_cast<const RooAbsPdf*>(_funcClone);
-  return computeBatchedFunc(pdfClone, _dataClone, _evalData, _normSet, _weightSq, stepSize, firstEvent, lastEvent);
+  return computeBatchedFunc(pdfClone, _dataClone, _driver, _normSet, _weightSq, stepSize, firstEvent, lastEvent);
 }
 
 // static function, also used from TestStatistics::RooUnbinnedL
 RooNLLVar::ComputeResult RooNLLVar::computeBatchedFunc(const RooAbsPdf *pdfClone, RooAbsData *dataClone,
-                                                       std::unique_ptr<RooBatchCompute::RunContext> &evalData,
+                                                       std::unique_ptr<RooFitDriver> &driver,
                                                        RooArgSet *normSet, bool weightSq, std::size_t stepSize,
                                                        std::size_t firstEvent, std::size_t lastEvent)
 {
@@ -476,16 +488,13 @@ RooNLLVar::ComputeResult RooNLLVar::computeBatchedFunc(const RooAbsPdf *pdfClone
     throw std::invalid_argument(std::string("Error in ") + __FILE__ + ": Step size for batch computations can only be 1.");
   }
 
-  // Create a RunContext that will own the memory where computation results are stored.
-  // Holding on to this struct in between function calls will make sure that the memory
-  // is only allocated once.
-  if (!evalData) {
-    evalData.reset(new RooBatchCompute::RunContext);
+  // Create a driver that analyses the computation graph once, and owns the memory where computation results are
+  // stored. Holding on to it in between function calls will make sure that the memory is only allocated once, and
+  // that only the nodes that depend on parameters that changed are recomputed.
+  if (!driver) {
+    driver.reset(new RooFitDriver(*pdfClone, *dataClone->get()));
   }
-  evalData->clear();
-  dataClone->getBatches(*evalData, firstEvent, nEvents);
-
-  auto results = pdfClone->getLogProbabilities(*evalData, normSet);
+  auto results = driver->getLogProbabilities(*dataClone, firstEvent, nEvents, normSet);
 
 #ifdef ROOFIT_CHECK_CACHED_VALUES
 
@@ -497,14 +506,14 @@ RooNLLVar::ComputeResult RooNLLVar::computeBatchedFunc(const RooAbsPdf *pdfClone
     assert(dataClone->valid());
     try {
       // Cross check results with strict tolerance and complain
-      BatchInterfaceAccessor::checkBatchComputation(*pdfClone, *evalData, evtNo-firstEvent, normSet, 1.E-13);
+      BatchInterfaceAccessor::checkBatchComputation(*pdfClone, driver->runContext(), evtNo-firstEvent, normSet, 1.E-13);
     } catch (std::exception& e) {
       std::cerr << __FILE__ << ":" << __LINE__ << " ERROR when checking batch computation for event " << evtNo << ":\n"
           << e.what() << std::endl;
 
       // It becomes a real problem if it's very wrong. We fail in this case:
       try {
-         BatchInterfaceAccessor::checkBatchComputation(*pdfClone, *evalData, evtNo-firstEvent, normSet, 1.E-9);
+         BatchInterfaceAccessor::checkBatchComputation(*pdfClone, driver->runContext(), evtNo-firstEvent, normSet, 1.E-9);
       } catch (std::exception& e2) {
         assert(false);
       }
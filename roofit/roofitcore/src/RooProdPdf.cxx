@@ -59,6 +59,7 @@ have to appear in any specific place in the list.
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
 #include "RooBatchCompute.h"
+#include "RooCodeGenContext.h"
 #include "RooHelpers.h"
 #include "strtok.h"
 
@@ -1871,6 +1872,51 @@ Double_t RooProdPdf::expectedEvents(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the product of the component p.d.f.s, each normalised over
+/// its own observables. This is only the normalised product if the components don't
+/// share observables, and if no conditional normalisation was requested.
+
+bool RooProdPdf::translate(RooCodeGenContext& ctx) const
+{
+  if (!_selfNorm || _refRangeName || normRange()) {
+    return ctx.fail(*this, "products with custom normalisation ranges are not supported") ;
+  }
+  for (const auto nset : _pdfNSetList) {
+    if (static_cast<RooArgSet*>(nset)->getSize() > 0) {
+      return ctx.fail(*this, "conditional products are not supported") ;
+    }
+  }
+
+  RooArgSet seenObs ;
+  std::string result ;
+  for (const auto arg : _pdfList) {
+    std::unique_ptr<RooArgSet> compObs{arg->getObservables(ctx.normSet())} ;
+    if (seenObs.overlaps(*compObs)) {
+      return ctx.fail(*this, "components that share observables are not supported") ;
+    }
+    seenObs.add(*compObs) ;
+    result += (result.empty() ? "" : " * ") + ctx.getNormalizedResult(static_cast<const RooAbsPdf&>(*arg)) ;
+  }
+  ctx.addResult(this, result.empty() ? "1." : result) ;
+  return true ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the expected number of events of the extended component.
+
+std::string RooProdPdf::translateExpectedEvents(RooCodeGenContext& ctx) const
+{
+  if (_extendedIndex<0) {
+    return "" ;
+  }
+  return static_cast<const RooAbsPdf&>(_pdfList[_extendedIndex]).translateExpectedEvents(ctx) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return generator context optimized for generating events from product p.d.f.s
 
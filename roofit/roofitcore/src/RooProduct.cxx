@@ -29,6 +29,7 @@ A RooProduct represents the product of a given set of RooAbsReal objects.
 #include "RooAbsReal.h"
 #include "RooAbsCategory.h"
 #include "RooMsgService.h"
+#include "RooCodeGenContext.h"
 #include "RunContext.h"
 #include "RooTrace.h"
 
@@ -384,6 +385,23 @@ Double_t RooProduct::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the product of all real and category terms.
+
+bool RooProduct::translate(RooCodeGenContext& ctx) const
+{
+  std::string result;
+  for (const auto item : _compRSet) {
+    result += (result.empty() ? "" : " * ") + ctx.getResult(*item);
+  }
+  for (const auto item : _compCSet) {
+    result += (result.empty() ? "" : " * ") + ctx.getResult(*item);
+  }
+  ctx.addResult(this, result.empty() ? "1." : result);
+  return true;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate product of input functions for all points found in `evalData`.
 RooSpan<double> RooProduct::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
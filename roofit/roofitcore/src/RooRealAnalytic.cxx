@@ -63,7 +63,7 @@ RooSpan<const double> RooRealAnalytic::getValues(std::vector<RooSpan<const doubl
 
   for (std::size_t i=0; i < coordinates.front().size(); ++i) {
     for (unsigned int dim=0; dim < coordinates.size(); ++dim) {
-      _vars[dim]->setVal(coordinates[dim][i]);
+      _vars[dim]->setVal(coordinates[dim].size() == 1 ? coordinates[dim][0] : coordinates[dim][i]);
     }
 
     if (_code == 0) {
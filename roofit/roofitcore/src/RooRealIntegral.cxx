@@ -26,6 +26,12 @@ terms and defines what numerical integrations needs to be done to complement the
 analytical integral.
 The actual analytical integrations (if any) are done in the PDF themselves, the numerical
 integration is performed in the various implementations of the RooAbsIntegrator base class.
+
+The results of the most recent numerical integrations are remembered together with the values
+of the parameters of the integral and the integration limits. When the parameters return to
+values for which the integral was already computed, as it happens e.g. when Hesse or Minos
+step back and forth around the minimum, the integral is not recomputed. The number of
+remembered results can be changed with setNumericMemoSize().
 **/
 
 #include "RooRealIntegral.h"
@@ -51,6 +57,7 @@ integration is performed in the various implementations of the RooAbsIntegrator
 
 #include "TClass.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -60,6 +67,7 @@ ClassImp(RooRealIntegral);
 
 
 Int_t RooRealIntegral::_cacheAllNDim(2) ;
+std::size_t RooRealIntegral::_memoSize(8) ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -76,6 +84,7 @@ RooRealIntegral::RooRealIntegral() :
   _numIntegrand(0),
   _rangeName(0),
   _params(0),
+  _branchNodes(0),
   _cacheNum(kFALSE)
 {
   TRACE_CREATE
@@ -115,6 +124,7 @@ RooRealIntegral::RooRealIntegral(const char *name, const char *title,
   _numIntegrand(0),
   _rangeName((TNamed*)RooNameReg::ptr(rangeName)),
   _params(0),
+  _branchNodes(0),
   _cacheNum(kFALSE)
 {
   //   A) Check that all dependents are lvalues 
@@ -717,6 +727,7 @@ RooRealIntegral::RooRealIntegral(const RooRealIntegral& other, const char* name)
   _numIntegrand(0),
   _rangeName(other._rangeName),
   _params(0),
+  _branchNodes(0),
   _cacheNum(kFALSE)
 {
  _funcNormSet = other._funcNormSet ? (RooArgSet*)other._funcNormSet->snapshot(kFALSE) : 0 ;
@@ -745,6 +756,7 @@ RooRealIntegral::~RooRealIntegral()
   if (_numIntegrand) delete _numIntegrand ;
   if (_funcNormSet) delete _funcNormSet ;
   if (_params) delete _params ;
+  if (_branchNodes) delete _branchNodes ;
 
   TRACE_DESTROY
 }
@@ -832,6 +844,17 @@ Double_t RooRealIntegral::evaluate() const
     
   case Hybrid: 
     {      
+      // Look up results of recent integrations with the same parameters
+      const bool useMemo = _memoSize>0 && memoKey(_memoKey) ;
+      if (useMemo) {
+        auto found = std::find_if(_memo.begin(), _memo.end(),
+                                  [this](const MemoEntry& entry) { return entry.first == _memoKey ; }) ;
+        if (found != _memo.end()) {
+          retVal = found->second ;
+          break ;
+        }
+      }
+
       // Cache numeric integrals in >1d expensive object cache
       RooDouble* cacheVal(0) ;
       if ((_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim) {
@@ -879,6 +902,13 @@ Double_t RooRealIntegral::evaluate() const
         }
         
       }
+
+      if (useMemo) {
+        if (_memo.size() >= _memoSize) {
+          _memo.resize(_memoSize-1) ;
+        }
+        _memo.emplace_front(_memoKey,retVal) ;
+      }
       break ;
     }
   case Analytic:
@@ -1020,6 +1050,12 @@ Bool_t RooRealIntegral::redirectServersHook(const RooAbsCollection& /*newServerL
     delete _params ;
     _params = 0 ;
   }
+  if (_branchNodes) {
+    delete _branchNodes ;
+    _branchNodes = 0 ;
+  }
+
+  _memo.clear() ;
 
   return kFALSE ;
 }
@@ -1147,3 +1183,68 @@ Int_t RooRealIntegral::getCacheAllNumeric()
 {
   return _cacheAllNDim ;
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Global switch to set how many results of numeric integrations each integral
+/// remembers, see RooRealIntegral. Zero disables remembering results.
+
+void RooRealIntegral::setNumericMemoSize(std::size_t n)
+{
+  _memoSize = n ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return how many results of numeric integrations each integral remembers.
+
+std::size_t RooRealIntegral::getNumericMemoSize()
+{
+  return _memoSize ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill `key` with the values that the result of the numeric integration depends on:
+/// the values of the parameters and the limits of the numerically integrated observables.
+/// \return False if the result cannot be remembered, because a parameter is neither
+/// real-valued nor a category, or because some components of the function are deselected.
+
+bool RooRealIntegral::memoKey(std::vector<double>& key) const
+{
+  // With component selection active, the result depends on which components are selected.
+  // The branch nodes are collected once, and again only after a redirection of the servers.
+  if (!_globalSelectComp) {
+    if (!_branchNodes) {
+      _branchNodes = new RooArgSet("branchNodes") ;
+      RooArgSet branches ;
+      _function.arg().branchNodeServerList(&branches) ;
+      for (const auto arg : branches) {
+        if (dynamic_cast<const RooAbsReal*>(arg)) _branchNodes->add(*arg) ;
+      }
+    }
+    for (const auto arg : *_branchNodes) {
+      if (!static_cast<const RooAbsReal*>(arg)->isSelectedComp()) return false ;
+    }
+  }
+
+  key.clear() ;
+  for (const auto param : parameters()) {
+    if (auto real = dynamic_cast<const RooAbsReal*>(param)) {
+      key.push_back(real->getVal()) ;
+    } else if (auto cat = dynamic_cast<const RooAbsCategory*>(param)) {
+      key.push_back(cat->getCurrentIndex()) ;
+    } else {
+      return false ;
+    }
+  }
+
+  const char* rangeName = RooNameReg::str(_rangeName) ;
+  for (const auto arg : _intList) {
+    auto lvalue = static_cast<const RooAbsRealLValue*>(arg) ;
+    key.push_back(lvalue->getMin(rangeName)) ;
+    key.push_back(lvalue->getMax(rangeName)) ;
+  }
+  return true ;
+}
@@ -51,6 +51,8 @@ to the fractions of the various functions. **This requires setting the last argu
 #include "RooRealVar.h"
 #include "RooMsgService.h"
 #include "RooNaNPacker.h"
+#include "RooBatchCompute.h"
+#include "RooCodeGenContext.h"
 #include "RunContext.h"
 
 #include <TError.h>
@@ -266,31 +268,48 @@ Double_t RooRealSumPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code for the unnormalised sum of coef/func pairs. Normalisation
+/// is only supported in the binned likelihood mode, where the sum needs no integral.
+bool RooRealSumPdf::translate(RooCodeGenContext& ctx) const
+{
+  std::string result;
+  std::string sumCoeff;
+  for (unsigned int i = 0; i < _funcList.size(); ++i) {
+    const std::string coef = i < _coefList.size() ? ctx.getResult(_coefList[i])
+                                                  : "(1. - (" + (sumCoeff.empty() ? "0." : sumCoeff) + "))";
+    result += (result.empty() ? "" : " + ") + coef + " * " + ctx.getResult(_funcList[i]);
+    sumCoeff += (sumCoeff.empty() ? "" : " + ") + coef;
+  }
+
+  if (_doFloor || _doFloorGlobal) {
+    result = "TMath::Max(0., " + result + ")";
+  }
+  ctx.addResult(this, result);
+  return true;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate the value for all values of the observable in `evalData`.
 RooSpan<double> RooRealSumPdf::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* /*normSet*/) const {
-  // Do running sum of coef/func pairs, calculate lastCoef.
-  RooSpan<double> values;
+  // Collect coef/func pairs, calculate lastCoef.
+  std::vector<RooSpan<const double>> funcValues;
+  std::vector<double> coefs;
+  std::size_t batchSize = 0;
   double sumCoeff = 0.;
+  double nanPayload = 0.;
   for (unsigned int i = 0; i < _funcList.size(); ++i) {
     const auto func = static_cast<RooAbsReal*>(&_funcList[i]);
     const auto coef = static_cast<RooAbsReal*>(i < _coefList.size() ? &_coefList[i] : nullptr);
     const double coefVal = coef != nullptr ? coef->getVal() : (1. - sumCoeff);
 
     if (func->isSelectedComp()) {
-      auto funcValues = func->getValues(evalData, nullptr); // No normSet here, because we are summing functions!
-      if (values.empty() || (values.size() == 1 && funcValues.size() > 1)) {
-        const double init = values.empty() ? 0. : values[0];
-        values = evalData.makeBatch(this, funcValues.size());
-        for (unsigned int j = 0; j < values.size(); ++j) {
-          values[j] = init + funcValues[j] * coefVal;
-        }
-      } else {
-        assert(values.size() == funcValues.size());
-        for (unsigned int j = 0; j < values.size(); ++j) {
-          values[j] += funcValues[j] * coefVal;
-        }
-      }
+      auto values = func->getValues(evalData, nullptr); // No normSet here, because we are summing functions!
+      assert(batchSize <= 1 || values.size() <= 1 || values.size() == batchSize);
+      batchSize = std::max(batchSize, values.size());
+      funcValues.push_back(values);
+      coefs.push_back(coefVal);
     }
 
     // Warn about degeneration of last coefficient
@@ -301,17 +320,24 @@ RooSpan<double> RooRealSumPdf::evaluateSpan(RooBatchCompute::RunContext& evalDat
             << sumCoeff << ". This means that the PDF is not properly normalised. If the PDF was meant to be extended, provide as many coefficients as functions." << endl ;
         _haveWarned = true;
       }
-      // Signal that we are in an undefined region by handing back one NaN.
-      values[0] = RooNaNPacker::packFloatIntoNaN(100.f * (coefVal < 0. ? -coefVal : coefVal - 1.));
+      nanPayload = 100. * (coefVal < 0. ? -coefVal : coefVal - 1.);
     }
 
     sumCoeff += coefVal;
   }
 
+  auto values = evalData.makeBatch(this, batchSize);
+  RooBatchCompute::dispatch->computeCoefficientSum(batchSize, values.data(), funcValues, coefs);
+
+  // Signal that we are in an undefined region by handing back one NaN.
+  if (nanPayload != 0. && !values.empty()) {
+    values[0] = RooNaNPacker::packFloatIntoNaN(static_cast<float>(nanPayload));
+  }
+
   // Introduce floor if so requested
   if (_doFloor || _doFloorGlobal) {
-    for (unsigned int j = 0; j < values.size(); ++j) {
-      values[j] += std::max(0., values[j]);
+    for (double& val : values) {
+      val = std::max(0., val);
     }
   }
 
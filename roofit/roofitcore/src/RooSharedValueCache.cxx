@@ -0,0 +1,184 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file RooSharedValueCache.cxx
+\class RooSharedValueCache
+\ingroup Roofitcore
+
+Shares the values of functions between the clones of a model that the test statistics of the channels of a
+RooSimultaneous create.
+
+Every channel of a simultaneous likelihood evaluates its own clone of the model. Functions of the parameters that
+are used in several channels, like the response of a yield to a nuisance parameter, are therefore evaluated once per
+channel whenever a parameter changes. The test statistic registers such functions of all channels with a single
+RooSharedValueCache (see RooAbsTestStatistic::initSimMode()). When a registered function needs to be recomputed,
+RooAbsReal::getValV() asks the cache instead. The cache remembers the values of the parameters that the function
+(transitively) depends on. If none of them changed since the last computation in any of the channels, the stored
+value is returned. Otherwise, the function is evaluated and the result is stored for the other channels.
+
+Clones are identified by their name and class, and they need to depend on the very same parameter objects. Only
+functions that don't depend on the observables and that don't contain PDFs can be shared, see isEligible(). The
+number of hits and misses is available from statistics().
+**/
+
+#include "RooSharedValueCache.h"
+
+#include "RooAbsPdf.h"
+#include "RooAbsReal.h"
+#include "RooArgSet.h"
+#include "RooMsgService.h"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unregister all nodes. The cache must be destroyed before the nodes.
+RooSharedValueCache::~RooSharedValueCache()
+{
+  clear();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check whether the value of `node` can be shared between clones of the model. This is the case for functions
+/// (but not PDFs) that have servers, that depend neither on the `observables` nor on any PDF, that are not constant,
+/// and of which all leaves are real-valued.
+bool RooSharedValueCache::isEligible(const RooAbsReal& node, const RooArgSet& observables)
+{
+  if (dynamic_cast<const RooAbsPdf*>(&node) || node.isFundamental() || node.isConstant() ||
+      node.servers().empty() || node.dependsOnValue(observables)) {
+    return false;
+  }
+
+  RooArgSet branches;
+  node.branchNodeServerList(&branches);
+  for (const auto branch : branches) {
+    if (dynamic_cast<const RooAbsPdf*>(branch)) {
+      return false;
+    }
+  }
+
+  RooArgSet leaves;
+  node.leafNodeServerList(&leaves);
+  for (const auto leaf : leaves) {
+    if (!dynamic_cast<const RooAbsReal*>(leaf)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Share the value of `node` with the other registered nodes of the same name. The first node with a given name
+/// defines the parameters of the value. Nodes of different class or with different parameter objects are not
+/// registered, since they may not compute the same value.
+/// \return True if the node was registered.
+bool RooSharedValueCache::registerNode(RooAbsReal& node)
+{
+  if (node._sharedValueCache) {
+    return node._sharedValueCache == this;
+  }
+
+  RooArgSet leafSet;
+  node.leafNodeServerList(&leafSet);
+  std::vector<const RooAbsReal*> leaves;
+  for (const auto leaf : leafSet) {
+    leaves.push_back(static_cast<const RooAbsReal*>(leaf));
+  }
+  std::sort(leaves.begin(), leaves.end());
+
+  std::unique_ptr<Entry>& entry = _entries[node.GetName()];
+  if (!entry) {
+    entry = std::make_unique<Entry>();
+    entry->className = node.ClassName();
+    entry->leaves = leaves;
+    entry->leafValues.resize(leaves.size());
+  } else if (entry->className != node.ClassName() || entry->leaves != leaves) {
+    oocxcoutD(&node, Optimization) << "RooSharedValueCache: the value of " << node.GetName()
+                                   << " is not shared, because it differs from a function of the same name" << std::endl;
+    return false;
+  }
+
+  entry->nodes.push_back(&node);
+  _nodes[&node] = entry.get();
+  node._sharedValueCache = this;
+  return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unregister all nodes and forget all values.
+void RooSharedValueCache::clear()
+{
+  for (auto& item : _nodes) {
+    const_cast<RooAbsReal*>(item.first)->_sharedValueCache = nullptr;
+  }
+  _nodes.clear();
+  _entries.clear();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the value of `node`. It is only recomputed if the value of any of its leaves changed since it was last
+/// computed for any of the nodes that share the value.
+double RooSharedValueCache::getValue(const RooAbsReal& node)
+{
+  Entry& entry = *_nodes.at(&node);
+
+  bool changed = !entry.valid;
+  for (std::size_t i = 0; i < entry.leaves.size(); ++i) {
+    const double leafValue = entry.leaves[i]->getVal();
+    if (leafValue != entry.leafValues[i]) {
+      entry.leafValues[i] = leafValue;
+      changed = true;
+    }
+  }
+
+  if (!changed) {
+    ++entry.statistics.hits;
+    ++_statistics.hits;
+    return entry.value;
+  }
+
+  ++entry.statistics.misses;
+  ++_statistics.misses;
+  entry.value = node.traceEval(nullptr);
+  entry.valid = true;
+  return entry.value;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the hits and misses of the value shared by the nodes named `name`.
+RooSharedValueCache::Statistics RooSharedValueCache::statistics(const char* name) const
+{
+  auto found = _entries.find(name);
+  return found != _entries.end() ? found->second->statistics : Statistics{};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the hits and misses of all shared values.
+void RooSharedValueCache::printStatistics(std::ostream& os) const
+{
+  os << "RooSharedValueCache: " << _entries.size() << " values shared by " << _nodes.size() << " nodes, "
+     << _statistics.hits << " hits, " << _statistics.misses << " misses" << std::endl;
+  for (const auto& item : _entries) {
+    os << "  " << item.first << " (" << item.second->nodes.size() << " nodes): " << item.second->statistics.hits
+       << " hits, " << item.second->statistics.misses << " misses" << std::endl;
+  }
+}
@@ -20,7 +20,10 @@
 \ingroup Roofitcore
 
 RooStudyManager is a utility class to manage studies that consist of
-repeated applications of generate-and-fit operations on a workspace
+repeated applications of generate-and-fit operations on a workspace.
+The experiments can be run interactively with run(), in parallel in forked
+processes on the local machine with runLocal(), on PROOF with runProof(),
+or as batch jobs with prepareBatchInput() and processBatchOutput().
 
 **/
 
@@ -35,6 +38,8 @@ repeated applications of generate-and-fit operations on a workspace
 #include "RooDataSet.h"
 #include "RooMsgService.h"
 #include "RooStudyPackage.h"
+#include "RooRandom.h"
+#include "TBufferFile.h"
 #include "TFile.h"
 #include "TObjString.h"
 #include "TRegexp.h"
@@ -42,6 +47,17 @@ repeated applications of generate-and-fit operations on a workspace
 #include <string>
 #include "TROOT.h"
 #include "TSystem.h"
+#include "TRandom.h"
+
+#ifndef _WIN32
+#include "BidirMMapPipe.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
 
 using namespace std ;
 
@@ -137,6 +153,161 @@ void RooStudyManager::runProof(Int_t nExperiments, const char* proofHost, Bool_t
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run 'nExperiments' experiments in 'nWorkers' forked processes on the local machine, without PROOF.
+/// If 'nWorkers' is zero, the number of hardware threads is used. Each worker initializes its own
+/// copy of the studies once, like a PROOF worker, and receives the number of the next experiment as
+/// soon as it finished the previous one. Before each experiment, the random generators are seeded from
+/// the experiment number and a seed that is drawn once per run, so the same experiments are run regardless
+/// of the number of workers. When all experiments are done, the output of the workers is aggregated.
+/// \return kTRUE if the connection to a worker process was lost. The output is then not aggregated.
+
+Bool_t RooStudyManager::runLocal(Int_t nExperiments, Int_t nWorkers)
+{
+#ifdef _WIN32
+  coutW(Generation) << "RooStudyManager::runLocal(" << GetName() << ") worker processes are not available on Windows, running interactively" << endl ;
+  (void)nWorkers ;
+  run(nExperiments) ;
+  return kFALSE ;
+#else
+  using RooFit::BidirMMapPipe ;
+
+  if (nWorkers<=0) {
+    nWorkers = std::max(1u,std::thread::hardware_concurrency()) ;
+  }
+  nWorkers = std::min(nWorkers,nExperiments) ;
+  const UInt_t baseSeed = 1 + RooRandom::integer(1000000000) ;
+
+  coutP(Generation) << "RooStudyManager::runLocal(" << GetName() << ") starting " << nWorkers << " worker processes for "
+                    << nExperiments << " experiments" << endl ;
+  std::vector<std::unique_ptr<BidirMMapPipe>> pipes ;
+  for (Int_t i=0 ; i<nWorkers ; ++i) {
+    std::unique_ptr<BidirMMapPipe> pipe(new BidirMMapPipe()) ;
+    if (pipe->isChild()) {
+      // the pipes to the other workers were already closed in the child by BidirMMapPipe
+      for (auto& other : pipes) {
+        other.release() ;
+      }
+      workerLoop(*pipe,baseSeed,i) ;
+      pipe->close() ;
+      _exit(0) ;
+    }
+    pipes.push_back(std::move(pipe)) ;
+  }
+
+  Int_t nextExperiment = 0 ;
+  Int_t nRunning = 0 ;
+  BidirMMapPipe::PollVector poller ;
+  for (auto& pipe : pipes) {
+    *pipe << nextExperiment++ << BidirMMapPipe::flush ;
+    ++nRunning ;
+    poller.emplace_back(pipe.get(),BidirMMapPipe::Readable) ;
+  }
+
+  Int_t prescale = nExperiments>100 ? Int_t(nExperiments/100) : 1 ;
+  Bool_t error = kFALSE ;
+  std::set<BidirMMapPipe*> lost ; // workers that exited, nothing can be sent to them anymore
+  while (nRunning>0 && !error) {
+    if (BidirMMapPipe::poll(poller,-1)<0) {
+      coutE(Generation) << "RooStudyManager::runLocal(" << GetName() << ") ERROR polling the worker processes failed" << endl ;
+      error = kTRUE ;
+      break ;
+    }
+    for (auto& entry : poller) {
+      if (entry.revents & (BidirMMapPipe::Error | BidirMMapPipe::ReadEndOfFile | BidirMMapPipe::Invalid)) {
+        coutE(Generation) << "RooStudyManager::runLocal(" << GetName() << ") ERROR lost connection to worker process "
+                          << entry.pipe->pidOtherEnd() << endl ;
+        lost.insert(entry.pipe) ;
+        error = kTRUE ;
+      }
+    }
+    if (error) break ;
+
+    for (auto& entry : poller) {
+      if (!(entry.revents & BidirMMapPipe::Readable)) continue ;
+
+      Int_t done ;
+      *entry.pipe >> done ;
+      --nRunning ;
+      if (done%prescale==0) {
+        coutP(Generation) << "RooStudyManager::runLocal(" << GetName() << ") finished experiment " << done << "/" << nExperiments << endl ;
+      }
+      if (nextExperiment<nExperiments) {
+        *entry.pipe << nextExperiment++ << BidirMMapPipe::flush ;
+        ++nRunning ;
+      }
+    }
+  }
+
+  // Collect the output of all workers
+  TList olist ;
+  for (auto& pipe : pipes) {
+    if (!lost.count(pipe.get())) {
+      *pipe << -1 << BidirMMapPipe::flush ;
+    }
+    std::string output ;
+    if (!error) {
+      *pipe >> output ;
+    }
+    if (!output.empty()) {
+      TBufferFile buffer(TBuffer::kRead,output.size(),const_cast<char*>(output.data()),kFALSE) ;
+      std::unique_ptr<TList> workerList(static_cast<TList*>(buffer.ReadObject(TList::Class()))) ;
+      if (workerList) {
+        olist.AddAll(workerList.get()) ;
+      }
+    }
+    pipe->close() ;
+  }
+
+  if (error) {
+    coutE(Generation) << "RooStudyManager::runLocal(" << GetName() << ") ERROR not all experiments were completed" << endl ;
+    return kTRUE ;
+  }
+
+  coutP(Generation) << "RooStudyManager::runLocal(" << GetName() << ") aggregating results data" << endl ;
+  aggregateData(&olist) ;
+  olist.Delete() ;
+  return kFALSE ;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the experiments whose numbers the master process sends through 'pipe', until it sends a negative
+/// number. Then, send the output of the studies back.
+
+void RooStudyManager::workerLoop(RooFit::BidirMMapPipe& pipe, UInt_t baseSeed, Int_t workerId)
+{
+#ifndef _WIN32
+  _pkg->initialize() ;
+
+  Int_t experiment ;
+  while (pipe.good() && !pipe.eof()) {
+    pipe >> experiment ;
+    if (!pipe || experiment<0) break ;
+
+    RooRandom::randomGenerator()->SetSeed(baseSeed + experiment) ;
+    gRandom->SetSeed(baseSeed + experiment) ;
+    _pkg->runOne() ;
+    pipe << experiment << RooFit::BidirMMapPipe::flush ;
+  }
+
+  _pkg->finalize() ;
+  TList olist ;
+  _pkg->exportData(&olist,workerId) ;
+  TBufferFile buffer(TBuffer::kWrite) ;
+  buffer.WriteObject(&olist) ;
+  pipe << std::string(buffer.Buffer(),buffer.Length()) << RooFit::BidirMMapPipe::flush ;
+#else
+  (void)pipe ;
+  (void)baseSeed ;
+  (void)workerId ;
+#endif
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// "Option_t *option" takes the parameters forwarded to gProof->Close(option).
 ///
@@ -49,6 +49,8 @@ which returns spans pointing directly to the data.
 #include "TBuffer.h"
 
 #include <iomanip>
+#include <stdexcept>
+#include <string>
 using namespace std;
 
 ClassImp(RooVectorDataStore);
@@ -868,6 +870,25 @@ void RooVectorDataStore::reserve(Int_t nEvts)
 
 void RooVectorDataStore::append(RooAbsDataStore& other) 
 {
+  // Copy whole columns if both stores only hold the same unweighted real values
+  auto otherVec = dynamic_cast<RooVectorDataStore*>(&other) ;
+  if (otherVec && canAppendColumns() && otherVec->canAppendColumns() && _vars.size() == otherVec->_vars.size()) {
+    std::vector<RooSpan<const double>> columns ;
+    for (const auto var : _vars) {
+      const RooAbsArg* otherVar = otherVec->_vars.find(*var) ;
+      if (!otherVar) break ;
+      for (const auto realVec : otherVec->_realStoreList) {
+        if (realVec->bufArg() == otherVar) {
+          columns.push_back(realVec->getRange(0, realVec->size())) ;
+        }
+      }
+    }
+    if (columns.size() == _vars.size()) {
+      appendColumns(columns) ;
+      return ;
+    }
+  }
+
   Int_t nevt = other.numEntries() ;
   reserve(nevt + numEntries());
   for (int i=0 ; i<nevt ; i++) {  
@@ -882,6 +903,95 @@ void RooVectorDataStore::append(RooAbsDataStore& other)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Check whether rows can be added column by column with appendColumns(). This requires that all variables
+/// are real-valued without errors, and that the store is neither weighted nor has a filled cache.
+
+Bool_t RooVectorDataStore::canAppendColumns() const
+{
+  return !_wgtVar && !_extWgtArray && !_cache && _realfStoreList.empty() && _catStoreList.empty()
+      && _realStoreList.size() == _vars.size() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the vectors that hold the values of the variables, in the order of the variables in get().
+/// Throws std::invalid_argument if the rows cannot be added column by column.
+
+std::vector<RooVectorDataStore::RealVector*> RooVectorDataStore::columnTargets(std::size_t nColumns) const
+{
+  if (!canAppendColumns()) {
+    throw std::invalid_argument(std::string("RooVectorDataStore::appendColumns(") + GetName()
+        + "): columns can only be appended to stores of unweighted real values without errors.") ;
+  }
+  if (nColumns != _vars.size()) {
+    throw std::invalid_argument(std::string("RooVectorDataStore::appendColumns(") + GetName() + "): got "
+        + std::to_string(nColumns) + " columns for " + std::to_string(_vars.size()) + " variables.") ;
+  }
+
+  std::vector<RealVector*> targets ;
+  for (const auto var : _vars) {
+    auto found = std::find_if(_realStoreList.begin(), _realStoreList.end(),
+        [var](const RealVector* realVec) { return realVec->bufArg() == var; }) ;
+    if (found == _realStoreList.end()) {
+      throw std::invalid_argument(std::string("RooVectorDataStore::appendColumns(") + GetName()
+          + "): no storage for variable " + var->GetName()) ;
+    }
+    targets.push_back(*found) ;
+  }
+  return targets ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append rows given as one column of values per variable, in the order of the variables in get().
+/// This is much faster than setting the variables and calling fill() for each row, see canAppendColumns()
+/// for the requirements.
+
+void RooVectorDataStore::appendColumns(const std::vector<RooSpan<const double>>& columns)
+{
+  std::vector<RealVector*> targets = columnTargets(columns.size()) ;
+  const std::size_t nRows = columns.empty() ? 0 : columns.front().size() ;
+  for (const auto& column : columns) {
+    if (column.size() != nRows) {
+      throw std::invalid_argument(std::string("RooVectorDataStore::appendColumns(") + GetName()
+          + "): the columns have different lengths.") ;
+    }
+  }
+
+  for (std::size_t i = 0; i < targets.size(); ++i) {
+    targets[i]->append(columns[i]) ;
+  }
+  _sumWeight += nRows ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append rows given as one column of values per variable, in the order of the variables in get().
+/// If the store is empty, it takes over the memory of the columns without copying.
+
+void RooVectorDataStore::appendColumns(std::vector<std::vector<double>>&& columns)
+{
+  std::vector<RealVector*> targets = columnTargets(columns.size()) ;
+  const std::size_t nRows = columns.empty() ? 0 : columns.front().size() ;
+  for (const auto& column : columns) {
+    if (column.size() != nRows) {
+      throw std::invalid_argument(std::string("RooVectorDataStore::appendColumns(") + GetName()
+          + "): the columns have different lengths.") ;
+    }
+  }
+
+  for (std::size_t i = 0; i < targets.size(); ++i) {
+    targets[i]->append(std::move(columns[i])) ;
+  }
+  _sumWeight += nRows ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooVectorDataStore::reset() 
@@ -33,6 +33,14 @@ storing the source code of those classes in the workspace as well.
 This process is also organized by the workspace through the
 `importClassCode()` method.
 
+### Lazy loading of datasets
+Workspaces with large datasets can be read faster if only the datasets that are
+actually needed are read. After calling `setLazyData(true)`, writing the workspace
+stores each dataset as a separate key next to the workspace. When the workspace is
+read back, the datasets stay in the file until they are accessed with `data()` or
+`allData()`. They are then read from the file that the workspace was read from,
+which is opened again if it was closed in the meantime.
+
 ### Seemingly random crashes when reading large workspaces
 When reading or loading workspaces with deeply nested PDFs, one can encounter
 ouf-of-memory errors if the stack size is too small. This manifests in crashes
@@ -79,6 +87,7 @@ and try reading again.
 #include <map>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <iostream>
 #include <fstream>
 #include <cstring>
@@ -184,6 +193,7 @@ RooWorkspace::RooWorkspace(const RooWorkspace& other) :
   other._allOwnedNodes.snapshot(_allOwnedNodes,kTRUE) ;
 
   // Copy datasets
+  other.loadLazyData() ;
   for(TObject *data2 : other._dataList) _dataList.Add(data2->Clone());
 
   // Copy snapshots
@@ -240,6 +250,7 @@ RooWorkspace::~RooWorkspace()
   // WVE named sets too?
 
   _genObjects.Delete() ;
+  _lazyData.Delete() ;
 
    _embeddedDataList.Delete();
    _views.Delete();
@@ -780,6 +791,9 @@ Bool_t RooWorkspace::import(RooAbsData& inData,
   }
 
   // Check that no dataset with target name already exists
+  if (!embedded) {
+    loadLazyData(dsetName ? dsetName : inData.GetName()) ;
+  }
   if (dsetName && dataList.FindObject(dsetName)) {
     coutE(ObjectHandling) << "RooWorkspace::import(" << GetName() << ") ERROR dataset with name " << dsetName << " already exists in workspace, import aborted" << endl ;
     return kTRUE ;
@@ -1365,7 +1379,11 @@ RooAbsArg* RooWorkspace::fundArg(const char* name) const
 
 RooAbsData* RooWorkspace::data(const char* name) const
 {
-  return (RooAbsData*)_dataList.FindObject(name) ;
+  RooAbsData* ret = (RooAbsData*)_dataList.FindObject(name) ;
+  if (!ret && _lazyData.GetSize()>0) {
+    ret = loadLazyData(name) ;
+  }
+  return ret ;
 }
 
 
@@ -1514,6 +1532,7 @@ RooArgSet RooWorkspace::allPdfs() const
 
 list<RooAbsData*> RooWorkspace::allData() const
 {
+  loadLazyData() ;
   list<RooAbsData*> ret ;
   TIterator* iter = _dataList.MakeIterator() ;
   RooAbsData* dat ;
@@ -2158,6 +2177,72 @@ Bool_t RooWorkspace::writeToFile(const char* fileName, Bool_t recreate)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read datasets that were stored next to the workspace (see setLazyData()) from the file
+/// that the workspace was read from, and add them to the workspace. If `name` is given,
+/// only the dataset with this name is read, otherwise all of them.
+/// \return The dataset with the given name, or null if it is not available.
+
+RooAbsData* RooWorkspace::loadLazyData(const char* name) const
+{
+  if (_lazyData.GetSize()==0 || (name && !_lazyData.FindObject(name))) {
+    return nullptr ;
+  }
+
+  // Use the file if it is still open, otherwise open it again
+  std::unique_ptr<TFile> ownedFile ;
+  auto file = static_cast<TFile*>(gROOT->GetListOfFiles()->FindObject(_lazyDataFile.c_str())) ;
+  if (!file) {
+    ownedFile.reset(TFile::Open(_lazyDataFile.c_str(),"READ")) ;
+    file = ownedFile.get() ;
+  }
+  if (!file || file->IsZombie()) {
+    coutE(InputArguments) << "RooWorkspace::loadLazyData(" << GetName() << ") ERROR cannot open file '"
+                          << _lazyDataFile << "' to read datasets" << endl ;
+    return nullptr ;
+  }
+
+  // Loading data is not a logical change of the workspace
+  auto self = const_cast<RooWorkspace*>(this) ;
+  RooAbsData* ret = nullptr ;
+  std::vector<TObject*> entries ;
+  for (TObject* entry : _lazyData) {
+    entries.push_back(entry) ;
+  }
+  for (TObject* entry : entries) {
+    if (name && strcmp(entry->GetName(),name)!=0) continue ;
+
+    auto data2 = file->Get<RooAbsData>(entry->GetTitle()) ;
+    if (!data2) {
+      coutE(InputArguments) << "RooWorkspace::loadLazyData(" << GetName() << ") ERROR dataset " << entry->GetName()
+                            << " not found in file " << _lazyDataFile << endl ;
+    } else {
+      self->_dataList.Add(data2) ;
+      if (_dir) {
+        _dir->InternalAppend(data2) ;
+      }
+      if (_doExport) {
+        self->exportObj(data2) ;
+      }
+      for (const auto carg : *data2->get()) {
+        carg->setExpensiveObjectCache(self->expensiveObjectCache()) ;
+      }
+      ret = data2 ;
+    }
+
+    self->_lazyData.Remove(entry) ;
+    delete entry ;
+  }
+
+  if (_lazyData.GetSize()==0) {
+    self->_lazyDataFile.clear() ;
+  }
+
+  return ret ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return instance to factory tool
 
@@ -2375,6 +2460,15 @@ void RooWorkspace::Print(Option_t* opts) const
     cout << endl ;
   }
 
+  if (_lazyData.GetSize()>0) {
+    cout << "datasets not yet loaded from " << _lazyDataFile << endl ;
+    cout << "--------------------------" << endl ;
+    for (TObject* entry : _lazyData) {
+      cout << entry->GetName() << endl ;
+    }
+    cout << endl ;
+  }
+
   if (_embeddedDataList.GetSize()>0) {
     cout << "embedded datasets (in pdfs and functions)" << endl ;
     cout << "-----------------------------------------" << endl ;
@@ -2592,6 +2686,12 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 
       R__b.ReadClassBuffer(RooWorkspace::Class(),this);
 
+      // Datasets that were written next to the workspace are read on first access
+      auto file = dynamic_cast<TFile*>(R__b.GetParent()) ;
+      if (_lazyData.GetSize()>0 && file) {
+        _lazyDataFile = file->GetName() ;
+      }
+
       // Perform any pass-2 schema evolution here
       RooFIter fiter = _allOwnedNodes.fwdIterator() ;
       RooAbsArg* node ;
@@ -2623,6 +2723,12 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 
      map<RooAbsArg*,vector<RooAbsArg *> > extClients, extValueClients, extShapeClients ;
 
+     // Datasets that have not been loaded yet are written again
+     loadLazyData() ;
+
+     // Look up owned nodes by pointer, a linear search per client is quadratic in the size of the workspace
+     const std::unordered_set<const RooAbsArg*> ownedNodes(_allOwnedNodes.begin(), _allOwnedNodes.end()) ;
+
      TIterator* iter = _allOwnedNodes.createIterator() ;
      RooAbsArg* tmparg ;
      while((tmparg=(RooAbsArg*)iter->Next())) {
@@ -2630,7 +2736,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        // Loop over client list of this arg
        std::vector<RooAbsArg *> clientsTmp{tmparg->_clientList.begin(), tmparg->_clientList.end()};
        for (auto client : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*client)) {
+         if (ownedNodes.count(client) == 0) {
 
            const auto refCount = tmparg->_clientList.refCount(client);
            auto& bufferVec = extClients[tmparg];
@@ -2643,7 +2749,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        // Loop over value client list of this arg
        clientsTmp.assign(tmparg->_clientListValue.begin(), tmparg->_clientListValue.end());
        for (auto vclient : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*vclient)) {
+         if (ownedNodes.count(vclient) == 0) {
            cxcoutD(ObjectHandling) << "RooWorkspace::Streamer(" << GetName() << ") element " << tmparg->GetName()
 				       << " has external value client link to " << vclient << " (" << vclient->GetName() << ") with ref count " << tmparg->_clientListValue.refCount(vclient) << endl ;
 
@@ -2658,7 +2764,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        // Loop over shape client list of this arg
        clientsTmp.assign(tmparg->_clientListShape.begin(), tmparg->_clientListShape.end());
        for (auto sclient : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*sclient)) {
+         if (ownedNodes.count(sclient) == 0) {
            cxcoutD(ObjectHandling) << "RooWorkspace::Streamer(" << GetName() << ") element " << tmparg->GetName()
 				         << " has external shape client link to " << sclient << " (" << sclient->GetName() << ") with ref count " << tmparg->_clientListShape.refCount(sclient) << endl ;
 
@@ -2673,8 +2779,29 @@ void RooWorkspace::Streamer(TBuffer &R__b)
      }
      delete iter ;
 
+     // Write the datasets as separate keys, like RooTreeDataStore does with large trees,
+     // and only store their names in the workspace
+     RooLinkedList lazyData ;
+     auto parent = dynamic_cast<TDirectory*>(R__b.GetParent()) ;
+     if (_lazyDataWrite && parent) {
+       for (TObject* data2 : _dataList) {
+         const std::string keyName = std::string(GetName()) + "__" + data2->GetName() ;
+         parent->WriteObject(data2, keyName.c_str()) ;
+         _lazyData.Add(new TNamed(data2->GetName(), keyName.c_str())) ;
+         lazyData.Add(data2) ;
+       }
+       _dataList.Clear() ;
+     }
+
      R__b.WriteClassBuffer(RooWorkspace::Class(),this);
 
+     if (lazyData.GetSize()>0) {
+       for (TObject* data2 : lazyData) {
+         _dataList.Add(data2) ;
+       }
+       _lazyData.Delete() ;
+     }
+
      // Reinstate clients here
 
 
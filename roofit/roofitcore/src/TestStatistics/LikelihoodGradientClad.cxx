@@ -0,0 +1,311 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include "TestStatistics/LikelihoodGradientClad.h"
+
+#include "TestStatistics/RooAbsL.h"
+#include "TestStatistics/RooBinnedL.h"
+#include "TestStatistics/RooSubsidiaryL.h"
+#include "TestStatistics/RooSumL.h"
+#include "TestStatistics/RooUnbinnedL.h"
+#include "RooAbsData.h"
+#include "RooAbsPdf.h"
+#include "RooCodeGenContext.h"
+
+#include "TInterpreter.h"
+#include "TMath.h"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace RooFit {
+namespace TestStatistics {
+
+/** \class LikelihoodGradientClad
+ * \brief Calculates the gradient of a likelihood analytically, using code that is differentiated by Clad
+ *
+ * For each term of the likelihood, i.e. each RooUnbinnedL, RooBinnedL or RooSubsidiaryL, possibly inside a RooSumL,
+ * the computation graph of the pdf is translated to a C++ function of the parameter values by RooCodeGenContext.
+ * The values of the observables are copied into the function's input once, when the wrapper is created. The function
+ * is compiled by the interpreter, and Clad generates its gradient in reverse mode, such that one call yields the
+ * derivatives with respect to all parameters. Together with MinuitFcnGrad, this gives Minuit2 an analytical gradient
+ * instead of the numerical derivative of LikelihoodGradientJob:
+ * ~~~{.cpp}
+ * auto likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+ * auto m = RooMinimizer::create<RooFit::TestStatistics::LikelihoodSerial,
+ *                               RooFit::TestStatistics::LikelihoodGradientClad>(likelihood);
+ * m->migrad();
+ * ~~~
+ *
+ * Only classes that implement RooAbsReal::translate() can be part of the pdf, and their normalisation integrals need
+ * to be available in RooAbsReal::translateAnalyticalIntegral(). If any part of the likelihood cannot be translated,
+ * the constructor throws, and LikelihoodGradientJob should be used instead.
+ *
+ * \note Since the observables are copied when the wrapper is created, the dataset must not change during the fit.
+ */
+
+namespace {
+
+const std::size_t noMinuitIndex = std::numeric_limits<std::size_t>::max();
+
+std::string uniqueFunctionName()
+{
+   static std::size_t counter = 0;
+   return "roofit_clad_nll_" + std::to_string(counter++);
+}
+
+/// Collect the real-valued parameters, which are the inputs of the generated functions.
+RooArgList realParameters(const RooArgSet &candidates)
+{
+   RooArgList out;
+   for (const auto arg : candidates) {
+      if (dynamic_cast<const RooAbsReal *>(arg)) {
+         out.add(*arg);
+      }
+   }
+   return out;
+}
+
+} // namespace
+
+/*
+ * \param[in] likelihood Likelihood to be differentiated. All its terms are translated in the constructor.
+ * \param[in] calculation_is_clean Shared pointer to the clean flags, see LikelihoodGradientWrapper.
+ * \param[in] N_dim Number of parameters of the minimizer, i.e. size of the gradient.
+ * \param[in] minimizer Raw pointer to the minimizer that owns the MinuitFcnGrad object that owns this wrapper object.
+ */
+LikelihoodGradientClad::LikelihoodGradientClad(std::shared_ptr<RooAbsL> likelihood,
+                                               std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean,
+                                               std::size_t N_dim, RooMinimizer *minimizer)
+   : LikelihoodGradientWrapper(std::move(likelihood), std::move(calculation_is_clean), N_dim, minimizer), N_dim_(N_dim)
+{
+   addTerm(*likelihood_);
+}
+
+/// Translate one term of the likelihood to C++ and let Clad differentiate it. RooSumL components are added one by one.
+void LikelihoodGradientClad::addTerm(const RooAbsL &likelihood)
+{
+   if (auto sum = dynamic_cast<const RooSumL *>(&likelihood)) {
+      for (std::size_t ix = 0; ix < sum->getNComponents(); ++ix) {
+         addTerm(sum->getComponent(ix));
+      }
+      return;
+   }
+
+   auto term = std::make_shared<Term>();
+   const std::string name = uniqueFunctionName();
+   std::unique_ptr<RooCodeGenContext> ctx;
+   std::string loopResult;   // statements that add the contribution of one event to nll
+   std::string globalResult; // statements that add the contributions independent of the events to nll
+   std::size_t nEvents = 0;
+
+   if (auto subsidiary = dynamic_cast<const RooSubsidiaryL *>(&likelihood)) {
+      RooArgSet parameters;
+      for (const auto pdf : subsidiary->getSubsidiaryPdfs()) {
+         std::unique_ptr<RooArgSet> pdfParams{pdf->getParameters(RooArgSet())};
+         parameters.add(*pdfParams, /*silent=*/true);
+      }
+      term->parameters.add(realParameters(parameters));
+      ctx = std::make_unique<RooCodeGenContext>(name, RooArgSet(), subsidiary->getParameterSet(), term->parameters);
+      for (const auto pdf : subsidiary->getSubsidiaryPdfs()) {
+         globalResult += "nll -= TMath::Log(" + ctx->getNormalizedResult(static_cast<const RooAbsPdf &>(*pdf)) + ");\n";
+      }
+   } else if (dynamic_cast<const RooUnbinnedL *>(&likelihood) || dynamic_cast<const RooBinnedL *>(&likelihood)) {
+      RooAbsPdf *pdf = likelihood.getPdf();
+      RooAbsData *data = likelihood.getData();
+      std::unique_ptr<RooArgSet> parameters{pdf->getParameters(*data)};
+      term->parameters.add(realParameters(*parameters));
+      ctx = std::make_unique<RooCodeGenContext>(name, *data->get(), *likelihood.getNormSet(), term->parameters);
+
+      auto unbinned = dynamic_cast<const RooUnbinnedL *>(&likelihood);
+      auto binned = dynamic_cast<const RooBinnedL *>(&likelihood);
+      const bool weightSquared = unbinned && unbinned->applyWeightSquared();
+
+      // Select the events that contribute, like RooNLLVar::computeScalarFunc() and RooBinnedL::evaluatePartition()
+      std::vector<std::size_t> events;
+      double sumWeight = 0.;
+      double constantTerms = 0.;
+      for (Int_t i = 0; i < data->numEntries(); ++i) {
+         data->get(i);
+         if (!data->valid() || (unbinned && data->weight() == 0.)) {
+            continue;
+         }
+         events.push_back(i);
+         sumWeight += data->weight();
+         if (binned) {
+            constantTerms += TMath::LnGamma(data->weight() + 1.);
+         }
+      }
+      nEvents = events.size();
+
+      std::size_t currentEvent = 0;
+      const std::string weight =
+         ctx->addColumn([data, weightSquared]() { return weightSquared ? data->weightSquared() : data->weight(); });
+      if (binned) {
+         const std::vector<double> &binWidths = binned->getBinWidths();
+         const std::string binWidth = ctx->addColumn([&binWidths, &currentEvent]() { return binWidths[currentEvent]; });
+         const std::string mu = "(" + ctx->getNormalizedResult(*pdf) + " * " + binWidth + ")";
+         loopResult = "nll += " + mu + " - (" + weight + " == 0. ? 0. : " + weight + " * TMath::Log(" + mu + "));\n";
+         globalResult += "nll += " + RooCodeGenContext::literal(constantTerms) + ";\n";
+      } else {
+         loopResult = "nll -= " + weight + " * TMath::Log(" + ctx->getNormalizedResult(*pdf) + ");\n";
+
+         if (likelihood.isExtended()) {
+            if (weightSquared) {
+               ctx->fail(*pdf, "the extended term with squared weights is not supported");
+            }
+            std::string expected = pdf->translateExpectedEvents(*ctx);
+            if (expected.empty()) {
+               ctx->fail(*pdf, "no code generation implemented for the expected events of " +
+                                  std::string(pdf->ClassName()));
+               expected = "1.";
+            }
+            globalResult += "nll += " + expected + " - " + RooCodeGenContext::literal(data->sumEntries()) +
+                            " * TMath::Log(" + expected + ");\n";
+         }
+      }
+
+      // If part of simultaneous PDF normalize probability over number of simultaneous PDFs, see RooUnbinnedL
+      if (likelihood.getSimCount() > 1) {
+         globalResult += "nll += " + RooCodeGenContext::literal(sumWeight * std::log(1.0 * likelihood.getSimCount())) + ";\n";
+      }
+
+      term->obs.resize(ctx->numColumns() * nEvents);
+      for (std::size_t k = 0; k < nEvents; ++k) {
+         data->get(events[k]);
+         currentEvent = events[k];
+         ctx->fillColumns(term->obs.data() + k, nEvents);
+      }
+   } else {
+      throw std::runtime_error("LikelihoodGradientClad: the type of likelihood " + likelihood.GetName() +
+                               " is not supported.");
+   }
+
+   if (!ctx->isValid()) {
+      throw std::runtime_error("LikelihoodGradientClad: cannot generate the code for likelihood " +
+                               likelihood.GetName() + ": " + ctx->failure());
+   }
+
+   std::ostringstream code;
+   code << ctx->declarations();
+   code << "double " << name << "(double *params, double *obs) {\n";
+   code << "const int nEvents = " << nEvents << ";\n";
+   code << "double nll = 0.;\n";
+   code << ctx->globalCode();
+   if (!loopResult.empty()) {
+      code << "for (int i = 0; i < nEvents; ++i) {\n";
+      code << ctx->loopCode();
+      code << loopResult;
+      code << "}\n";
+   }
+   code << globalResult;
+   code << "return nll;\n";
+   code << "}\n";
+
+   jitTerm(*term, name, code.str());
+
+   term->params.resize(term->parameters.size());
+   term->minuit_index.assign(term->parameters.size(), noMinuitIndex);
+   terms_.push_back(std::move(term));
+}
+
+/// Compile the function `name` from `code`, and request its gradient with respect to `params` from Clad.
+void LikelihoodGradientClad::jitTerm(Term &term, const std::string &name, const std::string &code)
+{
+   static bool cladRuntimeIncluded = false;
+   if (!cladRuntimeIncluded) {
+      cladRuntimeIncluded = true;
+      gInterpreter->Declare("#include <Math/CladDerivator.h>\n#pragma clad OFF");
+   }
+
+   const std::string function = "#pragma cling optimize(2)\n" + code;
+   const std::string gradient = std::string("#pragma cling optimize(2)\n") + "#pragma clad ON\n" + "void " + name +
+                                "_req() {\n" + "clad::gradient(" + name + ", \"params\");\n" + "}\n" +
+                                "#pragma clad OFF\n" + "void " + name +
+                                "_grad_wrapper(double *params, double *obs, double *grad) {\n" + name +
+                                "_grad(params, obs, clad::array_ref<double>(grad, " +
+                                std::to_string(term.parameters.size()) + "));\n" + "}\n";
+
+   if (!gInterpreter->Declare(function.c_str()) || !gInterpreter->Declare(gradient.c_str())) {
+      throw std::runtime_error("LikelihoodGradientClad: the interpreter failed to compile the code for " + name +
+                               ":\n" + code);
+   }
+
+   term.function = reinterpret_cast<Function>(gInterpreter->ProcessLine(("&" + name + ";").c_str()));
+   term.gradient = reinterpret_cast<GradientFunction>(gInterpreter->ProcessLine(("&" + name + "_grad_wrapper;").c_str()));
+   if (!term.function || !term.gradient) {
+      throw std::runtime_error("LikelihoodGradientClad: cannot retrieve the generated functions for " + name);
+   }
+
+   code_ += code;
+}
+
+/// Match the parameters of the generated functions to the parameters of the minimizer by name.
+void LikelihoodGradientClad::synchronizeParameterSettings(
+   ROOT::Math::IMultiGenFunction * /*function*/, const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings)
+{
+   for (auto &term : terms_) {
+      for (std::size_t k = 0; k < term->parameters.size(); ++k) {
+         term->minuit_index[k] = noMinuitIndex;
+         for (std::size_t ix = 0; ix < parameter_settings.size(); ++ix) {
+            if (parameter_settings[ix].Name() == term->parameters[k].GetName()) {
+               term->minuit_index[k] = ix;
+               break;
+            }
+         }
+      }
+   }
+}
+
+/// Evaluate the generated functions at the current parameter values. Apart from the treatment of empty bins and
+/// evaluation errors, this is the value of the likelihood that the RooAbsL computes.
+double LikelihoodGradientClad::evaluate()
+{
+   double result = 0.;
+   for (auto &term : terms_) {
+      for (std::size_t k = 0; k < term->parameters.size(); ++k) {
+         term->params[k] = static_cast<const RooAbsReal &>(term->parameters[k]).getVal();
+      }
+      result += term->function(term->params.data(), term->obs.data());
+   }
+   return result;
+}
+
+/// Compute the gradient at the current values of the RooFit parameters, which MinuitFcnGrad has set to the
+/// Minuit-external values before calling this function.
+void LikelihoodGradientClad::fillGradient(double *grad)
+{
+   for (std::size_t ix = 0; ix < N_dim_; ++ix) {
+      grad[ix] = 0.;
+   }
+
+   for (auto &term : terms_) {
+      for (std::size_t k = 0; k < term->parameters.size(); ++k) {
+         term->params[k] = static_cast<const RooAbsReal &>(term->parameters[k]).getVal();
+      }
+      // Clad adds the derivatives to the output
+      term_grad_.assign(term->parameters.size(), 0.);
+      term->gradient(term->params.data(), term->obs.data(), term_grad_.data());
+      for (std::size_t k = 0; k < term->parameters.size(); ++k) {
+         if (term->minuit_index[k] != noMinuitIndex) {
+            grad[term->minuit_index[k]] += term_grad_[k];
+         }
+      }
+   }
+}
+
+} // namespace TestStatistics
+} // namespace RooFit
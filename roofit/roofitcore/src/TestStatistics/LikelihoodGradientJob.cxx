@@ -0,0 +1,88 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include "TestStatistics/LikelihoodGradientJob.h"
+#include "TestStatistics/MinuitFcnGrad.h" // WrapperCalculationCleanFlags
+
+#include "Minuit2/MnStrategy.h"
+
+namespace RooFit {
+namespace TestStatistics {
+
+/** \class LikelihoodGradientJob
+ * \brief Multi-process likelihood gradient calculation strategy implementation
+ *
+ * This class distributes the numerical partial derivatives of the likelihood over the worker processes of a
+ * LikelihoodWorkers pool. Every worker computes the derivatives with respect to its share of the parameters, with the
+ * same algorithm as Minuit2's numerical gradient calculator (ROOT::Minuit2::NumericalDerivator), so that the
+ * minimization follows the same path as in a serial fit. The step sizes and second derivatives of the previous
+ * gradient are kept in this class and sent along with each request, so that the workers hold no state of their own.
+ *
+ * \note The class is not intended for use by end-users. We recommend to either use RooMinimizer with a RooAbsL derived
+ * likelihood object, or to use a higher level entry point like RooAbsPdf::fitTo() or RooAbsPdf::createNLL().
+ */
+
+LikelihoodGradientJob::LikelihoodGradientJob(std::shared_ptr<RooAbsL> likelihood,
+                                             std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean,
+                                             std::size_t N_dim, RooMinimizer *minimizer)
+   : LikelihoodGradientWrapper(std::move(likelihood), std::move(calculation_is_clean), N_dim, minimizer),
+     workers_(LikelihoodWorkers::getInstance(likelihood_)), minuit_internal_x_(N_dim, 0), grad_(N_dim)
+{
+}
+
+void LikelihoodGradientJob::synchronizeWithMinimizer(const ROOT::Math::MinimizerOptions &options)
+{
+   ROOT::Minuit2::MnStrategy strategy(static_cast<unsigned int>(options.Strategy()));
+   options_.step_tolerance = strategy.GradientStepTolerance();
+   options_.grad_tolerance = strategy.GradientTolerance();
+   options_.n_cycles = strategy.GradientNCycles();
+   options_.error_level = options.ErrorDef();
+}
+
+void LikelihoodGradientJob::synchronizeParameterSettings(
+   ROOT::Math::IMultiGenFunction * /*function*/, const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings)
+{
+   parameter_settings_ = parameter_settings;
+   minuit_internal_x_.resize(parameter_settings_.size());
+   grad_.resize(parameter_settings_.size());
+   ROOT::Minuit2::NumericalDerivator derivator(options_.step_tolerance, options_.grad_tolerance, options_.n_cycles,
+                                               options_.error_level);
+   derivator.SetInitialGradient(nullptr, parameter_settings_, grad_);
+}
+
+void LikelihoodGradientJob::updateMinuitInternalParameterValues(const std::vector<double> &minuit_internal_x)
+{
+   minuit_internal_x_ = minuit_internal_x;
+}
+
+/// The workers evaluate their own copies of the likelihood, which must be optimized like the one in this process.
+void LikelihoodGradientJob::constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt)
+{
+   workers_->constOptimizeTestStatistic(opcode, doAlsoTrackingOpt);
+}
+
+void LikelihoodGradientJob::fillGradient(double *grad)
+{
+   if (!calculation_is_clean_->gradient) {
+      workers_->calculateGradient(minuit_internal_x_, parameter_settings_, options_, grad_);
+      calculation_is_clean_->gradient = true;
+   }
+
+   for (std::size_t ix = 0; ix < grad_.size(); ++ix) {
+      grad[ix] = grad_[ix].derivative;
+   }
+}
+
+} // namespace TestStatistics
+} // namespace RooFit
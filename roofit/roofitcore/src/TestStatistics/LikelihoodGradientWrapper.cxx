@@ -56,6 +56,7 @@ void LikelihoodGradientWrapper::synchronizeParameterSettings(
 
 void LikelihoodGradientWrapper::updateMinuitInternalParameterValues(const std::vector<double>& /*minuit_internal_x*/) {}
 void LikelihoodGradientWrapper::updateMinuitExternalParameterValues(const std::vector<double>& /*minuit_external_x*/) {}
+void LikelihoodGradientWrapper::constOptimizeTestStatistic(RooAbsArg::ConstOpCode /*opcode*/, bool /*doAlsoTrackingOpt*/) {}
 
 } // namespace TestStatistics
 } // namespace RooFit
@@ -0,0 +1,56 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include <TestStatistics/LikelihoodJob.h>
+#include <TestStatistics/LikelihoodWorkers.h>
+#include <TestStatistics/RooAbsL.h>
+
+namespace RooFit {
+namespace TestStatistics {
+
+/** \class LikelihoodJob
+ * \brief Multi-process likelihood calculation strategy implementation
+ *
+ * This class distributes the evaluation of the likelihood over the worker processes of a LikelihoodWorkers pool,
+ * which split the events (or, for simultaneous likelihoods, possibly the components) among them. The partial sums
+ * are added as KahanSums, after which offsetting is applied exactly as in LikelihoodSerial. Like RooRealMPFE,
+ * which it replaces in the RooFit::TestStatistics framework, it is based on forked processes, so that no
+ * serialization of the likelihood is necessary.
+ *
+ * \note The class is not intended for use by end-users. We recommend to either use RooMinimizer with a RooAbsL derived
+ * likelihood object, or to use a higher level entry point like RooAbsPdf::fitTo() or RooAbsPdf::createNLL().
+ */
+
+LikelihoodJob::LikelihoodJob(std::shared_ptr<RooAbsL> likelihood,
+                             std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean)
+   : LikelihoodWrapper(std::move(likelihood), std::move(calculation_is_clean)),
+     workers_(LikelihoodWorkers::getInstance(likelihood_))
+{
+}
+
+void LikelihoodJob::evaluate()
+{
+   result = workers_->evaluate();
+   result = applyOffsetting(result);
+}
+
+/// Optimize the likelihood in this process, then in the workers.
+void LikelihoodJob::constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt)
+{
+   LikelihoodWrapper::constOptimizeTestStatistic(opcode, doAlsoTrackingOpt);
+   workers_->constOptimizeTestStatistic(opcode, doAlsoTrackingOpt);
+}
+
+} // namespace TestStatistics
+} // namespace RooFit
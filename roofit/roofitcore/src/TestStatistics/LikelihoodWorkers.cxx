@@ -0,0 +1,441 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include "TestStatistics/LikelihoodWorkers.h"
+#include "TestStatistics/RooAbsL.h"
+#include "TestStatistics/RooSubsidiaryL.h"
+#include "TestStatistics/RooSumL.h"
+#include "RooAbsCategoryLValue.h"
+#include "RooAbsReal.h"
+#include "RooMsgService.h"
+#include "RooRealVar.h"
+
+#include "../BidirMMapPipe.h"
+
+#include "Math/Functor.h"
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace RooFit {
+namespace TestStatistics {
+
+/** \class LikelihoodWorkers
+ * \brief Pool of forked processes that evaluate parts of a likelihood and of its gradient
+ *
+ * The pool is shared by LikelihoodJob and LikelihoodGradientJob. The worker processes are forked, like in RooRealMPFE,
+ * on the first request, so that they start from a copy of the likelihood including all constant term optimizations
+ * done until then. Communication goes through a BidirMMapPipe per worker, i.e. through shared memory pages and a
+ * local pipe. With every request, the master sends the current values of all parameters of the likelihood, preceded
+ * by the constant term optimizations of the likelihood done since the previous request.
+ *
+ * Likelihood evaluations are split over events: worker `i` of `N` evaluates the fraction [i/N, (i+1)/N) of the
+ * events. Simultaneous likelihoods with at least as many components as there are workers are instead split over
+ * components, and RooSubsidiaryL components, which have no events, are always evaluated as a whole by one worker.
+ * Gradients are split over parameters: every worker computes the numerical partial derivatives of its share of the
+ * parameters with the same ROOT::Minuit2::NumericalDerivator algorithm that Minuit2 uses itself, evaluating the full
+ * likelihood in its own process.
+ *
+ * When the number of workers is zero, and on Windows, where forking is not available, all calculations are done in
+ * the calling process.
+ *
+ * \note The class is not intended for use by end-users. Use setDefaultNWorkers() to configure the number of workers
+ * created for new likelihoods.
+ */
+
+namespace {
+
+std::size_t &defaultNWorkers()
+{
+   static std::size_t n_workers = std::max(1u, std::thread::hardware_concurrency());
+   return n_workers;
+}
+
+} // namespace
+
+/// Get the pool of workers for this likelihood, creating it if none exists yet. LikelihoodJob and LikelihoodGradientJob
+/// objects for the same likelihood thus share their workers.
+std::shared_ptr<LikelihoodWorkers> LikelihoodWorkers::getInstance(const std::shared_ptr<RooAbsL> &likelihood)
+{
+   static std::mutex registry_mutex;
+   static std::map<const RooAbsL *, std::weak_ptr<LikelihoodWorkers>> registry;
+
+   std::lock_guard<std::mutex> lock(registry_mutex);
+   auto &entry = registry[likelihood.get()];
+   auto workers = entry.lock();
+   if (!workers) {
+      workers = std::make_shared<LikelihoodWorkers>(likelihood, getDefaultNWorkers());
+      entry = workers;
+   }
+   return workers;
+}
+
+/// Set the number of worker processes of pools that are created from now on. Zero means no parallelization.
+void LikelihoodWorkers::setDefaultNWorkers(std::size_t n_workers)
+{
+   defaultNWorkers() = n_workers;
+}
+
+/// The number of worker processes of new pools. Defaults to the number of hardware threads.
+std::size_t LikelihoodWorkers::getDefaultNWorkers()
+{
+   return defaultNWorkers();
+}
+
+LikelihoodWorkers::LikelihoodWorkers(std::shared_ptr<RooAbsL> likelihood, std::size_t n_workers)
+   : likelihood_(std::move(likelihood)), n_workers_(n_workers)
+{
+#ifdef _WIN32
+   n_workers_ = 0;
+#endif
+   std::unique_ptr<RooArgSet> parameters{likelihood_->getParameters()};
+   parameters_.add(*parameters);
+}
+
+LikelihoodWorkers::~LikelihoodWorkers()
+{
+   terminate();
+}
+
+/// Fork the worker processes, if they are not running yet.
+void LikelihoodWorkers::start()
+{
+#ifndef _WIN32
+   if (!pipes_.empty()) {
+      return;
+   }
+
+   // Clear the eval error log prior to forking to avoid confusions
+   RooAbsReal::clearEvalErrorLog();
+   for (std::size_t worker_id = 0; worker_id < n_workers_; ++worker_id) {
+      std::unique_ptr<BidirMMapPipe> pipe{new BidirMMapPipe()};
+      if (pipe->isChild()) {
+         // the pipes to the other workers were already closed in the child by BidirMMapPipe
+         for (auto &other : pipes_) {
+            other.release();
+         }
+         pipes_.clear();
+         pipes_.push_back(std::move(pipe));
+         workerLoop(worker_id);
+         pipes_.front()->close();
+         _exit(0);
+      }
+      pipes_.push_back(std::move(pipe));
+   }
+#endif // _WIN32
+}
+
+/// Stop the worker processes.
+void LikelihoodWorkers::terminate()
+{
+#ifndef _WIN32
+   for (auto &pipe : pipes_) {
+      *pipe << static_cast<int>(Message::terminate) << BidirMMapPipe::flush;
+      pipe->close();
+   }
+   pipes_.clear();
+   pending_const_optimizations_.clear();
+#endif // _WIN32
+}
+
+/// Serve requests from the master process until it asks to terminate.
+void LikelihoodWorkers::workerLoop(std::size_t worker_id)
+{
+   BidirMMapPipe &pipe = *pipes_.front();
+   int msg;
+   while (pipe.good() && !pipe.eof()) {
+      pipe >> msg;
+      if (!pipe) {
+         return;
+      }
+      switch (static_cast<Message>(msg)) {
+      case Message::terminate: {
+         return;
+      }
+      case Message::evaluate: {
+         receiveParameterValues(pipe);
+         auto result = evaluatePartition(worker_id, n_workers_);
+         pipe << result.Sum() << result.Carry() << static_cast<std::size_t>(RooAbsReal::numEvalErrors())
+              << BidirMMapPipe::flush;
+         RooAbsReal::clearEvalErrorLog();
+         break;
+      }
+      case Message::constOptimize: {
+         int opcode;
+         bool doAlsoTrackingOpt;
+         pipe >> opcode >> doAlsoTrackingOpt;
+         receiveParameterValues(pipe);
+         likelihood_->constOptimizeTestStatistic(static_cast<RooAbsArg::ConstOpCode>(opcode), doAlsoTrackingOpt);
+         break;
+      }
+      case Message::gradient: {
+         receiveParameterValues(pipe);
+         DerivatorOptions options;
+         std::size_t n_dim;
+         pipe >> options.step_tolerance >> options.grad_tolerance >> options.n_cycles >> options.error_level >> n_dim;
+         std::vector<ROOT::Fit::ParameterSettings> parameter_settings(n_dim);
+         std::vector<std::size_t> parameter_indices(n_dim);
+         std::vector<double> minuit_internal_x(n_dim);
+         std::vector<ROOT::Minuit2::DerivatorElement> gradient(n_dim);
+         for (std::size_t ix = 0; ix < n_dim; ++ix) {
+            double value, step, lower, upper;
+            bool has_lower, has_upper;
+            pipe >> parameter_indices[ix] >> value >> step >> has_lower >> lower >> has_upper >> upper;
+            auto &settings = parameter_settings[ix];
+            settings.Set(parameters_.at(parameter_indices[ix])->GetName(), value, step);
+            if (has_lower && has_upper) {
+               settings.SetLimits(lower, upper);
+            } else if (has_lower) {
+               settings.SetLowerLimit(lower);
+            } else if (has_upper) {
+               settings.SetUpperLimit(upper);
+            }
+            pipe >> minuit_internal_x[ix] >> gradient[ix].derivative >> gradient[ix].second_derivative >>
+               gradient[ix].step_size;
+         }
+
+         calculatePartialDerivatives(worker_id, n_workers_, minuit_internal_x, parameter_settings, parameter_indices,
+                                     options, gradient);
+
+         for (std::size_t ix = worker_id; ix < n_dim; ix += n_workers_) {
+            pipe << gradient[ix].derivative << gradient[ix].second_derivative << gradient[ix].step_size;
+         }
+         pipe << static_cast<std::size_t>(RooAbsReal::numEvalErrors()) << BidirMMapPipe::flush;
+         RooAbsReal::clearEvalErrorLog();
+         break;
+      }
+      default: {
+         oocoutE(static_cast<RooAbsArg *>(nullptr), Minimization)
+            << "LikelihoodWorkers::workerLoop: unknown message (code = " << msg << ")" << std::endl;
+         return;
+      }
+      }
+   }
+}
+
+void LikelihoodWorkers::sendParameterValues(BidirMMapPipe &pipe) const
+{
+   for (const auto arg : parameters_) {
+      if (auto var = dynamic_cast<const RooAbsReal *>(arg)) {
+         pipe << var->getVal();
+      } else if (auto cat = dynamic_cast<const RooAbsCategory *>(arg)) {
+         pipe << cat->getCurrentIndex();
+      }
+   }
+}
+
+void LikelihoodWorkers::sendConstOptimizations(BidirMMapPipe &pipe) const
+{
+   for (const auto &optimization : pending_const_optimizations_) {
+      // the caches of constant terms are filled with the current parameter values
+      pipe << static_cast<int>(Message::constOptimize) << static_cast<int>(optimization.first) << optimization.second;
+      sendParameterValues(pipe);
+   }
+}
+
+void LikelihoodWorkers::receiveParameterValues(BidirMMapPipe &pipe)
+{
+   for (const auto arg : parameters_) {
+      if (auto var = dynamic_cast<RooRealVar *>(arg)) {
+         double value;
+         pipe >> value;
+         var->setVal(value);
+      } else if (dynamic_cast<RooAbsReal *>(arg)) {
+         // not settable, but the master sent its value anyway
+         double value;
+         pipe >> value;
+      } else if (auto cat = dynamic_cast<RooAbsCategory *>(arg)) {
+         RooAbsCategory::value_type index;
+         pipe >> index;
+         if (auto cat_lvalue = dynamic_cast<RooAbsCategoryLValue *>(cat)) {
+            cat_lvalue->setIndex(index);
+         }
+      }
+   }
+}
+
+/// Errors cannot be transported with their context from the workers, so each worker that reported errors is logged
+/// as one error in the master. This is enough for MinuitFcnGrad to notice the error status.
+std::size_t LikelihoodWorkers::collectEvalErrors(BidirMMapPipe &pipe) const
+{
+   std::size_t n_errors;
+   pipe >> n_errors;
+   if (n_errors > 0) {
+      const std::string message = std::to_string(n_errors) + " evaluation errors in worker process " +
+                                  std::to_string(pipe.pidOtherEnd());
+      RooAbsReal::logEvalError(nullptr, likelihood_->GetName().c_str(), message.c_str());
+   }
+   return n_errors;
+}
+
+/// Evaluate the part of the likelihood that belongs to worker `worker_id` out of `n_workers`. With `n_workers = 1`,
+/// the whole likelihood is evaluated.
+ROOT::Math::KahanSum<double> LikelihoodWorkers::evaluatePartition(std::size_t worker_id, std::size_t n_workers)
+{
+   RooAbsL::Section events(static_cast<double>(worker_id) / n_workers,
+                           static_cast<double>(worker_id + 1) / n_workers);
+
+   auto sum_likelihood = dynamic_cast<RooSumL *>(likelihood_.get());
+   if (sum_likelihood == nullptr) {
+      if (dynamic_cast<RooSubsidiaryL *>(likelihood_.get()) != nullptr) {
+         return worker_id == 0 ? likelihood_->evaluatePartition({0, 1}, 0, 0) : ROOT::Math::KahanSum<double>{};
+      }
+      return likelihood_->evaluatePartition(events, 0, 0);
+   }
+
+   ROOT::Math::KahanSum<double> result;
+   const std::size_t n_components = likelihood_->getNComponents();
+   for (std::size_t ix = 0; ix < n_components; ++ix) {
+      if (n_components >= n_workers || sum_likelihood->getComponent(ix).numDataEntries() == 0) {
+         if (ix % n_workers == worker_id) {
+            result += likelihood_->evaluatePartition({0, 1}, ix, ix + 1);
+         }
+      } else {
+         result += likelihood_->evaluatePartition(events, ix, ix + 1);
+      }
+   }
+   return result;
+}
+
+/// Calculate the partial derivatives with respect to the parameters that belong to worker `worker_id` out of
+/// `n_workers`, i.e. every `n_workers`-th one. The likelihood is evaluated fully in the calling process.
+void LikelihoodWorkers::calculatePartialDerivatives(std::size_t worker_id, std::size_t n_workers,
+                                                    const std::vector<double> &minuit_internal_x,
+                                                    const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings,
+                                                    const std::vector<std::size_t> &parameter_indices,
+                                                    const DerivatorOptions &options,
+                                                    std::vector<ROOT::Minuit2::DerivatorElement> &gradient)
+{
+   const std::size_t n_dim = parameter_indices.size();
+   ROOT::Math::Functor function(
+      [&](const double *x) {
+         for (std::size_t ix = 0; ix < n_dim; ++ix) {
+            static_cast<RooRealVar *>(parameters_.at(parameter_indices[ix]))->setVal(x[ix]);
+         }
+         return evaluatePartition(0, 1).Sum();
+      },
+      n_dim);
+
+   ROOT::Minuit2::NumericalDerivator derivator(options.step_tolerance, options.grad_tolerance, options.n_cycles,
+                                               options.error_level);
+   // the likelihood at the central point is evaluated only once, for all partial derivatives
+   derivator.SetupDifferentiate(&function, minuit_internal_x.data(), parameter_settings);
+   for (std::size_t ix = worker_id; ix < n_dim; ix += n_workers) {
+      gradient[ix] = derivator.FastPartialDerivative(&function, parameter_settings, ix, gradient[ix]);
+   }
+}
+
+/// Apply a constant term optimization, which was done on the likelihood in the master process, also in the workers.
+/// Like the parameter values, it is sent along with the next request. Workers that are not running yet are forked
+/// from the optimized likelihood, so nothing needs to be sent to them. Both LikelihoodJob and LikelihoodGradientJob
+/// forward the optimizations to their pool, so an identical optimization without a request in between is only sent
+/// once.
+void LikelihoodWorkers::constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt)
+{
+   if (pipes_.empty()) {
+      return;
+   }
+   const std::pair<RooAbsArg::ConstOpCode, bool> optimization{opcode, doAlsoTrackingOpt};
+   if (pending_const_optimizations_.empty() || pending_const_optimizations_.back() != optimization) {
+      pending_const_optimizations_.push_back(optimization);
+   }
+}
+
+/// Evaluate the likelihood at the current values of its parameters.
+ROOT::Math::KahanSum<double> LikelihoodWorkers::evaluate()
+{
+   if (n_workers_ == 0) {
+      return evaluatePartition(0, 1);
+   }
+
+   start();
+   for (auto &pipe : pipes_) {
+      sendConstOptimizations(*pipe);
+      *pipe << static_cast<int>(Message::evaluate);
+      sendParameterValues(*pipe);
+      *pipe << BidirMMapPipe::flush;
+   }
+   pending_const_optimizations_.clear();
+
+   ROOT::Math::KahanSum<double> result;
+   for (auto &pipe : pipes_) {
+      double sum, carry;
+      *pipe >> sum >> carry;
+      // the carry is what was lost from the sum, so it is subtracted
+      result += sum;
+      result += -carry;
+      collectEvalErrors(*pipe);
+   }
+   return result;
+}
+
+/// Calculate the gradient of the likelihood with respect to the parameters described by `parameter_settings`.
+/// \param[in] minuit_internal_x The parameter values, in Minuit-internal coordinates.
+/// \param[in] parameter_settings The parameter settings of the minimizer; the parameters are found by name.
+/// \param[in] options Settings of the numerical derivator.
+/// \param[in,out] gradient The gradient of the previous step, which is used as starting point, and the result.
+void LikelihoodWorkers::calculateGradient(const std::vector<double> &minuit_internal_x,
+                                          const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings,
+                                          const DerivatorOptions &options,
+                                          std::vector<ROOT::Minuit2::DerivatorElement> &gradient)
+{
+   const std::size_t n_dim = parameter_settings.size();
+   std::vector<std::size_t> parameter_indices(n_dim);
+   for (std::size_t ix = 0; ix < n_dim; ++ix) {
+      const int index = parameters_.index(parameter_settings[ix].Name().c_str());
+      if (index < 0) {
+         throw std::logic_error("in LikelihoodWorkers::calculateGradient: parameter " + parameter_settings[ix].Name() +
+                                " is not a parameter of the likelihood!");
+      }
+      parameter_indices[ix] = index;
+   }
+
+   if (n_workers_ == 0) {
+      // The derivator changes the parameters; in the workers, they are set again before every request
+      std::unique_ptr<RooArgList> saved{static_cast<RooArgList *>(parameters_.snapshot(false))};
+      calculatePartialDerivatives(0, 1, minuit_internal_x, parameter_settings, parameter_indices, options, gradient);
+      parameters_.assignValueOnly(*saved);
+      return;
+   }
+
+   start();
+   for (auto &pipe : pipes_) {
+      sendConstOptimizations(*pipe);
+      *pipe << static_cast<int>(Message::gradient);
+      sendParameterValues(*pipe);
+      *pipe << options.step_tolerance << options.grad_tolerance << options.n_cycles << options.error_level << n_dim;
+      for (std::size_t ix = 0; ix < n_dim; ++ix) {
+         const auto &settings = parameter_settings[ix];
+         *pipe << parameter_indices[ix] << settings.Value() << settings.StepSize() << settings.HasLowerLimit()
+               << settings.LowerLimit() << settings.HasUpperLimit() << settings.UpperLimit();
+         *pipe << minuit_internal_x[ix] << gradient[ix].derivative << gradient[ix].second_derivative
+               << gradient[ix].step_size;
+      }
+      *pipe << BidirMMapPipe::flush;
+   }
+   pending_const_optimizations_.clear();
+
+   for (std::size_t worker_id = 0; worker_id < n_workers_; ++worker_id) {
+      auto &pipe = *pipes_[worker_id];
+      for (std::size_t ix = worker_id; ix < n_dim; ix += n_workers_) {
+         pipe >> gradient[ix].derivative >> gradient[ix].second_derivative >> gradient[ix].step_size;
+      }
+      collectEvalErrors(pipe);
+   }
+}
+
+} // namespace TestStatistics
+} // namespace RooFit
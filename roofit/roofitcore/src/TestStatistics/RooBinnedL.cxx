@@ -26,6 +26,17 @@ Class RooBinnedL implements a -log(likelihood) calculation from a dataset
 \f]
 In extended mode, a
 \f$ N_\mathrm{expect} - N_\mathrm{observed}*log(N_\mathrm{expect}) \f$ term is added.
+For templates with many empty bins, the Poisson term of an empty bin reduces to the
+expected yield \f$ \mu_i \f$ of that bin. If the integral of the model over the observable
+is analytic, the sum of the expected yields of all bins is computed with one integral, and
+the model only needs to be evaluated in the non-empty bins:
+\f[
+ \sum_\mathrm{bins} -\log \mathrm{Poisson}(N_i|\mu_i) = \mu_\mathrm{tot}
+   + \sum_{N_i \neq 0} \left( -N_i \log(\mu_i) + \log \Gamma(N_i+1) \right).
+\f]
+This is done automatically when at least a quarter of the bins are empty and when the
+integral matches the sum of the bin yields (see usesSparseBins()). In this case, the total
+yield is added to the section that contains the first bin.
 **/
 
 #include <TestStatistics/RooBinnedL.h>
@@ -33,12 +44,16 @@ In extended mode, a
 #include "RooAbsData.h"
 #include "RooAbsPdf.h"
 #include "RooAbsDataStore.h"
+#include "RooRealIntegral.h"
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
 
 #include "TMath.h"
 #include "Math/Util.h" // KahanSum
 
+#include <algorithm>
+#include <cmath>
+
 namespace RooFit {
 namespace TestStatistics {
 
@@ -55,7 +70,7 @@ RooBinnedL::RooBinnedL(RooAbsPdf *pdf, RooAbsData *data)
    // The Active label will disable pdf integral calculations
    pdf->setAttribute("BinnedLikelihoodActive");
 
-   RooArgSet *obs = pdf->getObservables(data);
+   std::unique_ptr<RooArgSet> obs{pdf->getObservables(data)};
    if (obs->getSize() != 1) {
       throw std::logic_error(
          "RooBinnedL can only be created from combination of pdf and data which has exactly one observable!");
@@ -74,6 +89,56 @@ RooBinnedL::RooBinnedL(RooAbsPdf *pdf, RooAbsData *data)
          ++biter;
       }
    }
+
+   initSparseBins(*obs);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// Find the non-empty bins and set up the integral that yields the sum of the expected
+/// yields of all bins. The sparse evaluation is only enabled if this pays off, i.e. if
+/// at least a quarter of the bins are empty, and if the integral is analytic and agrees
+/// with the sum of the bin yields, which is the case for models made of histograms
+/// with the same binning.
+void RooBinnedL::initSparseBins(const RooArgSet &observables)
+{
+   if (_binw.size() != N_events_) {
+      return;
+   }
+
+   ROOT::Math::KahanSum<double> sumYields;
+   for (std::size_t i = 0; i < N_events_; ++i) {
+      data_->get(i);
+      if (!data_->valid()) {
+         return;
+      }
+      const double N = data_->weight();
+      if (N != 0.) {
+         _nonEmptyBins.push_back(i);
+         _nonEmptyWeights.push_back(N);
+         _lnGammaWeights.push_back(TMath::LnGamma(N + 1));
+      }
+      sumYields += pdf_->getVal() * _binw[i];
+   }
+
+   if (4 * _nonEmptyBins.size() > 3 * N_events_) {
+      return;
+   }
+
+   std::unique_ptr<RooAbsReal> totalYield{pdf_->createIntegral(observables)};
+   auto integral = dynamic_cast<RooRealIntegral *>(totalYield.get());
+   if (integral && (integral->numIntRealVars().getSize() > 0 || integral->numIntCatVars().getSize() > 0)) {
+      return;
+   }
+   const double total = totalYield->getVal();
+   if (std::abs(total - sumYields.Sum()) > 1e-9 * std::abs(total)) {
+      oocxcoutD(static_cast<RooAbsArg *>(nullptr), Minimization)
+         << "RooBinnedL: integral of " << pdf_->GetName() << " does not match the sum of the bin yields,"
+         << " evaluating all bins" << std::endl;
+      return;
+   }
+
+   _totalYield = std::move(totalYield);
+   _terms.resize(_nonEmptyBins.size());
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +160,10 @@ RooBinnedL::evaluatePartition(Section bins, std::size_t /*components_begin*/, st
    // TODO: check when we might need _projDeps (it seems to be mostly empty); ties in with TODO below
    data_->store()->recalculateCache(nullptr, bins.begin(N_events_), bins.end(N_events_), 1, kFALSE);
 
+   if (_totalYield) {
+      return evaluateSparse(bins);
+   }
+
    ROOT::Math::KahanSum<double> sumWeight;
 
    for (std::size_t i = bins.begin(N_events_); i < bins.end(N_events_); ++i) {
@@ -147,5 +216,58 @@ RooBinnedL::evaluatePartition(Section bins, std::size_t /*components_begin*/, st
    return result;
 }
 
+//////////////////////////////////////////////////////////////////////////////////
+/// Calculate the likelihood of the bins in the section from the non-empty bins only.
+/// The model is evaluated in these bins first, and the terms are then summed with a
+/// vectorisable Kahan summation.
+ROOT::Math::KahanSum<double> RooBinnedL::evaluateSparse(Section bins)
+{
+   const auto begin = std::lower_bound(_nonEmptyBins.begin(), _nonEmptyBins.end(), bins.begin(N_events_));
+   const auto end = std::lower_bound(begin, _nonEmptyBins.end(), bins.end(N_events_));
+   const std::size_t first = begin - _nonEmptyBins.begin();
+   const std::size_t n = end - begin;
+
+   ROOT::Math::KahanSum<double> sumWeight;
+   for (std::size_t k = first; k < first + n; ++k) {
+      const std::size_t i = _nonEmptyBins[k];
+      data_->get(i);
+
+      const double N = _nonEmptyWeights[k];
+      const double mu = pdf_->getVal() * _binw[i];
+
+      // The yield of the bin is part of the total yield. Where the regular evaluation adds no term, it is
+      // subtracted again.
+      if (mu <= 0 && N > 0) {
+         oocoutI(static_cast<RooAbsArg *>(nullptr), Minimization)
+            << "Observed " << N << " events in bin " << i << " with zero event yield" << std::endl;
+         _terms[k] = -mu;
+      } else if (std::abs(mu) < 1e-10 && std::abs(N) < 1e-10) {
+         _terms[k] = -mu;
+      } else {
+         _terms[k] = -N * std::log(mu) + _lnGammaWeights[k];
+         sumWeight += N;
+      }
+   }
+
+   ROOT::Math::KahanSum<double, 4> sum;
+   sum.Add(_terms.begin() + first, _terms.begin() + first + n);
+   ROOT::Math::KahanSum<double> result(sum);
+
+   if (bins.begin(N_events_) == 0) {
+      result += _totalYield->getVal();
+   }
+
+   if (sim_count_ > 1) {
+      result += sumWeight * log(1.0 * sim_count_);
+   }
+
+   if (_first) {
+      _first = false;
+      pdf_->wireAllCaches();
+   }
+
+   return result;
+}
+
 } // namespace TestStatistics
 } // namespace RooFit
@@ -34,7 +34,7 @@ In extended mode, a
 #include "RooAbsPdf.h"
 #include "RooAbsDataStore.h"
 #include "RooNLLVar.h"  // RooNLLVar::ComputeScalar
-#include "RunContext.h" // complete type BatchCompute::RunContext
+#include "RooFitDriver.h" // complete type RooFitDriver
 
 #include "Math/Util.h" // KahanSum
 
@@ -90,7 +90,7 @@ RooUnbinnedL::evaluatePartition(Section events, std::size_t /*components_begin*/
    data_->store()->recalculateCache(nullptr, events.begin(N_events_), events.end(N_events_), 1, kTRUE);
 
    if (useBatchedEvaluations_) {
-      std::tie(result, sumWeight) = RooNLLVar::computeBatchedFunc(pdf_.get(), data_.get(), evalData_, normSet_.get(), apply_weight_squared,
+      std::tie(result, sumWeight) = RooNLLVar::computeBatchedFunc(pdf_.get(), data_.get(), driver_, normSet_.get(), apply_weight_squared,
                                                                   1, events.begin(N_events_), events.end(N_events_));
    } else {
       std::tie(result, sumWeight) = RooNLLVar::computeScalarFunc(pdf_.get(), data_.get(), normSet_.get(), apply_weight_squared,
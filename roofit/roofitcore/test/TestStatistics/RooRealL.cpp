@@ -16,7 +16,7 @@
 
 #include "TestStatistics/RooRealL.h"
 #include "TestStatistics/RooUnbinnedL.h"
-#include <RunContext.h> // necessary to complete RooUnbinnedL
+#include <RooFitDriver.h> // necessary to complete RooUnbinnedL
 
 #include <RooRandom.h>
 #include <RooWorkspace.h>
@@ -0,0 +1,118 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include <TestStatistics/LikelihoodGradientClad.h>
+#include <TestStatistics/LikelihoodSerial.h>
+#include <TestStatistics/MinuitFcnGrad.h>
+#include <TestStatistics/buildLikelihood.h>
+
+#include <RooRandom.h>
+#include <RooWorkspace.h>
+#include <RooMinimizer.h>
+#include <RooRealVar.h>
+#include <RooDataSet.h>
+#include <RooAbsPdf.h>
+#include <RooGlobalFunc.h>
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+class LikelihoodGradientCladTest : public ::testing::Test {
+protected:
+   void SetUp() override
+   {
+      RooMsgService::instance().setGlobalKillBelow(RooFit::ERROR);
+      RooRandom::randomGenerator()->SetSeed(23);
+      clean_flags = std::make_shared<RooFit::TestStatistics::WrapperCalculationCleanFlags>();
+
+      w.factory("Gaussian::g(x[-10,10],mu[0.5,-3,3],sigma[1.5,0.1,10])");
+      w.factory("Exponential::e(x,c[-0.2,-1,0])");
+      w.factory("SUM::model(nsig[300,0,2000]*g,nbkg[700,0,2000]*e)");
+      data.reset(w.pdf("model")->generate(*w.var("x"), 1000));
+
+      for (const char *name : {"mu", "sigma", "c", "nsig", "nbkg"}) {
+         auto var = w.var(name);
+         parameter_settings.emplace_back(name, var->getVal(), 0.1, var->getMin(), var->getMax());
+      }
+   }
+
+   RooWorkspace w;
+   std::unique_ptr<RooDataSet> data;
+   std::vector<ROOT::Fit::ParameterSettings> parameter_settings;
+   std::shared_ptr<RooFit::TestStatistics::WrapperCalculationCleanFlags> clean_flags;
+};
+
+TEST_F(LikelihoodGradientCladTest, ValueAndGradient)
+{
+   RooAbsPdf *pdf = w.pdf("model");
+   std::unique_ptr<RooAbsReal> nll{pdf->createNLL(*data, RooFit::Extended())};
+   auto likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data.get(), RooFit::TestStatistics::RooAbsL::Extended::Yes);
+
+   RooFit::TestStatistics::LikelihoodGradientClad clad(likelihood, clean_flags, parameter_settings.size(), nullptr);
+   clad.synchronizeParameterSettings(nullptr, parameter_settings);
+
+   EXPECT_NEAR(nll->getVal(), clad.evaluate(), 1e-8 * std::abs(nll->getVal()));
+
+   std::vector<double> grad(parameter_settings.size());
+   clad.fillGradient(grad.data());
+
+   // compare to central finite differences of the RooFit likelihood
+   for (std::size_t ix = 0; ix < parameter_settings.size(); ++ix) {
+      RooRealVar *var = w.var(parameter_settings[ix].Name().c_str());
+      const double x0 = var->getVal();
+      const double h = 1e-5 * std::max(1., std::abs(x0));
+      var->setVal(x0 + h);
+      const double up = nll->getVal();
+      var->setVal(x0 - h);
+      const double down = nll->getVal();
+      var->setVal(x0);
+      EXPECT_NEAR(grad[ix], (up - down) / (2 * h), 1e-4 * std::max(1., std::abs(grad[ix])))
+         << "for parameter " << var->GetName();
+   }
+}
+
+TEST_F(LikelihoodGradientCladTest, Fit)
+{
+   RooAbsPdf *pdf = w.pdf("model");
+   std::unique_ptr<RooArgSet> initial{static_cast<RooArgSet *>(w.allVars().snapshot())};
+
+   std::unique_ptr<RooAbsReal> nll{pdf->createNLL(*data, RooFit::Extended())};
+   RooMinimizer m0(*nll);
+   m0.setPrintLevel(-1);
+   m0.minimize("Minuit2", "migrad");
+   std::unique_ptr<RooArgSet> result0{static_cast<RooArgSet *>(w.allVars().snapshot())};
+
+   w.allVars() = *initial;
+
+   auto likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data.get(), RooFit::TestStatistics::RooAbsL::Extended::Yes);
+   auto m1 = RooMinimizer::create<RooFit::TestStatistics::LikelihoodSerial,
+                                  RooFit::TestStatistics::LikelihoodGradientClad>(likelihood);
+   m1->setPrintLevel(-1);
+   m1->minimize("Minuit2", "migrad");
+
+   for (const auto &settings : parameter_settings) {
+      const auto &name = settings.Name();
+      auto &var0 = static_cast<RooRealVar &>((*result0)[name.c_str()]);
+      // the minimisers stop at slightly different points, but well within the parameter uncertainties
+      EXPECT_NEAR(var0.getVal(), w.var(name.c_str())->getVal(), 1e-2 * var0.getError()) << "for parameter " << name;
+   }
+}
+
+TEST_F(LikelihoodGradientCladTest, UnsupportedPdf)
+{
+   w.factory("EXPR::ex('exp(-x*x/(k*k))',x,k[2,1,3])");
+   auto likelihood = RooFit::TestStatistics::buildLikelihood(w.pdf("ex"), data.get());
+   EXPECT_THROW(RooFit::TestStatistics::LikelihoodGradientClad(likelihood, clean_flags, 1, nullptr), std::runtime_error);
+}
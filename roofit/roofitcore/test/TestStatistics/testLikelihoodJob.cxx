@@ -0,0 +1,202 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include <TestStatistics/LikelihoodJob.h>
+#include <TestStatistics/LikelihoodGradientJob.h>
+#include <TestStatistics/LikelihoodSerial.h>
+#include <TestStatistics/LikelihoodWorkers.h>
+#include <TestStatistics/MinuitFcnGrad.h>
+#include <TestStatistics/buildLikelihood.h>
+
+#include <RooRandom.h>
+#include <RooWorkspace.h>
+#include <RooMinimizer.h>
+#include <RooFitResult.h>
+#include <RooRealVar.h>
+#include "RooDataHist.h" // complete type in SimBinned test
+#include "RooCategory.h" // complete type in SimBinned test
+
+#include "Minuit2/NumericalDerivator.h"
+
+#include "gtest/gtest.h"
+#include "../test_lib.h" // generate_1D_gaussian_pdf_nll
+
+class LikelihoodJobTest : public ::testing::Test {
+protected:
+   void SetUp() override
+   {
+      RooMsgService::instance().setGlobalKillBelow(RooFit::ERROR);
+      RooRandom::randomGenerator()->SetSeed(seed);
+      clean_flags = std::make_shared<RooFit::TestStatistics::WrapperCalculationCleanFlags>();
+      default_n_workers = RooFit::TestStatistics::LikelihoodWorkers::getDefaultNWorkers();
+   }
+
+   void TearDown() override
+   {
+      RooFit::TestStatistics::LikelihoodWorkers::setDefaultNWorkers(default_n_workers);
+   }
+
+   std::size_t seed = 23;
+   std::size_t default_n_workers;
+   RooWorkspace w;
+   std::unique_ptr<RooAbsReal> nll;
+   std::unique_ptr<RooArgSet> values;
+   RooAbsPdf *pdf;
+   RooAbsData *data;
+   std::shared_ptr<RooFit::TestStatistics::RooAbsL> likelihood;
+   std::shared_ptr<RooFit::TestStatistics::WrapperCalculationCleanFlags> clean_flags;
+};
+
+TEST_F(LikelihoodJobTest, UnbinnedGaussian1D)
+{
+   std::tie(nll, pdf, data, values) = generate_1D_gaussian_pdf_nll(w, 10000);
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+
+   RooFit::TestStatistics::LikelihoodWorkers::setDefaultNWorkers(3);
+   RooFit::TestStatistics::LikelihoodJob nll_job(likelihood, clean_flags);
+
+   auto nll0 = nll->getVal();
+
+   nll_job.evaluate();
+   auto nll1 = nll_job.getResult();
+
+   // the events are summed in a different order
+   EXPECT_NEAR(nll0, nll1.Sum(), 1e-10 * std::abs(nll0));
+
+   // parameter changes in the master must reach the workers
+   w.var("mu")->setVal(0.5);
+   nll_job.evaluate();
+   EXPECT_NEAR(nll->getVal(), nll_job.getResult().Sum(), 1e-10 * std::abs(nll0));
+}
+
+TEST_F(LikelihoodJobTest, ConstOptimization)
+{
+   std::tie(nll, pdf, data, values) = generate_1D_gaussian_pdf_nll(w, 10000);
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+
+   RooFit::TestStatistics::LikelihoodWorkers::setDefaultNWorkers(2);
+   RooFit::TestStatistics::LikelihoodJob nll_job(likelihood, clean_flags);
+   auto nll0 = nll->getVal();
+
+   // fork the workers before optimizing, so that the optimization has to be sent to them
+   nll_job.evaluate();
+   nll_job.constOptimizeTestStatistic(RooAbsArg::Activate, true);
+   nll_job.evaluate();
+   EXPECT_NEAR(nll0, nll_job.getResult().Sum(), 1e-10 * std::abs(nll0));
+
+   w.var("mu")->setVal(0.5);
+   nll_job.evaluate();
+   EXPECT_NEAR(nll->getVal(), nll_job.getResult().Sum(), 1e-10 * std::abs(nll0));
+}
+
+TEST_F(LikelihoodJobTest, SimBinned)
+{
+   w.factory("Gaussian::gA(x[-10,10],-2,3)");
+   w.factory("Gaussian::gB(x[-10,10],2,1)");
+   w.factory("Uniform::u(x)");
+
+   RooDataHist *h_sigA = w.pdf("gA")->generateBinned(*w.var("x"), 1000);
+   RooDataHist *h_sigB = w.pdf("gB")->generateBinned(*w.var("x"), 1000);
+   RooDataHist *h_bkg = w.pdf("u")->generateBinned(*w.var("x"), 1000);
+
+   w.import(*h_sigA, RooFit::Rename("h_sigA"));
+   w.import(*h_sigB, RooFit::Rename("h_sigB"));
+   w.import(*h_bkg, RooFit::Rename("h_bkg"));
+
+   w.factory("HistFunc::hf_sigA(x,h_sigA)");
+   w.factory("HistFunc::hf_sigB(x,h_sigB)");
+   w.factory("HistFunc::hf_bkg(x,h_bkg)");
+
+   w.factory("ASUM::model_A(mu_sig[1,-1,10]*hf_sigA,mu_bkg_A[1,-1,10]*hf_bkg)");
+   w.factory("ASUM::model_B(mu_sig*hf_sigB,mu_bkg_B[1,-1,10]*hf_bkg)");
+
+   w.pdf("model_A")->setAttribute("BinnedLikelihood");
+   w.pdf("model_B")->setAttribute("BinnedLikelihood");
+
+   w.factory("SIMUL::model(index[A,B],A=model_A,B=model_B)");
+
+   pdf = w.pdf("model");
+   data = pdf->generate(RooArgSet(*w.var("x"), *w.cat("index")), RooFit::AllBinned());
+
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+   RooFit::TestStatistics::LikelihoodSerial nll_serial(likelihood, clean_flags);
+   nll_serial.evaluate();
+   auto nll0 = nll_serial.getResult().Sum();
+
+   // fewer components than workers: split over events; then split over components
+   for (std::size_t n_workers : {3, 2}) {
+      RooFit::TestStatistics::LikelihoodWorkers workers(likelihood, n_workers);
+      EXPECT_NEAR(nll0, workers.evaluate().Sum(), 1e-10 * std::abs(nll0)) << "with " << n_workers << " workers";
+   }
+}
+
+TEST_F(LikelihoodJobTest, Gradient)
+{
+   std::tie(nll, pdf, data, values) = generate_1D_gaussian_pdf_nll(w, 10000);
+   w.var("sigma")->setConstant(false);
+   w.var("sigma")->setRange(0.1, 10);
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+
+   std::vector<ROOT::Fit::ParameterSettings> parameter_settings;
+   for (const char *name : {"mu", "sigma"}) {
+      auto var = w.var(name);
+      parameter_settings.emplace_back(name, var->getVal(), 0.1, var->getMin(), var->getMax());
+   }
+
+   ROOT::Minuit2::NumericalDerivator derivator;
+   std::vector<double> minuit_internal_x;
+   for (const auto &settings : parameter_settings) {
+      minuit_internal_x.push_back(derivator.Ext2int(settings, settings.Value()));
+   }
+
+   std::vector<ROOT::Minuit2::DerivatorElement> gradient_serial(parameter_settings.size());
+   std::vector<ROOT::Minuit2::DerivatorElement> gradient_parallel(parameter_settings.size());
+   derivator.SetInitialGradient(nullptr, parameter_settings, gradient_serial);
+   derivator.SetInitialGradient(nullptr, parameter_settings, gradient_parallel);
+
+   RooFit::TestStatistics::LikelihoodWorkers::DerivatorOptions options;
+   RooFit::TestStatistics::LikelihoodWorkers serial(likelihood, 0);
+   serial.calculateGradient(minuit_internal_x, parameter_settings, options, gradient_serial);
+   RooFit::TestStatistics::LikelihoodWorkers parallel(likelihood, 2);
+   parallel.calculateGradient(minuit_internal_x, parameter_settings, options, gradient_parallel);
+
+   for (std::size_t ix = 0; ix < parameter_settings.size(); ++ix) {
+      EXPECT_EQ(gradient_serial[ix].derivative, gradient_parallel[ix].derivative);
+      EXPECT_EQ(gradient_serial[ix].step_size, gradient_parallel[ix].step_size);
+   }
+
+   // the serial calculation must leave the parameters as they were
+   EXPECT_EQ(w.var("mu")->getVal(), parameter_settings[0].Value());
+}
+
+TEST_F(LikelihoodJobTest, Fit)
+{
+   std::tie(nll, pdf, data, values) = generate_1D_gaussian_pdf_nll(w, 10000);
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+
+   RooMinimizer m0(*nll);
+   m0.setPrintLevel(-1);
+   m0.minimize("Minuit2", "migrad");
+   const double mu0 = w.var("mu")->getVal();
+
+   w.var("mu")->setVal(1.);
+
+   RooFit::TestStatistics::LikelihoodWorkers::setDefaultNWorkers(2);
+   auto m1 = RooMinimizer::create<RooFit::TestStatistics::LikelihoodJob, RooFit::TestStatistics::LikelihoodGradientJob>(
+      likelihood);
+   m1->setPrintLevel(-1);
+   m1->minimize("Minuit2", "migrad");
+
+   EXPECT_NEAR(mu0, w.var("mu")->getVal(), 1e-4);
+}
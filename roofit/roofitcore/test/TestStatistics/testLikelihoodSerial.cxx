@@ -170,6 +170,41 @@ TEST_F(LikelihoodSerialBinnedDatasetTest, BinnedManualNLL)
 }
 
 
+TEST_F(LikelihoodSerialTest, BinnedSparse)
+{
+   // Narrow template, so that most bins are empty
+   w.factory("Gaussian::g(x[-10,10],0,0.5)");
+   RooDataHist *h_sig = w.pdf("g")->generateBinned(*w.var("x"), 1000);
+   w.import(*h_sig, RooFit::Rename("h_sig"));
+   w.factory("HistFunc::hf_sig(x,h_sig)");
+   w.factory("ASUM::model(mu_sig[1,-1,10]*hf_sig)");
+
+   pdf = w.pdf("model");
+   pdf->setAttribute("BinnedLikelihood");
+   data = pdf->generateBinned(*w.var("x"));
+
+   RooArgSet projDeps;
+   RooAbsTestStatistic::Configuration nll_config;
+   nll_config.verbose = false;
+   nll_config.cloneInputData = false;
+   nll_config.binnedL = true;
+   RooNLLVar nll_manual("nll_manual", "-log(likelihood)", *pdf, *data, projDeps, 2, nll_config);
+
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+   ASSERT_TRUE(dynamic_cast<RooFit::TestStatistics::RooBinnedL &>(*likelihood).usesSparseBins());
+   RooFit::TestStatistics::LikelihoodSerial nll_ts(likelihood, clean_flags/*, nullptr*/);
+
+   for (double mu_sig : {1., 1.3, 0.8}) {
+      w.var("mu_sig")->setVal(mu_sig);
+      auto nll0 = nll_manual.getVal();
+
+      nll_ts.evaluate();
+      auto nll1 = nll_ts.getResult();
+
+      EXPECT_NEAR(nll0, nll1, 1e-10 * std::abs(nll0)) << "for mu_sig = " << mu_sig;
+   }
+}
+
 TEST_F(LikelihoodSerialTest, SimBinned)
 {
    // Unbinned pdfs that define template histograms
@@ -703,3 +703,43 @@ TEST(RooDataHist, Interpolation2DSimple)
       }
    }
 }
+
+
+/// The batched histogram lookup must reproduce the scalar lookup, also with interpolation and at the boundaries.
+TEST(RooDataHist, BatchedWeightsMatchScalar) {
+  RooRealVar x("x", "x", 0., -5., 5.);
+  x.setBins(20);
+  TH1D hist("batchHist", "", 20, -5., 5.);
+  for (int i = 1; i <= hist.GetNbinsX(); ++i) {
+    hist.SetBinContent(i, 1. + 0.5 * i + 0.1 * (i % 3));
+  }
+  RooDataHist dataHist("dataHist", "", RooArgList(x), &hist);
+
+  std::vector<double> xValues;
+  for (int i = 0; i <= 1000; ++i) {
+    xValues.push_back(-5. + i * 0.01);
+  }
+
+  for (int intOrder : {0, 1}) {
+    for (bool cdfBoundaries : {false, true}) {
+      RooHistFunc histFunc("histFunc", "", x, dataHist, intOrder);
+      histFunc.setCdfBoundaries(cdfBoundaries);
+      RooHistPdf histPdf("histPdf", "", x, dataHist, intOrder);
+
+      RooBatchCompute::RunContext evalData;
+      evalData.spans[&x] = RooSpan<const double>(xValues);
+      auto funcValues = histFunc.getValues(evalData, nullptr);
+      auto pdfValues = histPdf.getValues(evalData, nullptr);
+      ASSERT_EQ(funcValues.size(), xValues.size());
+      ASSERT_EQ(pdfValues.size(), xValues.size());
+
+      for (std::size_t i = 0; i < xValues.size(); ++i) {
+        x.setVal(xValues[i]);
+        EXPECT_NEAR(funcValues[i], histFunc.getVal(), 1.E-10)
+            << "intOrder=" << intOrder << " cdfBoundaries=" << cdfBoundaries << " x=" << xValues[i];
+        EXPECT_NEAR(pdfValues[i], histPdf.getVal(), 1.E-10)
+            << "intOrder=" << intOrder << " x=" << xValues[i];
+      }
+    }
+  }
+}
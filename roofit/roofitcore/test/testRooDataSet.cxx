@@ -6,6 +6,7 @@
 #include "RooRealVar.h"
 #include "RooHelpers.h"
 #include "RooCategory.h"
+#include "RooVectorDataStore.h"
 
 #include <TFile.h>
 #include <TTree.h>
@@ -259,3 +260,44 @@ TEST(RooDataSet, CrashAfterImportFromTree) {
   EXPECT_EQ(static_cast<RooRealVar*>(data_set->get(1)->find("var"))->getVal(), 2.);
 
 }
+
+/// Columns that are appended to a RooVectorDataStore show up in the dataset as if the rows had been added one by one.
+TEST(RooDataSet, AppendColumns) {
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar y("y", "y", -10, 10);
+  RooDataSet data("data", "data", RooArgSet(x, y));
+  auto store = dynamic_cast<RooVectorDataStore*>(data.store());
+  ASSERT_NE(store, nullptr);
+  ASSERT_TRUE(store->canAppendColumns());
+
+  // Moved into the empty store
+  store->appendColumns(std::vector<std::vector<double>>{{1., 2., 3.}, {-1., -2., -3.}});
+  // Copied behind the existing rows
+  const std::vector<double> xValues{4., 5.};
+  const std::vector<double> yValues{-4., -5.};
+  store->appendColumns({RooSpan<const double>(xValues), RooSpan<const double>(yValues)});
+
+  ASSERT_EQ(data.numEntries(), 5);
+  EXPECT_EQ(data.sumEntries(), 5.);
+  for (int i = 0; i < 5; ++i) {
+    const RooArgSet* row = data.get(i);
+    EXPECT_EQ(static_cast<RooRealVar*>(row->find("x"))->getVal(), i + 1.);
+    EXPECT_EQ(static_cast<RooRealVar*>(row->find("y"))->getVal(), -(i + 1.));
+  }
+
+  // Appending a dataset with the same variables uses whole columns, too
+  RooDataSet data2("data2", "data2", RooArgSet(x, y));
+  data2.append(data);
+  ASSERT_EQ(data2.numEntries(), 5);
+  EXPECT_EQ(static_cast<RooRealVar*>(data2.get(4)->find("y"))->getVal(), -5.);
+
+  EXPECT_THROW(store->appendColumns(std::vector<std::vector<double>>{{1., 2.}, {1.}}), std::invalid_argument);
+  EXPECT_THROW(store->appendColumns(std::vector<std::vector<double>>{{1.}}), std::invalid_argument);
+
+  RooCategory cat("cat", "cat", {{"a", 0}, {"b", 1}});
+  RooDataSet dataWithCat("dataWithCat", "dataWithCat", RooArgSet(x, cat));
+  auto storeWithCat = dynamic_cast<RooVectorDataStore*>(dataWithCat.store());
+  ASSERT_NE(storeWithCat, nullptr);
+  EXPECT_FALSE(storeWithCat->canAppendColumns());
+  EXPECT_THROW(storeWithCat->appendColumns(std::vector<std::vector<double>>{{1.}, {0.}}), std::invalid_argument);
+}
@@ -0,0 +1,56 @@
+// Tests for the RooMCStudy
+
+#include "RooMCStudy.h"
+#include "RooDataSet.h"
+#include "RooFitResult.h"
+#include "RooGaussian.h"
+#include "RooGlobalFunc.h"
+#include "RooMsgService.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+std::unique_ptr<RooDataSet> runStudy(int nWorkers)
+{
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar mean("mean", "mean", 1., -5., 5.);
+  RooRealVar sigma("sigma", "sigma", 2., 0.1, 10.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+
+  RooRandom::randomGenerator()->SetSeed(1234);
+  RooMCStudy study(gauss, x, RooFit::Silence(), RooFit::NumCPU(nWorkers),
+                   RooFit::FitOptions(RooFit::Save(), RooFit::PrintLevel(-1)));
+  EXPECT_FALSE(study.generateAndFit(20, 200));
+
+  EXPECT_NE(study.fitResult(19), nullptr);
+  return std::unique_ptr<RooDataSet>(static_cast<RooDataSet*>(study.fitParDataSet().Clone()));
+}
+
+}
+
+#ifndef _WIN32
+/// The toys that are generated and fitted in worker processes don't depend on the number of workers.
+TEST(RooMCStudy, ParallelToysAreReproducible)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+  std::unique_ptr<RooDataSet> two = runStudy(2);
+  std::unique_ptr<RooDataSet> three = runStudy(3);
+
+  ASSERT_EQ(two->numEntries(), 20);
+  ASSERT_EQ(three->numEntries(), 20);
+  for (int i = 0; i < two->numEntries(); ++i) {
+    for (const char* name : {"mean", "sigma", "NLL", "ngen", "meanerr", "meanpull"}) {
+      EXPECT_EQ(two->get(i)->getRealValue(name), three->get(i)->getRealValue(name)) << name << " of toy " << i;
+    }
+  }
+
+  // The pulls of unbiased fits scatter around zero
+  EXPECT_NEAR(two->mean(*static_cast<RooRealVar*>(two->get()->find("meanpull"))), 0., 1.);
+}
+#endif
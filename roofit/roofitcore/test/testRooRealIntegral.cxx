@@ -0,0 +1,136 @@
+// Tests for the RooRealIntegral
+
+#include "RooRealIntegral.h"
+#include "RooNumIntConfig.h"
+#include "RooRealProxy.h"
+#include "RooRealSumFunc.h"
+#include "RooRealVar.h"
+#include "RooGlobalFunc.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+
+namespace {
+
+/// Gaussian shape without analytical integral that counts its evaluations.
+class CountingGauss : public RooAbsReal {
+public:
+  CountingGauss(const char *name, RooAbsReal &x, RooAbsReal &sigma)
+    : RooAbsReal(name, name), _x("x", "x", this, x), _sigma("sigma", "sigma", this, sigma)
+  {
+  }
+  CountingGauss(const CountingGauss &other, const char *name = nullptr)
+    : RooAbsReal(other, name), _x("x", this, other._x), _sigma("sigma", this, other._sigma)
+  {
+  }
+  TObject *clone(const char *newname) const override { return new CountingGauss(*this, newname); }
+
+  void setSelected(bool flag) { selectComp(flag); }
+
+  static int nEval;
+
+protected:
+  Double_t evaluate() const override
+  {
+    ++nEval;
+    return std::exp(-0.5 * _x * _x / (_sigma * _sigma));
+  }
+
+  RooRealProxy _x;
+  RooRealProxy _sigma;
+};
+
+int CountingGauss::nEval = 0;
+
+} // namespace
+
+TEST(RooRealIntegral, RemembersRecentResults)
+{
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 10.);
+  CountingGauss gauss("gauss", x, sigma);
+  std::unique_ptr<RooAbsReal> integral{gauss.createIntegral(x)};
+
+  const double val1 = integral->getVal();
+  EXPECT_NEAR(val1, std::sqrt(2. * M_PI), 1e-5);
+  sigma.setVal(2.);
+  const double val2 = integral->getVal();
+  EXPECT_NEAR(val2, 2. * std::sqrt(2. * M_PI), 1e-5);
+
+  // Going back to a previous value of the parameter must not integrate again
+  CountingGauss::nEval = 0;
+  sigma.setVal(1.);
+  EXPECT_EQ(integral->getVal(), val1);
+  EXPECT_EQ(CountingGauss::nEval, 0);
+
+  // Changing the integration limits invalidates the remembered results
+  x.setRange(-1., 1.);
+  EXPECT_NEAR(integral->getVal(), std::sqrt(2. * M_PI) * std::erf(1. / std::sqrt(2.)), 1e-5);
+  EXPECT_GT(CountingGauss::nEval, 0);
+  x.setRange(-10., 10.);
+
+  // Without remembered results, the integral is computed again
+  const std::size_t oldSize = RooRealIntegral::getNumericMemoSize();
+  RooRealIntegral::setNumericMemoSize(0);
+  sigma.setVal(2.);
+  integral->getVal();
+  CountingGauss::nEval = 0;
+  sigma.setVal(1.);
+  EXPECT_DOUBLE_EQ(integral->getVal(), val1);
+  EXPECT_GT(CountingGauss::nEval, 0);
+  RooRealIntegral::setNumericMemoSize(oldSize);
+}
+
+TEST(RooRealIntegral, RemembersResultsWithComponentSelection)
+{
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar sigma1("sigma1", "sigma1", 1., 0.1, 10.);
+  RooRealVar sigma2("sigma2", "sigma2", 2., 0.1, 10.);
+  RooRealVar coef("coef", "coef", 0.5);
+  CountingGauss gauss1("gauss1", x, sigma1);
+  CountingGauss gauss2("gauss2", x, sigma2);
+  RooRealSumFunc sum("sum", "sum", gauss1, gauss2, coef);
+  // integrate the sum itself, which applies the component selection
+  sum.forceNumInt(true);
+  std::unique_ptr<RooAbsReal> integral{sum.createIntegral(x)};
+
+  const double full = integral->getVal();
+  EXPECT_NEAR(full, 0.5 * 3. * std::sqrt(2. * M_PI), 1e-5);
+
+  // A deselected component changes the result: it must not be taken from the remembered ones
+  gauss2.setSelected(false);
+  integral->setValueDirty();
+  EXPECT_NEAR(integral->getVal(), 0.5 * std::sqrt(2. * M_PI), 1e-5);
+
+  gauss2.setSelected(true);
+  integral->setValueDirty();
+  CountingGauss::nEval = 0;
+  EXPECT_EQ(integral->getVal(), full);
+  EXPECT_EQ(CountingGauss::nEval, 0);
+}
+
+TEST(RooRealIntegral, BatchIntegrator1D)
+{
+  RooRealVar x("x", "x", -10, 10);
+  RooRealVar sigma("sigma", "sigma", 1.5, 0.1, 10.);
+  CountingGauss gauss("gauss", x, sigma);
+
+  for (const char *rule : {"Trapezoid", "Midpoint"}) {
+    RooNumIntConfig config(*RooAbsReal::defaultIntegratorConfig());
+    config.method1D().setLabel("RooIntegrator1D");
+    config.getConfigSection("RooIntegrator1D").setCatLabel("sumRule", rule);
+    std::unique_ptr<RooAbsReal> scalarIntegral{gauss.createIntegral(x, RooFit::NumIntConfig(config))};
+
+    config.getConfigSection("RooIntegrator1D").setCatLabel("batchMode", "On");
+    std::unique_ptr<RooAbsReal> batchIntegral{gauss.createIntegral(x, RooFit::NumIntConfig(config))};
+
+    for (double sigmaVal : {1.5, 0.5, 3.}) {
+      sigma.setVal(sigmaVal);
+      const double expected = sigmaVal * std::sqrt(2. * M_PI);
+      EXPECT_NEAR(scalarIntegral->getVal(), expected, 1e-5 * expected) << rule;
+      EXPECT_NEAR(batchIntegral->getVal(), scalarIntegral->getVal(), 1e-12 * expected) << rule;
+    }
+  }
+}
@@ -1,14 +1,18 @@
 // Tests for the RooSimultaneous
 // Authors: Jonas Rembser, CERN  06/2021
 
+#include "RooAbsTestStatistic.h"
 #include "RooAddPdf.h"
 #include "RooConstVar.h"
 #include "RooCategory.h"
 #include "RooDataSet.h"
+#include "RooExtendPdf.h"
+#include "RooFormulaVar.h"
 #include "RooGenericPdf.h"
 #include "RooRealVar.h"
 #include "RooSimultaneous.h"
 #include "RooProdPdf.h"
+#include "RooSharedValueCache.h"
 
 #include "gtest/gtest.h"
 
@@ -50,3 +54,57 @@ TEST(RooSimultaneous, ImportFromTreeWithCut)
 
    EXPECT_FLOAT_EQ(nllDirect->getVal(), nllSimWrapped->getVal());
 }
+
+/// Functions of the parameters that are used by several channels are only
+/// computed once per parameter change, and are shared by the channels.
+TEST(RooSimultaneous, SharedValuesBetweenChannels)
+{
+   using namespace RooFit;
+
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   RooRealVar x("x", "x", 0, 10);
+   RooRealVar mean("mean", "mean", 5., 0, 10);
+   RooRealVar nsig("nsig", "nsig", 500, 100, 1000);
+   RooRealVar alpha("alpha", "alpha", 0., -5, 5);
+   RooFormulaVar nexp("nexp", "nexp", "nsig*(1 + 0.1*alpha)", {nsig, alpha});
+
+   RooGenericPdf gaussA("gaussA", "gaussA", "std::exp(-0.5*(x - mean)^2)", {x, mean});
+   RooGenericPdf gaussB("gaussB", "gaussB", "std::exp(-0.5*(x - mean)^2/4.)", {x, mean});
+   RooExtendPdf modelA("modelA", "modelA", gaussA, nexp);
+   RooExtendPdf modelB("modelB", "modelB", gaussB, nexp);
+
+   RooCategory cat("cat", "cat");
+   cat.defineType("A");
+   cat.defineType("B");
+   RooSimultaneous modelSim("modelSim", "modelSim", {{"A", &modelA}, {"B", &modelB}}, cat);
+
+   std::unique_ptr<RooDataSet> dataA{modelA.generate(x)};
+   std::unique_ptr<RooDataSet> dataB{modelB.generate(x)};
+   RooDataSet combData("combData", "combData", x, Index(cat), Import("A", *dataA), Import("B", *dataB));
+
+   RooAbsTestStatistic::setShareValuesBetweenChannels(false);
+   std::unique_ptr<RooAbsReal> nllRef{modelSim.createNLL(combData, Extended())};
+   RooAbsTestStatistic::setShareValuesBetweenChannels(true);
+   std::unique_ptr<RooAbsReal> nll{modelSim.createNLL(combData, Extended())};
+
+   EXPECT_DOUBLE_EQ(nllRef->getVal(), nll->getVal());
+   EXPECT_EQ(static_cast<RooAbsTestStatistic &>(*nllRef).sharedValueCache(), nullptr);
+   const RooSharedValueCache *cache = static_cast<RooAbsTestStatistic &>(*nll).sharedValueCache();
+   ASSERT_NE(cache, nullptr);
+   EXPECT_EQ(cache->nNodes(), 2u);
+
+   const auto before = cache->statistics("nexp");
+   alpha.setVal(1.5);
+   EXPECT_DOUBLE_EQ(nllRef->getVal(), nll->getVal());
+   const auto after = cache->statistics("nexp");
+
+   // The first channel recomputes the yield, the second one takes it from the cache
+   EXPECT_EQ(after.misses, before.misses + 1);
+   EXPECT_EQ(after.hits, before.hits + 1);
+
+   // Changing a parameter that the yield doesn't depend on must not trigger a recomputation
+   mean.setVal(5.5);
+   EXPECT_DOUBLE_EQ(nllRef->getVal(), nll->getVal());
+   EXPECT_EQ(cache->statistics("nexp").misses, after.misses);
+}
@@ -0,0 +1,29 @@
+// Tests for the RooStudyManager
+
+#include "RooStudyManager.h"
+#include "RooGenFitStudy.h"
+#include "RooDataSet.h"
+#include "RooGlobalFunc.h"
+#include "RooMsgService.h"
+#include "RooWorkspace.h"
+
+#include "gtest/gtest.h"
+
+/// The experiments run in local worker processes are all aggregated in the summary output of the study.
+TEST(RooStudyManager, RunLocal)
+{
+  RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+  RooWorkspace w("w");
+  w.factory("Gaussian::gauss(x[-10,10],mean[1,-5,5],sigma[2,0.1,10])");
+
+  RooGenFitStudy study;
+  study.setGenConfig("gauss", "x", RooFit::NumEvents(200));
+  study.setFitConfig("gauss", "x", RooFit::PrintLevel(-1));
+
+  RooStudyManager manager(w, study);
+  ASSERT_FALSE(manager.runLocal(6, 2));
+
+  ASSERT_NE(study.summaryData(), nullptr);
+  EXPECT_EQ(study.summaryData()->numEntries(), 6);
+}
@@ -13,6 +13,9 @@
 #include <RooBinning.h>
 #include <RooPlot.h>
 #include <RooRandom.h>
+#include <RooAddPdf.h>
+#include <RooFitDriver.h>
+#include <RooNLLVar.h>
 
 #include <gtest/gtest.h>
 
@@ -307,3 +310,64 @@ TEST(RooChi2Var, IntegrateBins) {
 //  fit1->Print();
 //  fit2->Print();
 }
+
+TEST(RooFitDriver, RecomputeOnlyChangedNodes) {
+  RooRandom::randomGenerator()->SetSeed(1337ul);
+
+  RooRealVar x("x", "x", -5., 5.);
+  RooRealVar m("m", "m", 0.5, -5., 5.);
+  RooRealVar c("c", "c", -0.2, -5., 5.);
+  RooRealVar f("f", "f", 0.3, 0., 1.);
+  RooGenericPdf gauss("gauss", "std::exp(-0.5*(x-m)*(x-m))", RooArgSet(x, m));
+  RooGenericPdf expo("expo", "std::exp(c*x)", RooArgSet(x, c));
+  RooAddPdf sum("sum", "sum", RooArgList(gauss, expo), RooArgList(f));
+
+  std::unique_ptr<RooDataSet> data(sum.generate(x, 500));
+  sum.attachDataSet(*data);
+  RooArgSet normSet(x);
+
+  auto reference = [&]() {
+    RooBatchCompute::RunContext evalData;
+    data->getBatches(evalData, 0, data->numEntries());
+    auto logProbs = sum.getLogProbabilities(evalData, &normSet);
+    return std::vector<double>(logProbs.begin(), logProbs.end());
+  };
+  auto check = [&](RooSpan<const double> results) {
+    const auto expected = reference();
+    ASSERT_EQ(expected.size(), results.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_DOUBLE_EQ(expected[i], results[i]) << "event " << i;
+    }
+  };
+
+  RooFitDriver driver(sum, *data->get());
+  check(driver.getLogProbabilities(*data, 0, data->numEntries(), &normSet));
+
+  // Only the exponential and the sum depend on c
+  c.setVal(-0.3);
+  check(driver.getLogProbabilities(*data, 0, data->numEntries(), &normSet));
+  EXPECT_EQ(2u, driver.nRecomputed());
+
+  // Nothing changed
+  check(driver.getLogProbabilities(*data, 0, data->numEntries(), &normSet));
+  EXPECT_EQ(0u, driver.nRecomputed());
+}
+
+TEST(RooNLLVar, BatchModeSetData) {
+  RooRandom::randomGenerator()->SetSeed(1337ul);
+
+  RooRealVar x("x", "x", -5., 5.);
+  RooRealVar c("c", "c", -0.2, -5., 5.);
+  RooGenericPdf expo("expo", "std::exp(c*x)", RooArgSet(x, c));
+
+  std::unique_ptr<RooDataSet> data1(expo.generate(x, 500));
+  std::unique_ptr<RooDataSet> data2(expo.generate(x, 700));
+
+  // The clone of the new dataset may be allocated where the clone of the old one was
+  RooNLLVar nll("nll", "nll", expo, *data1, RooFit::BatchMode(true));
+  nll.getVal();
+  nll.setData(*data2);
+
+  RooNLLVar nllRef("nllRef", "nllRef", expo, *data2, RooFit::BatchMode(true));
+  EXPECT_DOUBLE_EQ(nllRef.getVal(), nll.getVal());
+}
@@ -7,6 +7,7 @@
 #include "RooArgList.h"
 #include "RooRealVar.h"
 #include "RooAbsReal.h"
+#include "RooDataSet.h"
 #include "RooStats/ModelConfig.h"
 
 #include "ROOT/StringUtils.hxx"
@@ -234,3 +235,49 @@ TEST_F(TestRooWorkspaceWithGaussian, HashLookupInWorkspace) {
   EXPECT_FALSE(model_constrained_orig->dependsOn(*ws->var("mu2")));
   EXPECT_NE(ws->pdf("Gauss_editPdf_orig"), nullptr);
 }
+
+
+/// Datasets that are written as separate keys are only read when they are accessed.
+TEST(RooWorkspace, LazyData)
+{
+   const char* filename = "testWorkspaceLazyData.root";
+
+   {
+      RooWorkspace w("ws");
+      w.factory("Gaussian::g(x[-10,10],mu[0,-5,5],sigma[1,0.1,5])");
+      std::unique_ptr<RooDataSet> d1{w.pdf("g")->generate(*w.var("x"), 100)};
+      std::unique_ptr<RooDataSet> d2{w.pdf("g")->generate(*w.var("x"), 200)};
+      w.import(*d1, RooFit::Rename("d1"));
+      w.import(*d2, RooFit::Rename("d2"));
+      w.setLazyData(true);
+
+      TFile outfile(filename, "RECREATE");
+      outfile.WriteObject(&w, "ws");
+
+      // Writing must not change the workspace in memory
+      EXPECT_EQ(w.numLazyData(), 0);
+      EXPECT_EQ(w.allData().size(), 2u);
+   }
+
+   std::unique_ptr<RooWorkspace> w;
+   {
+      TFile infile(filename, "READ");
+      RooWorkspace* wTmp = nullptr;
+      infile.GetObject("ws", wTmp);
+      ASSERT_NE(wTmp, nullptr);
+      w.reset(wTmp);
+      EXPECT_EQ(w->numLazyData(), 2);
+
+      ASSERT_NE(w->data("d1"), nullptr);
+      EXPECT_EQ(w->data("d1")->numEntries(), 100);
+      EXPECT_EQ(w->numLazyData(), 1);
+   }
+
+   // The file is opened again to read the remaining dataset
+   ASSERT_NE(w->data("d2"), nullptr);
+   EXPECT_EQ(w->data("d2")->numEntries(), 200);
+   EXPECT_EQ(w->numLazyData(), 0);
+   EXPECT_EQ(w->data("d3"), nullptr);
+
+   gSystem->Unlink(filename);
+}
@@ -21,6 +21,9 @@
 
 #include "TROOT.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace RooStats {
 
 /** \class ProofConfig
@@ -28,6 +31,10 @@ namespace RooStats {
 
 Holds configuration options for proof and proof-lite.
 
+With the host "local", PROOF is not used at all. The experiments are instead run in
+forked worker processes on the local machine, see RooStudyManager::runLocal().
+In this case, the number of experiments is the number of workers.
+
 This class will be expanded in the future to hold more specific configuration
 options for the tools in RooStats.
 
@@ -57,8 +64,13 @@ class ProofConfig {
          fShowGui(showGui)
       {
 
-            // case of ProofLite
-         if (fHost == "" || fHost.Contains("lite") ) {
+         // case of local worker processes, by default one per hardware thread
+         if (IsLocal()) {
+            fLite = false;
+            if (nExperiments == 0) fNExperiments = std::max(1u, std::thread::hardware_concurrency());
+         }
+         // case of ProofLite
+         else if (fHost == "" || fHost.Contains("lite") ) {
             fLite = true;
 
 
@@ -101,6 +113,8 @@ class ProofConfig {
       Bool_t GetShowGui(void) const { return fShowGui; }
       // return true if it is a Lite session (ProofLite)
       Bool_t IsLite() const { return fLite; }
+      // return true if the experiments run in local worker processes instead of PROOF
+      Bool_t IsLocal() const { return fHost == "local"; }
 
    protected:
       RooWorkspace& fWorkspace;   // workspace that is to be used with the RooStudyManager
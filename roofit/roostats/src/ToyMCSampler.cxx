@@ -25,7 +25,8 @@ It generates Toy Monte Carlo for a given parameter point and evaluates a
 TestStatistic.
 
 For parallel runs, ToyMCSampler can be given an instance of ProofConfig
-and then run in parallel using proof or proof-lite. Internally, it uses
+and then run in parallel using proof or proof-lite, or in worker processes on the
+local machine if the host of the ProofConfig is "local". Internally, it uses
 ToyMCStudy with the RooStudyManager.
 */
 
@@ -329,9 +330,14 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
          << endl;
    }
 
+   // Local workers pick up the next experiment when they are done, so smaller experiments balance the load
+   const Int_t nExperiments = fProofConfig->IsLocal() ?
+      std::max(1, std::min(fNToys, 4 * fProofConfig->GetNExperiments())) :
+      fProofConfig->GetNExperiments();
+
    // adjust number of toys on the slaves to keep the total number of toys constant
    Int_t totToys = fNToys;
-   fNToys = (int)ceil((double)fNToys / (double)fProofConfig->GetNExperiments()); // round up
+   fNToys = (int)ceil((double)fNToys / (double)nExperiments); // round up
 
    // create the study instance for parallel processing
    ToyMCStudy* toymcstudy = new ToyMCStudy ;
@@ -342,9 +348,19 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    // temporary workspace for proof to avoid messing with TRef
    RooWorkspace w(fProofConfig->GetWorkspace());
    RooStudyManager studymanager(w, *toymcstudy);
-   studymanager.runProof(fProofConfig->GetNExperiments(), fProofConfig->GetHost(), fProofConfig->GetShowGui());
-
-   RooDataSet* output = toymcstudy->merge();
+   Bool_t error = kFALSE;
+   if (fProofConfig->IsLocal())
+      error = studymanager.runLocal(nExperiments, fProofConfig->GetNExperiments());
+   else
+      studymanager.runProof(fProofConfig->GetNExperiments(), fProofConfig->GetHost(), fProofConfig->GetShowGui());
+
+   RooDataSet* output = nullptr;
+   if (error) {
+      oocoutE((TObject*)nullptr, Generation)
+         << "ToyMCSampler: the toys could not be run in the local worker processes" << endl;
+   } else {
+      output = toymcstudy->merge();
+   }
 
    // reset the number of toys
    fNToys = totToys;
@@ -24,6 +24,7 @@
 #include "ROOT/RVec.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
 #include "ROOT/RDF/RCutFlowReport.hxx"
+#include "ROOT/RDF/RNTupleSnapshotWriter.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
@@ -45,9 +46,11 @@
 #include "ROOT/RDF/RMergeableValue.hxx"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -540,6 +543,165 @@ public:
    std::string GetActionName() { return "FillPar"; }
 };
 
+/// Return whether a histogram should be filled through a single copy shared by all processing slots
+/// (BufferedFillHelper) rather than through one clone per slot (FillParHelper).
+/// This is the case when the per-slot clones would take more memory than ROOT::RDF::Experimental::GetSharedFillThreshold.
+bool UseSharedFill(const TH1 &h, unsigned int nSlots);
+
+/// Fill a single histogram shared by all processing slots, an alternative to FillParHelper for large histograms.
+/// Each slot accumulates the coordinates (and weights) of its fills in a small buffer, which is flushed into the shared
+/// histogram under a lock when full or at the end of each task. The memory overhead is a small buffer per slot instead
+/// of a full histogram clone per slot, and no merging step is required at the end of the event loop.
+template <typename HIST = Hist_t>
+class BufferedFillHelper : public RActionImpl<BufferedFillHelper<HIST>> {
+   static_assert(std::is_base_of<TH1, HIST>::value, "BufferedFillHelper only supports histograms deriving from TH1.");
+
+   /// Number of fills buffered per slot before the buffer is flushed into the shared histogram
+   static constexpr std::size_t fgBufSize = 1024;
+   using Flush_t = void (BufferedFillHelper::*)(unsigned int);
+
+   struct RSlotBuffer {
+      std::vector<double> fValues; ///< Fill arguments of the buffered fills, stored one fill after the other
+      Flush_t fFlush = nullptr;    ///< Flush function for the number of fill arguments used by this action
+      char fPadding[kCacheLineSize]; ///< Avoid false sharing between the buffers of different slots
+   };
+
+   const std::shared_ptr<HIST> fResultHist;
+   std::unique_ptr<std::mutex> fMutex; ///< Protects fResultHist during flushes (unique_ptr to keep the helper movable)
+   std::vector<RSlotBuffer> fBuffers;
+   /// Histograms containing "snapshots" of partial results. Non-null only if a registered callback requires it.
+   Results<std::unique_ptr<HIST>> fPartialHists;
+
+   template <std::size_t N>
+   void Push(unsigned int slot, const std::array<double, N> &xs)
+   {
+      auto &buffer = fBuffers[slot];
+      buffer.fFlush = &BufferedFillHelper::Flush<N>;
+      buffer.fValues.insert(buffer.fValues.end(), xs.begin(), xs.end());
+      if (buffer.fValues.size() >= fgBufSize * N)
+         Flush<N>(slot);
+   }
+
+   template <std::size_t N>
+   void Flush(unsigned int slot)
+   {
+      auto &values = fBuffers[slot].fValues;
+      {
+         std::lock_guard<std::mutex> lock(*fMutex);
+         for (std::size_t i = 0; i < values.size(); i += N)
+            FillOne(&values[i], std::make_index_sequence<N>());
+      }
+      values.clear();
+   }
+
+   void FlushIfNeeded(unsigned int slot)
+   {
+      if (fBuffers[slot].fFlush != nullptr)
+         (this->*fBuffers[slot].fFlush)(slot);
+   }
+
+   template <std::size_t... S>
+   void FillOne(const double *xs, std::index_sequence<S...>)
+   {
+      fResultHist->Fill(xs[S]...);
+   }
+
+   template <typename T, std::enable_if_t<IsDataContainer<T>::value || std::is_same<T, std::string>::value, int> = 0>
+   static std::size_t GetSize(const T &xs, std::size_t)
+   {
+      return xs.size();
+   }
+
+   template <typename T, std::enable_if_t<!IsDataContainer<T>::value && !std::is_same<T, std::string>::value, int> = 0>
+   static std::size_t GetSize(const T &, std::size_t defaultSize)
+   {
+      return defaultSize;
+   }
+
+   template <typename T, std::enable_if_t<IsDataContainer<T>::value || std::is_same<T, std::string>::value, int> = 0>
+   static double GetValue(const T &xs, std::size_t i)
+   {
+      return xs[i];
+   }
+
+   template <typename T, std::enable_if_t<!IsDataContainer<T>::value && !std::is_same<T, std::string>::value, int> = 0>
+   static double GetValue(const T &x, std::size_t)
+   {
+      return x; // scalars (e.g. weights) are used for all elements of the other columns
+   }
+
+public:
+   BufferedFillHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fResultHist(h), fMutex(new std::mutex), fBuffers(nSlots), fPartialHists(nSlots)
+   {
+   }
+   BufferedFillHelper(BufferedFillHelper &&) = default;
+   BufferedFillHelper(const BufferedFillHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int slot) { fBuffers[slot].fValues.reserve(4 * fgBufSize); }
+
+   void Exec(unsigned int slot, double x0) { Push<1>(slot, {{x0}}); }
+
+   void Exec(unsigned int slot, double x0, double x1) { Push<2>(slot, {{x0, x1}}); }
+
+   void Exec(unsigned int slot, double x0, double x1, double x2) { Push<3>(slot, {{x0, x1, x2}}); }
+
+   void Exec(unsigned int slot, double x0, double x1, double x2, double x3) { Push<4>(slot, {{x0, x1, x2, x3}}); }
+
+   // Collections in input: all collections must have the same size, scalars (e.g. weights) are repeated for each element
+   template <typename X0, typename... Xs,
+             std::enable_if_t<IsDataContainer<X0>::value || std::is_same<X0, std::string>::value, int> = 0>
+   void Exec(unsigned int slot, const X0 &x0s, const Xs &... xs)
+   {
+      const auto size = x0s.size();
+      const std::size_t sizes[] = {size, GetSize(xs, size)...};
+      for (auto s : sizes) {
+         if (s != size)
+            throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
+      }
+      for (std::size_t i = 0u; i < size; ++i)
+         Push<1 + sizeof...(Xs)>(slot, {{GetValue(x0s, i), GetValue(xs, i)...}});
+   }
+
+   // ROOT-10092: Filling with a scalar as first column and a collection as second is not supported
+   template <typename X0, typename X1,
+             std::enable_if_t<IsDataContainer<X1>::value && !IsDataContainer<X0>::value, int> = 0>
+   void Exec(unsigned int, const X0 &, const X1 &)
+   {
+      throw std::runtime_error(
+        "Cannot fill object if the type of the first column is a scalar and the one of the second a container.");
+   }
+
+   void Initialize() { /* noop */}
+
+   void FinalizeTask(unsigned int slot) { FlushIfNeeded(slot); }
+
+   void Finalize()
+   {
+      // all buffers have normally been flushed at the end of each task already
+      for (auto slot = 0u; slot < fBuffers.size(); ++slot)
+         FlushIfNeeded(slot);
+   }
+
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      FlushIfNeeded(slot);
+      auto &partialHist = fPartialHists[slot];
+      std::lock_guard<std::mutex> lock(*fMutex);
+      partialHist.reset(new HIST(*fResultHist));
+      partialHist->SetDirectory(nullptr);
+      return *partialHist;
+   }
+
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableFill<HIST>>(*fResultHist);
+   }
+
+   std::string GetActionName() { return "BufferedFill"; }
+};
+
 class FillTGraphHelper : public ROOT::Detail::RDF::RActionImpl<FillTGraphHelper> {
 public:
    using Result_t = ::TGraph;
@@ -1529,6 +1691,40 @@ public:
    }
 };
 
+/// Helper object for a Snapshot action writing an RNTuple, single- or multi-thread
+template <typename... ColTypes>
+class SnapshotRNTupleHelper : public RActionImpl<SnapshotRNTupleHelper<ColTypes...>> {
+   // must use a ptr because RNTupleSnapshotWriter is not movable
+   std::unique_ptr<RNTupleSnapshotWriter> fWriter;
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   SnapshotRNTupleHelper(const unsigned int nSlots, std::string_view filename, std::string_view ntuplename,
+                         const ColumnNames_t &bnames, const RSnapshotOptions &options)
+   {
+      // the output schema follows from the types of the columns, which are known at compile time
+      const std::vector<std::string> typeNames{TypeID2TypeName(typeid(ColTypes))...};
+      fWriter = std::make_unique<RNTupleSnapshotWriter>(nSlots, filename, ntuplename, ReplaceDotWithUnderscore(bnames),
+                                                        typeNames, options);
+   }
+   SnapshotRNTupleHelper(const SnapshotRNTupleHelper &) = delete;
+   SnapshotRNTupleHelper(SnapshotRNTupleHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, ColTypes &... values)
+   {
+      void *const addresses[] = {const_cast<void *>(static_cast<const void *>(&values))..., nullptr};
+      fWriter->Fill(slot, addresses);
+   }
+
+   void Initialize() { fWriter->Initialize(); }
+
+   void Finalize() { fWriter->Finalize(); }
+
+   std::string GetActionName() { return "Snapshot"; }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper : public RActionImpl<AggregateHelper<Acc, Merge, R, T, U, MustCopyAssign>> {
@@ -45,8 +45,12 @@ MakeColumnReader(unsigned int slot, RDFDetail::RDefineBase *define, TTreeReader
 
    // this check must come first!
    // so that Redefine'd columns have precedence over the original columns
-   if (define != nullptr)
+   if (define != nullptr) {
+      // Defines are only wired up (i.e. their own column readers are created) when some node actually reads them:
+      // Defines in scope that no Filter, Define or action uses never get initialized.
+      define->InitSlot(r, slot);
       return Ret_t(new RDefineReader(slot, *define, typeid(T)));
+   }
 
    if (DSValuePtrsPtr != nullptr) {
       // reading from a RDataSource with the old column reader interface
@@ -82,6 +82,10 @@ public:
    /// \brief Gets the column defined up to the node
    std::vector<std::string> GetDefinedColumns() { return fDefinedColumns; }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Appends a line of extra information (e.g. about graph optimizations) to the label of the node
+   void AddAnnotation(const std::string &annotation) { fName += "\n" + annotation; }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Manually sets the counter to a node.
    /// It is used by the root node to set its counter to zero.
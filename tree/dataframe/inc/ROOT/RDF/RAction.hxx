@@ -91,8 +91,6 @@ public:
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
-      for (auto &bookedBranch : GetDefines().GetColumns())
-         bookedBranch.second->InitSlot(r, slot);
       RDFInternal::RColumnReadersInfo info{RActionBase::GetColumnNames(), RActionBase::GetDefines(), fIsDefine.data(),
                                            fLoopManager->GetDSValuePtrs(), fLoopManager->GetDataSource()};
       fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
@@ -109,8 +107,10 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
+      if (fPrevData.CheckFilters(slot, entry)) {
+         RProfileScope profile(fTimer, slot);
          CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      }
    }
 
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
@@ -133,6 +133,8 @@ public:
       SetHasRun();
    }
 
+   std::string GetActionName() final { return fHelper.GetActionName(); }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       auto prevNode = fPrevData.GetGraph();
@@ -140,6 +142,9 @@ public:
 
       // Action nodes do not need to go through CreateFilterNode: they are never common nodes between multiple branches
       auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName());
+      const auto timing = fTimer.GetSummary();
+      if (!timing.empty())
+         thisNode->AddAnnotation(timing);
 
       auto upmostNode = AddDefinesToGraph(thisNode, GetDefines(), prevColumns);
 
@@ -12,6 +12,7 @@
 #define ROOT_RACTIONBASE
 
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
@@ -42,6 +43,7 @@ protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
    RLoopManager *fLoopManager;
+   RNodeTimer fTimer; ///< Time spent executing the action, only recorded if profiling is enabled
 
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
@@ -57,7 +59,8 @@ public:
    virtual ~RActionBase();
 
    const ColumnNames_t &GetColumnNames() const { return fColumnNames; }
-   RBookedDefines &GetDefines() { return fDefines; }
+   // overridden by RJittedAction
+   virtual RBookedDefines &GetDefines() { return fDefines; }
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
@@ -75,6 +78,9 @@ public:
    virtual void SetHasRun() { fHasRun = true; }
 
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
+   virtual std::string GetActionName() = 0;
+   virtual RNodeTimer &GetTimer() { return fTimer; }
+   virtual const RNodeTimer &GetTimer() const { return fTimer; }
 
    /**
       Retrieve a wrapper to the result of the action that knows how to merge
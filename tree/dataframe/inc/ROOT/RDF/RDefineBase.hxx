@@ -13,6 +13,7 @@
 
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 
 #include <deque>
@@ -47,6 +48,7 @@ protected:
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
    const std::map<std::string, std::vector<void *>> &fDSValuePtrs; // reference to RLoopManager's data member
    ROOT::RDF::RDataSource *fDataSource; ///< non-owning ptr to the RDataSource, if any. Used to retrieve column readers.
+   RDFInternal::RNodeTimer fTimer; ///< Time spent evaluating the expression, only recorded if profiling is enabled
 
    static unsigned int GetNextID();
 
@@ -72,6 +74,10 @@ public:
    virtual void FinaliseSlot(unsigned int slot) = 0;
    /// Return the unique identifier of this RDefineBase.
    unsigned int GetID() const { return fID; }
+   /// Return the columns defined before this one, which its expression can depend on.
+   virtual const RDFInternal::RBookedDefines &GetDefines() const { return fDefines; }
+   virtual RDFInternal::RNodeTimer &GetTimer() { return fTimer; }
+   virtual const RDFInternal::RNodeTimer &GetTimer() const { return fTimer; }
 };
 
 } // ns RDF
@@ -13,6 +13,7 @@
 
 #include "ROOT/RDF/RBookedDefines.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "RtypesCore.h"
 #include "TError.h" // R_ASSERT
 
@@ -43,6 +44,7 @@ protected:
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
 
    RDFInternal::RBookedDefines fDefines;
+   RDFInternal::RNodeTimer fTimer; ///< Time spent evaluating this filter, only recorded if profiling is enabled
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -56,6 +58,9 @@ public:
    std::string GetName() const;
    virtual void FillReport(ROOT::RDF::RCutFlowReport &) const;
    virtual void TriggerChildrenCount() = 0;
+   /// Whether other nodes of the computation graph depend on this filter in the current event loop.
+   /// Only meaningful after RLoopManager has evaluated the children counts, i.e. right before the event loop starts.
+   virtual bool HasChildren() const { return fNChildren > 0; }
    virtual void ResetReportCount()
    {
       R__ASSERT(!fName.empty()); // this method is to only be called on named filters
@@ -67,6 +72,9 @@ public:
    virtual void FinaliseSlot(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   virtual const RDFInternal::RBookedDefines &GetDefines() const { return fDefines; }
+   virtual RDFInternal::RNodeTimer &GetTimer() { return fTimer; }
+   virtual const RDFInternal::RNodeTimer &GetTimer() const { return fTimer; }
 };
 
 } // ns RDF
@@ -246,6 +246,10 @@ public:
    /// be valid C++ syntax in which variable names are substituted with the names
    /// of branches/columns.
    ///
+   /// Unnamed filters with the same expression, booked on the same node and with the same columns in scope, are
+   /// merged into a single node of the computation graph, so the expression is evaluated only once per entry.
+   /// Expressions are therefore expected not to have side effects.
+   ///
    /// ### Example usage:
    /// ~~~{.cpp}
    /// auto filtered_df = df.Filter("myCollection.size() > 3");
@@ -253,6 +257,16 @@ public:
    /// ~~~
    RInterface<RDFDetail::RJittedFilter, DS_t> Filter(std::string_view expression, std::string_view name = "")
    {
+      // Unnamed filters with the same expression booked on the same node share the same RJittedFilter.
+      // Named filters are never merged, so that each of them keeps its own entry in the cut-flow report.
+      const auto filterKey =
+         name.empty() ? RDFInternal::MakeJittedNodeKey(name, expression, fProxiedPtr.get(), fDefines) : "";
+      if (!filterKey.empty()) {
+         if (auto sharedFilter = fLoopManager->GetJittedFilter(filterKey))
+            return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(sharedFilter), *fLoopManager, fDefines,
+                                                              fDataSource);
+      }
+
       // deleted by the jitted call to JitFilterHelper
       auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
       using BaseNodeType_t = typename std::remove_pointer_t<decltype(upcastNodeOnHeap)>::element_type;
@@ -263,6 +277,8 @@ public:
                                  fLoopManager->GetBranchNames(), fDefines, fLoopManager->GetTree(), fDataSource);
 
       fLoopManager->Book(jittedFilter.get());
+      if (!filterKey.empty())
+         fLoopManager->RegisterJittedFilter(filterKey, jittedFilter);
       return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(jittedFilter), *fLoopManager, fDefines, fDataSource);
    }
 
@@ -372,6 +388,9 @@ public:
    /// It must be valid C++ syntax in which variable names are substituted with the names
    /// of branches/columns.
    ///
+   /// Identical Defines (same name, expression and columns in scope) share a single node of the computation graph,
+   /// even if they are booked in different branches, so the expression is evaluated only once per entry.
+   ///
    /// Refer to the first overload of this method for the full documentation.
    RInterface<Proxied, DS_t> Define(std::string_view name, std::string_view expression)
    {
@@ -687,6 +706,15 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// In builds with RNTuple support, Snapshot can write an RNTuple called `treename` instead of a TTree.
+   /// Every processing slot serializes and compresses its entries into its own pages, which are committed to the
+   /// output file one cluster at a time, so that writing scales with the number of threads:
+   /// ~~~{.cpp}
+   /// RSnapshotOptions opts;
+   /// opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   /// df.Snapshot("outputNTuple", "outputFile.root", {"x", "v"}, opts);
+   /// ~~~
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -724,7 +752,16 @@ public:
          std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
 
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      std::shared_ptr<ROOT::RDataFrame> newRDF;
+      if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple) {
+         if (!dirname.empty())
+            throw std::runtime_error("Snapshot: RNTuples cannot be written in a TDirectory, got \"" +
+                                     std::string(fullTreeName) + "\" as RNTuple name.");
+         // the output is read back once it has been written, not now
+         newRDF = std::make_shared<ROOT::RDataFrame>(RDFInternal::MakeLazyNTupleDS(treename, filename), validCols);
+      } else {
+         newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      }
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, RDFDetail::RInferredType>(
          validCols, newRDF, snapHelperArgs, validCols.size());
@@ -2317,6 +2354,30 @@ public:
    /// ~~~
    unsigned int GetNRuns() const { return fLoopManager->GetNRuns(); }
 
+   /// \brief Enable or disable profiling of the computation graph this node belongs to.
+   /// \param[in] enable Whether the following event loops should record timing information.
+   ///
+   /// While profiling is enabled, every event loop records the time spent in each Define, Filter and action (as
+   /// measured with cheap time-stamp counters), how busy each processing slot was and how long jitting took.
+   /// The information of the last profiled event loop is returned by GetProfileReport() and added as annotations
+   /// to the output of ROOT::RDF::SaveGraph(). Profiling adds a small overhead per node evaluation, so it is disabled
+   /// by default.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("tree", "file.root");
+   /// df.EnableProfiling();
+   /// auto h = df.Define("y", "x*x").Filter("y > 2").Histo1D("y");
+   /// h->Draw(); // trigger the event loop
+   /// df.GetProfileReport().Print();
+   /// ~~~
+   void EnableProfiling(bool enable = true) { fLoopManager->SetProfiling(enable); }
+
+   /// \brief Return the timing information of the last event loop that ran with profiling enabled.
+   ///
+   /// The report is empty if no event loop ran with profiling enabled. See EnableProfiling().
+   ROOT::RDF::RProfileReport GetProfileReport() const { return fLoopManager->GetProfileReport(); }
+
    /// \brief Get descriptive information about the dataset.
    /// \return Info describing the dataset as a multi-line string
    ///
@@ -2842,7 +2903,16 @@ private:
          std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
 
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      std::shared_ptr<ROOT::RDataFrame> newRDF;
+      if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple) {
+         if (!dirname.empty())
+            throw std::runtime_error("Snapshot: RNTuples cannot be written in a TDirectory, got \"" +
+                                     std::string(fullTreeName) + "\" as RNTuple name.");
+         // the output is read back once it has been written, not now
+         newRDF = std::make_shared<ROOT::RDataFrame>(RDFInternal::MakeLazyNTupleDS(treename, filename), validCols);
+      } else {
+         newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      }
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, ColumnTypes...>(validCols, newRDF, snapHelperArgs);
 
@@ -57,6 +57,10 @@ public:
    void SetHasRun() final;
 
    std::shared_ptr<GraphDrawing::GraphNode> GetGraph();
+   std::string GetActionName() final;
+   RBookedDefines &GetDefines() final;
+   RNodeTimer &GetTimer() final;
+   const RNodeTimer &GetTimer() const final;
 
    // Helper for RMergeableValue
    std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> GetMergeableValue() const final;
@@ -31,6 +31,8 @@ namespace RDF {
 /// before the event-loop starts.
 class RJittedDefine : public RDefineBase {
    std::unique_ptr<RDefineBase> fConcreteDefine = nullptr;
+   /// Number of identical Define bookings that have been merged into this node (see RLoopManager::GetJittedDefine).
+   unsigned int fNMergedBookings = 0;
 
 public:
    RJittedDefine(std::string_view name, std::string_view type, unsigned int nSlots,
@@ -40,6 +42,8 @@ public:
    }
 
    void SetDefine(std::unique_ptr<RDefineBase> c) { fConcreteDefine = std::move(c); }
+   void IncrNMergedBookings() { ++fNMergedBookings; }
+   unsigned int GetNMergedBookings() const { return fNMergedBookings; }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void *GetValuePtr(unsigned int slot) final;
@@ -47,6 +51,9 @@ public:
    void Update(unsigned int slot, Long64_t entry) final;
    void Update(unsigned int slot, const ROOT::RDF::RSampleInfo &id) final;
    void FinaliseSlot(unsigned int slot) final;
+   const RDFInternal::RBookedDefines &GetDefines() const final;
+   RDFInternal::RNodeTimer &GetTimer() final;
+   const RDFInternal::RNodeTimer &GetTimer() const final;
 };
 
 } // ns RDF
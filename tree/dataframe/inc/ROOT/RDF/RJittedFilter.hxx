@@ -38,12 +38,16 @@ namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 /// at a later time, from jitted code.
 class RJittedFilter final : public RFilterBase {
    std::unique_ptr<RFilterBase> fConcreteFilter = nullptr;
+   /// Number of identical Filter bookings that have been merged into this node (see RLoopManager::GetJittedFilter).
+   unsigned int fNMergedBookings = 0;
 
 public:
    RJittedFilter(RLoopManager *lm, std::string_view name);
    ~RJittedFilter() { fLoopManager->Deregister(this); }
 
    void SetFilter(std::unique_ptr<RFilterBase> f);
+   void IncrNMergedBookings() { ++fNMergedBookings; }
+   unsigned int GetNMergedBookings() const { return fNMergedBookings; }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    bool CheckFilters(unsigned int slot, Long64_t entry) final;
@@ -54,10 +58,14 @@ public:
    void StopProcessing() final;
    void ResetChildrenCount() final;
    void TriggerChildrenCount() final;
+   bool HasChildren() const final;
    void ResetReportCount() final;
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
    void FinaliseSlot(unsigned int slot) final;
+   const RDFInternal::RBookedDefines &GetDefines() const final;
+   RDFInternal::RNodeTimer &GetTimer() final;
+   const RDFInternal::RNodeTimer &GetTimer() const final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
 
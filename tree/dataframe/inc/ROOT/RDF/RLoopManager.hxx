@@ -13,12 +13,16 @@
 
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/RNewSampleNotifier.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
+#include "ROOT/RVec.hxx"
 
 #include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // forward declarations
@@ -91,6 +95,8 @@ namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
 
 class RFilterBase;
+class RJittedDefine;
+class RJittedFilter;
 class RRangeBase;
 using ROOT::RDF::RDataSource;
 
@@ -133,6 +139,26 @@ class RLoopManager : public RNodeBase {
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
+   /// Jitted Filters and Defines booked so far, indexed by RDFInternal::MakeJittedNodeKey.
+   /// Identical bookings are served the same node instead of adding a duplicate to the computation graph.
+   std::unordered_map<std::string, std::weak_ptr<RJittedFilter>> fJittedFilters;
+   std::unordered_map<std::string, std::weak_ptr<RJittedDefine>> fJittedDefines;
+
+   bool fProfilingEnabled{false};
+   RDFInternal::RProfiler fProfiler;
+   RDFInternal::RNodeTimer fTimer; ///< Time spent in RunAndCheckFilters, i.e. processing entries through the graph
+   double fJitTime{0.}; ///< Seconds spent jitting since the last event loop
+   ROOT::RDF::RProfileReport fProfileReport; ///< Timing information of the last profiled event loop
+   /// Per-slot pools of RVec heap buffers, active while an entry is processed. Emptied at the end of each event loop.
+   std::vector<std::unique_ptr<ROOT::Internal::VecOps::RVecBufferPool>> fBufferPools;
+
+   /// A node of the computation graph whose timing information is collected when profiling is enabled
+   struct RProfiledNode {
+      std::string fKind;
+      std::string fName;
+      RDFInternal::RNodeTimer *fTimer;
+   };
+
    void CheckIndexedFriends();
    void RunEmptySourceMT();
    void RunEmptySource();
@@ -149,6 +175,10 @@ class RLoopManager : public RNodeBase {
    void SetupSampleCallbacks(TTreeReader *r, unsigned int slot);
    void UpdateSampleInfo(unsigned int slot, const std::pair<ULong64_t, ULong64_t> &range);
    void UpdateSampleInfo(unsigned int slot, TTreeReader &r);
+   std::vector<RProfiledNode> GetProfiledNodes();
+   void ResetProfiling();
+   void FillProfileReport(double realTime, double cpuTime, Long64_t bytesRead);
+   void ResetBufferPools();
 
 public:
    RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches);
@@ -207,6 +237,17 @@ public:
    const ColumnNames_t &GetBranchNames();
 
    void AddSampleCallback(ROOT::RDF::SampleCallback_t &&callback);
+
+   std::shared_ptr<RJittedFilter> GetJittedFilter(const std::string &key);
+   void RegisterJittedFilter(const std::string &key, const std::shared_ptr<RJittedFilter> &filter);
+   std::shared_ptr<RJittedDefine> GetJittedDefine(const std::string &key);
+   void RegisterJittedDefine(const std::string &key, const std::shared_ptr<RJittedDefine> &define);
+
+   /// Enable or disable the collection of timing information in the following event loops.
+   void SetProfiling(bool enable) { fProfilingEnabled = enable; }
+   bool IsProfilingEnabled() const { return fProfilingEnabled; }
+   /// Timing information of the last event loop that ran with profiling enabled. Empty if there was none.
+   const ROOT::RDF::RProfileReport &GetProfileReport() const { return fProfileReport; }
 };
 
 } // ns RDF
@@ -0,0 +1,61 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RNTUPLESNAPSHOTWRITER
+#define ROOT_RDF_RNTUPLESNAPSHOTWRITER
+
+#include "ROOT/RStringView.hxx"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+class RDataSource;
+struct RSnapshotOptions;
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+
+/// Type-erased writer of an RNTuple for Snapshot, usable from multiple processing slots concurrently.
+/// Every slot serializes and compresses its entries into its own page buffers; full clusters are then handed over,
+/// already sealed, to the single page sink of the output file, which is the only place where a lock is taken.
+/// The RNTuple dependency is confined to the implementation, so that this header can be included also in builds
+/// without RNTuple support: in that case the constructor throws.
+class RNTupleSnapshotWriter {
+   struct RImpl;
+   std::unique_ptr<RImpl> fImpl;
+
+public:
+   /// \param[in] typeNames The C++ type names of the values that are passed to Fill, as returned by TypeID2TypeName
+   RNTupleSnapshotWriter(unsigned int nSlots, std::string_view fileName, std::string_view ntupleName,
+                         const std::vector<std::string> &fieldNames, const std::vector<std::string> &typeNames,
+                         const ROOT::RDF::RSnapshotOptions &options);
+   RNTupleSnapshotWriter(const RNTupleSnapshotWriter &) = delete;
+   RNTupleSnapshotWriter &operator=(const RNTupleSnapshotWriter &) = delete;
+   ~RNTupleSnapshotWriter();
+
+   /// Create the output file and the per-slot writers.
+   void Initialize();
+   /// Write one entry: values contains the addresses of the values of the fields, in the order given at construction.
+   void Fill(unsigned int slot, void *const *values);
+   /// Commit the clusters that are still open in the slots and write the RNTuple header and footer.
+   void Finalize();
+};
+
+/// Return a data source that reads the given RNTuple, opening it lazily on first use.
+/// Snapshot needs to create the RDataFrame of its output before the output is written.
+std::unique_ptr<ROOT::RDF::RDataSource> MakeLazyNTupleDS(std::string_view ntupleName, std::string_view fileName);
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RNTUPLESNAPSHOTWRITER
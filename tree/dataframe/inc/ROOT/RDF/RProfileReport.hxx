@@ -0,0 +1,128 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPROFILEREPORT
+#define ROOT_RPROFILEREPORT
+
+#include "RtypesCore.h"
+
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+namespace Detail {
+namespace RDF {
+class RLoopManager;
+} // End NS RDF
+} // End NS Detail
+
+namespace RDF {
+
+/// Time spent in one node of the computation graph during an event loop.
+class RNodeProfile {
+   friend class ROOT::Detail::RDF::RLoopManager;
+
+private:
+   std::string fKind;
+   std::string fName;
+   double fSelfTime;
+   double fTotalTime;
+   ULong64_t fNCalls;
+   RNodeProfile(const std::string &kind, const std::string &name, double selfTime, double totalTime, ULong64_t nCalls)
+      : fKind(kind), fName(name), fSelfTime(selfTime), fTotalTime(totalTime), fNCalls(nCalls)
+   {
+   }
+
+public:
+   /// "Define", "Filter" or the name of the action (e.g. "Fill", "Sum")
+   const std::string &GetKind() const { return fKind; }
+   /// The name of the defined column or of the filter, if any
+   const std::string &GetName() const { return fName; }
+   /// Seconds spent in the node itself, excluding the upstream Defines and Filters it triggered
+   double GetSelfTime() const { return fSelfTime; }
+   /// Seconds spent in the node, including the upstream Defines it triggered
+   double GetTotalTime() const { return fTotalTime; }
+   /// Number of times the node was evaluated
+   ULong64_t GetNCalls() const { return fNCalls; }
+   /// Evaluations per second of self time
+   double GetThroughput() const { return fSelfTime > 0. ? fNCalls / fSelfTime : 0.; }
+};
+
+/// Activity of one processing slot during an event loop.
+class RSlotProfile {
+   friend class ROOT::Detail::RDF::RLoopManager;
+
+private:
+   double fBusyTime;
+   double fProcessingTime;
+   double fIdleTime;
+   ULong64_t fNTasks;
+   ULong64_t fNBufferRequests;
+   ULong64_t fNBuffersReused;
+   RSlotProfile(double busy, double processing, double idle, ULong64_t nTasks, ULong64_t nBufferRequests,
+                ULong64_t nBuffersReused)
+      : fBusyTime(busy), fProcessingTime(processing), fIdleTime(idle), fNTasks(nTasks),
+        fNBufferRequests(nBufferRequests), fNBuffersReused(nBuffersReused)
+   {
+   }
+
+public:
+   /// Seconds spent running tasks
+   double GetBusyTime() const { return fBusyTime; }
+   /// Seconds spent evaluating the computation graph, a subset of the busy time
+   double GetProcessingTime() const { return fProcessingTime; }
+   /// Seconds spent reading data and setting up tasks, i.e. the busy time that was not spent in the graph
+   double GetReadingTime() const { return fBusyTime - fProcessingTime; }
+   /// Seconds of the event loop during which the slot was not running any task
+   double GetIdleTime() const { return fIdleTime; }
+   ULong64_t GetNTasks() const { return fNTasks; }
+   /// Number of RVec heap buffers allocated while processing entries
+   ULong64_t GetNBufferRequests() const { return fNBufferRequests; }
+   /// Number of RVec heap buffers that were recycled from a previous entry instead of being allocated with malloc
+   ULong64_t GetNBuffersReused() const { return fNBuffersReused; }
+};
+
+/// Timing information of the last event loop run with profiling enabled, see RInterface::EnableProfiling().
+class RProfileReport {
+   friend class ROOT::Detail::RDF::RLoopManager;
+
+private:
+   std::vector<RNodeProfile> fNodes;
+   std::vector<RSlotProfile> fSlots;
+   double fJitTime = 0.;
+   double fRealTime = 0.;
+   double fCpuTime = 0.;
+   ULong64_t fNEntries = 0;
+   Long64_t fBytesRead = 0;
+
+public:
+   using const_iterator = typename std::vector<RNodeProfile>::const_iterator;
+   /// Seconds spent just-in-time compiling the computation graph before the event loop
+   double GetJitTime() const { return fJitTime; }
+   /// Wall-clock seconds of the event loop
+   double GetRealTime() const { return fRealTime; }
+   /// CPU seconds of the event loop, summed over all threads
+   double GetCpuTime() const { return fCpuTime; }
+   /// Number of entries processed
+   ULong64_t GetNEntries() const { return fNEntries; }
+   /// Entries processed per wall-clock second
+   double GetThroughput() const { return fRealTime > 0. ? fNEntries / fRealTime : 0.; }
+   /// Bytes read from ROOT files by the whole process during the event loop (see TFile::GetFileBytesRead())
+   Long64_t GetBytesRead() const { return fBytesRead; }
+   const std::vector<RSlotProfile> &GetSlots() const { return fSlots; }
+   const_iterator begin() const { return fNodes.begin(); }
+   const_iterator end() const { return fNodes.end(); }
+   bool IsEmpty() const { return fNodes.empty() && fSlots.empty(); }
+   void Print() const;
+};
+
+} // End NS RDF
+} // End NS ROOT
+
+#endif
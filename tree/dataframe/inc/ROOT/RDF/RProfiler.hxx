@@ -0,0 +1,135 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILER
+#define ROOT_RDF_RPROFILER
+
+#include "ROOT/RDF/Utils.hxx" // kCacheLineSize
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Return a cheap, monotonically increasing timestamp in arbitrary units.
+/// On x86 this reads the time-stamp counter, elsewhere it falls back to std::chrono::steady_clock.
+/// RProfiler converts ticks to seconds by calibrating against steady_clock over the duration of the event loop.
+std::uint64_t ReadTicks();
+
+/// Per-event-loop bookkeeping of the time spent in the computation graph, one instance per RLoopManager.
+/// It records when each processing slot is busy with a task and the ticks spent in nested RProfileScopes, which
+/// RNodeTimer needs to tell the time spent in a node itself from the time spent in the nodes it calls.
+class RProfiler {
+   struct RSlotData {
+      std::uint64_t fNestedTicks = 0; ///< Ticks spent in the scopes nested in the innermost running RProfileScope
+      std::uint64_t fTaskStart = 0;
+      std::uint64_t fBusyTicks = 0; ///< Total ticks spent running tasks
+      ULong64_t fNTasks = 0;
+      char fPadding[kCacheLineSize];
+   };
+
+   std::vector<RSlotData> fSlots;
+   std::uint64_t fStartTicks = 0;
+   std::chrono::steady_clock::time_point fStartTime;
+   double fSecondsPerTick = 0.;
+
+public:
+   void Start(unsigned int nSlots);
+   void Stop();
+   std::uint64_t &NestedTicks(unsigned int slot) { return fSlots[slot].fNestedTicks; }
+   void StartTask(unsigned int slot) { fSlots[slot].fTaskStart = ReadTicks(); }
+   void StopTask(unsigned int slot)
+   {
+      fSlots[slot].fBusyTicks += ReadTicks() - fSlots[slot].fTaskStart;
+      ++fSlots[slot].fNTasks;
+   }
+   unsigned int GetNSlots() const { return fSlots.size(); }
+   double GetBusyTime(unsigned int slot) const { return ToSeconds(fSlots[slot].fBusyTicks); }
+   ULong64_t GetNTasks(unsigned int slot) const { return fSlots[slot].fNTasks; }
+   double ToSeconds(std::uint64_t ticks) const { return ticks * fSecondsPerTick; }
+};
+
+/// Time accounting of a single node of the computation graph.
+/// Disabled (and free, except for one branch per call) unless the RLoopManager enables profiling for the event loop.
+class RNodeTimer {
+   struct RCounters {
+      std::uint64_t fSelfTicks = 0;  ///< Ticks spent in the node, excluding nested nodes
+      std::uint64_t fTotalTicks = 0; ///< Ticks spent in the node, including nested nodes
+      ULong64_t fNCalls = 0;
+      char fPadding[kCacheLineSize];
+   };
+
+   RProfiler *fProfiler = nullptr;
+   std::vector<RCounters> fCounters;
+
+public:
+   /// Reset the counters and start recording if profiler is not null, stop recording otherwise.
+   void Reset(RProfiler *profiler, unsigned int nSlots)
+   {
+      fProfiler = profiler;
+      fCounters.assign(profiler != nullptr ? nSlots : 0u, RCounters());
+   }
+   bool IsEnabled() const { return fProfiler != nullptr; }
+   RProfiler *GetProfiler() const { return fProfiler; }
+   void Add(unsigned int slot, std::uint64_t selfTicks, std::uint64_t totalTicks)
+   {
+      auto &c = fCounters[slot];
+      c.fSelfTicks += selfTicks;
+      c.fTotalTicks += totalTicks;
+      ++c.fNCalls;
+   }
+   double GetSelfTime() const;
+   double GetTotalTime() const;
+   double GetTotalTime(unsigned int slot) const { return fProfiler->ToSeconds(fCounters[slot].fTotalTicks); }
+   ULong64_t GetNCalls() const;
+   /// Return a short human-readable summary of the timing information, or an empty string if nothing was recorded.
+   std::string GetSummary() const;
+};
+
+/// RAII helper that attributes the ticks elapsed during its lifetime to a RNodeTimer.
+/// Ticks spent in RProfileScopes nested inside this one (e.g. a Define evaluated while checking a Filter) are
+/// subtracted from this node's self time.
+class RProfileScope {
+   RNodeTimer *fTimer;
+   unsigned int fSlot;
+   std::uint64_t fStart = 0;
+   std::uint64_t fOuterNestedTicks = 0;
+
+public:
+   RProfileScope(RNodeTimer &timer, unsigned int slot) : fTimer(timer.IsEnabled() ? &timer : nullptr), fSlot(slot)
+   {
+      if (fTimer == nullptr)
+         return;
+      auto &nested = fTimer->GetProfiler()->NestedTicks(fSlot);
+      fOuterNestedTicks = nested;
+      nested = 0;
+      fStart = ReadTicks();
+   }
+   RProfileScope(const RProfileScope &) = delete;
+   RProfileScope &operator=(const RProfileScope &) = delete;
+   ~RProfileScope()
+   {
+      if (fTimer == nullptr)
+         return;
+      const auto elapsed = ReadTicks() - fStart;
+      auto &nested = fTimer->GetProfiler()->NestedTicks(fSlot);
+      fTimer->Add(fSlot, elapsed > nested ? elapsed - nested : 0u, elapsed);
+      nested = fOuterNestedTicks + elapsed;
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RPROFILER
@@ -181,6 +181,34 @@ RNode AsRNode(NodeType node)
 // clang-format on
 void RunGraphs(std::vector<RResultHandle> handles);
 
+namespace Experimental {
+
+// clang-format off
+/// Set the memory budget for the per-slot copies of histograms filled in multi-thread event loops
+/// \param[in] nBytes Maximum amount of memory, in bytes, that the copies of a single histogram can take.
+///
+/// In multi-thread event loops, histograms are normally filled through one copy per processing slot, and the copies
+/// are merged at the end of the event loop. For histograms with many bins and many slots this takes a lot of memory and
+/// makes the final merge slow. If the copies of a histogram would take more than `nBytes` in total, RDataFrame fills a
+/// single histogram shared by all slots instead: each slot buffers a batch of fills, which is then flushed into the
+/// shared histogram under a lock.
+///
+/// The choice is made separately for each action, when the action is built (i.e. when it is booked, or right before
+/// the event loop for actions whose column types are inferred via just-in-time compilation). It only applies to event
+/// loops with more than one processing slot: with a single slot the result histogram is always filled directly. A
+/// threshold of 0 selects the shared histogram for every action of a multi-thread event loop. The default is 256 MB.
+///
+/// Only histograms deriving from TH1 (Histo1D, Histo2D, Histo3D, Profile1D, Profile2D, and Fill() with a TH1) can be
+/// filled through a shared copy. Other objects passed to Fill(), e.g. a THnSparse, are always filled through per-slot
+/// copies: in particular the memory taken by a sparse histogram is not known when the action is built.
+// clang-format on
+void SetSharedFillThreshold(std::size_t nBytes);
+
+/// Return the current memory budget for per-slot copies of histograms, see SetSharedFillThreshold().
+std::size_t GetSharedFillThreshold();
+
+} // namespace Experimental
+
 } // namespace RDF
 } // namespace ROOT
 #endif
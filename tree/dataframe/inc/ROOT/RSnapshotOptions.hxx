@@ -18,6 +18,13 @@
 namespace ROOT {
 
 namespace RDF {
+/// The format of the dataset written by Snapshot
+enum class ESnapshotOutputFormat {
+   kDefault, ///< Currently a TTree
+   kTTree,
+   kRNTuple ///< Requires ROOT to be built with root7=ON; the tree name is used as the name of the RNTuple
+};
+
 /// A collection of options to steer the creation of the dataset on file
 struct RSnapshotOptions {
    using ECAlgo = ROOT::ECompressionAlgorithm;
@@ -37,6 +44,7 @@ struct RSnapshotOptions {
    int fSplitLevel = 99;                       ///< Split level of output tree
    bool fLazy = false;                         ///< Do not start the event loop when Snapshot is called
    bool fOverwriteIfExists = false; ///< If fMode is "UPDATE", overwrite object in output file if it already exists
+   ESnapshotOutputFormat fOutputFormat = ESnapshotOutputFormat::kDefault; ///< Write a TTree or an RNTuple
 };
 } // ns RDF
 } // ns ROOT
@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "ROOT/RDFHelpers.hxx" // GetSharedFillThreshold
 
 namespace ROOT {
 namespace Internal {
@@ -116,6 +117,16 @@ template void FillHelper::Exec(unsigned int, const std::vector<char> &, const st
 template void FillHelper::Exec(unsigned int, const std::vector<int> &, const std::vector<int> &);
 template void FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vector<unsigned int> &);
 
+bool UseSharedFill(const TH1 &h, unsigned int nSlots)
+{
+   if (nSlots < 2)
+      return false;
+   // approximate size of the clones that FillParHelper would create for all slots but the first
+   const std::size_t nArrays = h.GetSumw2N() > 0 ? 2 : 1;
+   const std::size_t cloneSize = nArrays * sizeof(double) * static_cast<std::size_t>(h.GetNcells());
+   return (nSlots - 1) * cloneSize > ROOT::RDF::Experimental::GetSharedFillThreshold();
+}
+
 // TODO
 // template void MinHelper::Exec(unsigned int, const std::vector<float> &);
 // template void MinHelper::Exec(unsigned int, const std::vector<double> &);
@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RJittedDefine.hxx"
 #include "ROOT/RDF/GraphUtils.hxx"
 
 #include <algorithm> // std::find
@@ -100,6 +101,13 @@ CreateDefineNode(const std::string &columnName, const ROOT::Detail::RDF::RDefine
 
    auto node = std::make_shared<GraphNode>("Define\n" + columnName);
    node->SetDefine();
+   const auto *jittedDefine = dynamic_cast<const ROOT::Detail::RDF::RJittedDefine *>(columnPtr);
+   if (jittedDefine != nullptr && jittedDefine->GetNMergedBookings() > 0)
+      node->AddAnnotation("(" + std::to_string(jittedDefine->GetNMergedBookings() + 1) +
+                          " identical bookings merged)");
+   const auto timing = columnPtr->GetTimer().GetSummary();
+   if (!timing.empty())
+      node->AddAnnotation(timing);
 
    sColumnsMap[columnPtr] = node;
    return node;
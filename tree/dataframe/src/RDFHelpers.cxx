@@ -16,10 +16,29 @@
 #include "ROOT/TThreadExecutor.hxx"
 #endif // R__USE_IMT
 
+#include <atomic>
 #include <set>
 
 using ROOT::RDF::RResultHandle;
 
+namespace {
+std::atomic<std::size_t> &SharedFillThreshold()
+{
+   static std::atomic<std::size_t> threshold{256u * 1024u * 1024u};
+   return threshold;
+}
+} // anonymous namespace
+
+void ROOT::RDF::Experimental::SetSharedFillThreshold(std::size_t nBytes)
+{
+   SharedFillThreshold() = nBytes;
+}
+
+std::size_t ROOT::RDF::Experimental::GetSharedFillThreshold()
+{
+   return SharedFillThreshold();
+}
+
 void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
 {
    if (handles.empty()) {
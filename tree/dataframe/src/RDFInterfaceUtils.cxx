@@ -620,6 +620,26 @@ std::string PrettyPrintAddr(const void *const addr)
    return s.str();
 }
 
+/// Return a string that identifies a jitted Filter or Define booking. Two bookings with the same key are guaranteed to
+/// compute the same values, so RLoopManager can serve them the same node of the computation graph.
+/// Columns in scope are identified by the address of their RDefineBase, so that Defines with the same name in
+/// different branches of the graph are told apart. prevNode is null for Defines, which do not depend on upstream
+/// Filters.
+std::string MakeJittedNodeKey(std::string_view name, std::string_view expression, const RNodeBase *prevNode,
+                              const RBookedDefines &defines)
+{
+   std::stringstream key;
+   key << name << '\n' << expression << '\n' << PrettyPrintAddr(prevNode);
+   const auto &defineMap = defines.GetColumns();
+   for (const auto &colName : defines.GetNames()) {
+      key << '\n' << colName;
+      const auto defineIt = defineMap.find(colName);
+      if (defineIt != defineMap.end()) // aliases have no corresponding RDefineBase
+         key << '@' << PrettyPrintAddr(defineIt->second.get());
+   }
+   return key.str();
+}
+
 /// Book the jitting of a Filter call
 void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
                    std::shared_ptr<RDFDetail::RNodeBase> *prevNodeOnHeap, std::string_view name,
@@ -672,6 +692,13 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
                                              const ColumnNames_t &branches,
                                              std::shared_ptr<RNodeBase> *upcastNodeOnHeap)
 {
+   // an identical Define might have already been booked, possibly in a different branch of the computation graph
+   const auto defineKey = MakeJittedNodeKey(name, expression, /*prevNode=*/nullptr, customCols);
+   if (auto sharedDefine = lm.GetJittedDefine(defineKey)) {
+      delete upcastNodeOnHeap;
+      return sharedDefine;
+   }
+
    const auto &aliasMap = lm.GetAliasMap();
    auto *const tree = lm.GetTree();
    const auto &dsColumns = ds ? ds->GetColumnNames() : ColumnNames_t{};
@@ -708,6 +735,7 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
                     << PrettyPrintAddr(upcastNodeOnHeap) << "));\n";
 
    lm.ToJitExec(defineInvocation.str());
+   lm.RegisterJittedDefine(defineKey, jittedDefine);
    return jittedDefine;
 }
 
@@ -84,6 +84,27 @@ std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::Get
    return fConcreteAction->GetGraph();
 }
 
+std::string RJittedAction::GetActionName()
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetActionName();
+}
+
+ROOT::Internal::RDF::RBookedDefines &RJittedAction::GetDefines()
+{
+   return fConcreteAction != nullptr ? fConcreteAction->GetDefines() : RActionBase::GetDefines();
+}
+
+ROOT::Internal::RDF::RNodeTimer &RJittedAction::GetTimer()
+{
+   return fConcreteAction != nullptr ? fConcreteAction->GetTimer() : fTimer;
+}
+
+const ROOT::Internal::RDF::RNodeTimer &RJittedAction::GetTimer() const
+{
+   return fConcreteAction != nullptr ? fConcreteAction->GetTimer() : fTimer;
+}
+
 /**
    Retrieve a wrapper to the result of the action that knows how to merge
    with others of the same type.
@@ -48,3 +48,18 @@ void RJittedDefine::FinaliseSlot(unsigned int slot)
    R__ASSERT(fConcreteDefine != nullptr);
    fConcreteDefine->FinaliseSlot(slot);
 }
+
+const ROOT::Internal::RDF::RBookedDefines &RJittedDefine::GetDefines() const
+{
+   return fConcreteDefine != nullptr ? fConcreteDefine->GetDefines() : fDefines;
+}
+
+ROOT::Internal::RDF::RNodeTimer &RJittedDefine::GetTimer()
+{
+   return fConcreteDefine != nullptr ? fConcreteDefine->GetTimer() : fTimer;
+}
+
+const ROOT::Internal::RDF::RNodeTimer &RJittedDefine::GetTimer() const
+{
+   return fConcreteDefine != nullptr ? fConcreteDefine->GetTimer() : fTimer;
+}
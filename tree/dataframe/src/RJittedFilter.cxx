@@ -77,6 +77,12 @@ void RJittedFilter::TriggerChildrenCount()
    fConcreteFilter->TriggerChildrenCount();
 }
 
+bool RJittedFilter::HasChildren() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->HasChildren();
+}
+
 void RJittedFilter::ResetReportCount()
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -104,11 +110,30 @@ void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
    fConcreteFilter->AddFilterName(filters);
 }
 
+const RDFInternal::RBookedDefines &RJittedFilter::GetDefines() const
+{
+   return fConcreteFilter != nullptr ? fConcreteFilter->GetDefines() : fDefines;
+}
+
+RDFInternal::RNodeTimer &RJittedFilter::GetTimer()
+{
+   return fConcreteFilter != nullptr ? fConcreteFilter->GetTimer() : fTimer;
+}
+
+const RDFInternal::RNodeTimer &RJittedFilter::GetTimer() const
+{
+   return fConcreteFilter != nullptr ? fConcreteFilter->GetTimer() : fTimer;
+}
+
 std::shared_ptr<RDFGraphDrawing::GraphNode> RJittedFilter::GetGraph()
 {
    if (fConcreteFilter != nullptr) {
       // Here the filter exists, so it can be served
-      return fConcreteFilter->GetGraph();
+      auto thisNode = fConcreteFilter->GetGraph();
+      // the node is returned again for every branch that shares it, but it must only be annotated once
+      if (fNMergedBookings > 0 && thisNode->GetIsNew())
+         thisNode->AddAnnotation("(" + std::to_string(fNMergedBookings + 1) + " identical bookings merged)");
+      return thisNode;
    }
    throw std::runtime_error("The Jitting should have been invoked before this method.");
 }
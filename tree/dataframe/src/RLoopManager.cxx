@@ -12,6 +12,8 @@
 #include "ROOT/InternalTreeUtils.hxx" // GetTreeFullPaths
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RJittedDefine.hxx"
+#include "ROOT/RDF/RJittedFilter.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RSlotStack.hxx"
@@ -248,6 +250,28 @@ struct MaxTreeSizeRAII {
    ~MaxTreeSizeRAII() { TTree::SetMaxTreeSize(fOldMaxTreeSize); }
 };
 
+/**
+\struct BufferPoolsRAII
+\brief Scope-bound release of the buffers cached in the RVec buffer pools of the processing slots.
+
+The buffers are only useful within an event loop: this RAII object frees them at destruction time,
+also when the event loop is interrupted by an exception.
+*/
+struct BufferPoolsRAII {
+   const std::vector<std::unique_ptr<ROOT::Internal::VecOps::RVecBufferPool>> &fPools;
+
+   explicit BufferPoolsRAII(const std::vector<std::unique_ptr<ROOT::Internal::VecOps::RVecBufferPool>> &pools)
+      : fPools(pools)
+   {
+   }
+
+   ~BufferPoolsRAII()
+   {
+      for (auto &pool : fPools)
+         pool->Clear();
+   }
+};
+
 struct DatasetLogInfo {
    std::string fDataSet;
    ULong64_t fRangeStart;
@@ -575,6 +599,10 @@ void RLoopManager::RunDataSourceMT()
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
 void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
+   RProfileScope profile(fTimer, slot);
+   // RVecs allocated and destroyed while processing the entry recycle the buffers of the previous entries
+   ROOT::Internal::VecOps::RVecBufferPoolScope bufferPool(*fBufferPools[slot]);
+
    // data-block callbacks run before the rest of the graph
    if (fNewSampleNotifier.CheckFlag(slot)) {
       for (auto &callback : fSampleCallbacks) {
@@ -594,13 +622,19 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitSlot` method, to get them ready for running a task.
+/// Unnamed filters that no action depends on are never evaluated during the event loop, so they are skipped.
+/// Defines are initialized lazily by the nodes that read them, so unused Defines are skipped as well.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   if (fTimer.IsEnabled())
+      fProfiler.StartTask(slot);
    SetupSampleCallbacks(r, slot);
    for (auto &ptr : fBookedActions)
       ptr->InitSlot(r, slot);
-   for (auto &ptr : fBookedFilters)
-      ptr->InitSlot(r, slot);
+   for (auto &ptr : fBookedFilters) {
+      if (ptr->HasName() || ptr->HasChildren())
+         ptr->InitSlot(r, slot);
+   }
    for (auto &callback : fCallbacksOnce)
       callback(slot);
 }
@@ -691,6 +725,8 @@ void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
       ptr->FinalizeSlot(slot);
    for (auto &ptr : fBookedFilters)
       ptr->FinaliseSlot(slot);
+   if (fTimer.IsEnabled())
+      fProfiler.StopTask(slot);
 }
 
 /// Add RDF nodes that require just-in-time compilation to the computation graph.
@@ -710,6 +746,7 @@ void RLoopManager::Jit()
    s.Start();
    RDFInternal::InterpreterCalc(code, "RLoopManager::Run");
    s.Stop();
+   fJitTime += s.RealTime();
    R__LOG_INFO(RDFLogChannel()) << "Just-in-time compilation phase completed"
                                 << (s.RealTime() > 1e-3 ? " in " + std::to_string(s.RealTime()) + " seconds." : ".");
 }
@@ -728,6 +765,98 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Return the nodes that take part in the next event loop, paired with a description for the profile report.
+/// Defines are collected from the scope of the actions and filters, each only once.
+std::vector<RLoopManager::RProfiledNode> RLoopManager::GetProfiledNodes()
+{
+   std::vector<RProfiledNode> nodes;
+   std::set<const RDefineBase *> seenDefines;
+   auto addDefines = [&nodes, &seenDefines](const RBookedDefines &defines) {
+      for (const auto &d : defines.GetColumns()) {
+         if (!IsInternalColumn(d.first) && seenDefines.insert(d.second.get()).second)
+            nodes.push_back({"Define", d.first, &d.second->GetTimer()});
+      }
+   };
+
+   for (auto *filter : fBookedFilters) {
+      nodes.push_back({"Filter", filter->GetName(), &filter->GetTimer()});
+      addDefines(filter->GetDefines());
+   }
+   for (auto *action : fBookedActions) {
+      nodes.push_back({action->GetActionName(), "", &action->GetTimer()});
+      addDefines(action->GetDefines());
+   }
+   return nodes;
+}
+
+/// Start or stop recording timing information in all nodes, depending on whether profiling is enabled.
+/// Called right before every event loop, after jitting, so that all jitted nodes have their concrete counterpart.
+void RLoopManager::ResetProfiling()
+{
+   auto *profiler = fProfilingEnabled ? &fProfiler : nullptr;
+   if (profiler != nullptr)
+      fProfiler.Start(fNSlots);
+   fTimer.Reset(profiler, fNSlots);
+   for (auto *filter : fBookedFilters)
+      filter->GetTimer().Reset(profiler, fNSlots);
+   for (auto *action : fBookedActions)
+      action->GetTimer().Reset(profiler, fNSlots);
+
+   // All defines are visited through the scopes of the defines themselves too: a Define shadowed by a Redefine is not
+   // in the scope of any filter or action (nor in the report), but it is still evaluated by the Redefine.
+   std::set<RDefineBase *> seenDefines;
+   std::function<void(const RBookedDefines &)> resetDefines = [&](const RBookedDefines &defines) {
+      for (const auto &d : defines.GetColumns()) {
+         if (seenDefines.insert(d.second.get()).second) {
+            d.second->GetTimer().Reset(profiler, fNSlots);
+            resetDefines(d.second->GetDefines());
+         }
+      }
+   };
+   for (auto *filter : fBookedFilters)
+      resetDefines(filter->GetDefines());
+   for (auto *action : fBookedActions)
+      resetDefines(action->GetDefines());
+}
+
+/// Collect the timing information recorded by the nodes during the event loop that just finished.
+void RLoopManager::FillProfileReport(double realTime, double cpuTime, Long64_t bytesRead)
+{
+   fProfiler.Stop();
+
+   ROOT::RDF::RProfileReport report;
+   report.fJitTime = fJitTime;
+   report.fRealTime = realTime;
+   report.fCpuTime = cpuTime;
+   report.fNEntries = fTimer.GetNCalls();
+   report.fBytesRead = bytesRead;
+   for (const auto &node : GetProfiledNodes()) {
+      const auto &t = *node.fTimer;
+      report.fNodes.push_back(
+         ROOT::RDF::RNodeProfile(node.fKind, node.fName, t.GetSelfTime(), t.GetTotalTime(), t.GetNCalls()));
+   }
+   for (auto slot = 0u; slot < fNSlots; ++slot) {
+      const auto busy = fProfiler.GetBusyTime(slot);
+      const auto &pool = *fBufferPools[slot];
+      report.fSlots.push_back(ROOT::RDF::RSlotProfile(busy, fTimer.GetTotalTime(slot), std::max(0., realTime - busy),
+                                                      fProfiler.GetNTasks(slot), pool.GetNRequests(),
+                                                      pool.GetNReused()));
+   }
+   fProfileReport = std::move(report);
+}
+
+/// Make sure each slot has an RVec buffer pool and reset their counters.
+void RLoopManager::ResetBufferPools()
+{
+   if (fBufferPools.size() != fNSlots) {
+      fBufferPools.clear();
+      for (auto slot = 0u; slot < fNSlots; ++slot)
+         fBufferPools.emplace_back(new ROOT::Internal::VecOps::RVecBufferPool());
+   }
+   for (auto &pool : fBufferPools)
+      pool->ResetCounters();
+}
+
 /// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 void RLoopManager::Run()
@@ -743,6 +872,11 @@ void RLoopManager::Run()
 
    InitNodes();
 
+   ResetProfiling();
+   ResetBufferPools();
+   BufferPoolsRAII bufferPools(fBufferPools);
+   const auto bytesReadBefore = TFile::GetFileBytesRead();
+
    TStopwatch s;
    s.Start();
    switch (fLoopType) {
@@ -755,6 +889,10 @@ void RLoopManager::Run()
    }
    s.Stop();
 
+   if (fTimer.IsEnabled())
+      FillProfileReport(s.RealTime(), s.CpuTime(), TFile::GetFileBytesRead() - bytesReadBefore);
+   fJitTime = 0.;
+
    CleanUpNodes();
 
    fNRuns++;
@@ -875,6 +1013,10 @@ std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RLoopManager::GetG
    }
 
    auto thisNode = std::make_shared<ROOT::Internal::RDF::GraphDrawing::GraphNode>(name);
+   if (!fProfileReport.IsEmpty()) {
+      thisNode->AddAnnotation(std::to_string(fProfileReport.GetNEntries()) + " entries in " +
+                              std::to_string(fProfileReport.GetRealTime()) + " s");
+   }
    thisNode->SetRoot();
    thisNode->SetCounter(0);
    return thisNode;
@@ -906,3 +1048,45 @@ void RLoopManager::AddSampleCallback(SampleCallback_t &&callback)
    if (callback)
       fSampleCallbacks.emplace_back(std::move(callback));
 }
+
+////////////////////////////////////////////////////////////////////////////
+/// Return the jitted Filter previously registered with this key, or a null pointer if there is none (anymore).
+/// A successful lookup counts as a merged booking, which is reported in the SaveGraph output.
+std::shared_ptr<RJittedFilter> RLoopManager::GetJittedFilter(const std::string &key)
+{
+   auto it = fJittedFilters.find(key);
+   if (it == fJittedFilters.end())
+      return nullptr;
+   auto filter = it->second.lock();
+   if (filter)
+      filter->IncrNMergedBookings();
+   else
+      fJittedFilters.erase(it);
+   return filter;
+}
+
+void RLoopManager::RegisterJittedFilter(const std::string &key, const std::shared_ptr<RJittedFilter> &filter)
+{
+   fJittedFilters[key] = filter;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Return the jitted Define previously registered with this key, or a null pointer if there is none (anymore).
+/// A successful lookup counts as a merged booking, which is reported in the SaveGraph output.
+std::shared_ptr<RJittedDefine> RLoopManager::GetJittedDefine(const std::string &key)
+{
+   auto it = fJittedDefines.find(key);
+   if (it == fJittedDefines.end())
+      return nullptr;
+   auto define = it->second.lock();
+   if (define)
+      define->IncrNMergedBookings();
+   else
+      fJittedDefines.erase(it);
+   return define;
+}
+
+void RLoopManager::RegisterJittedDefine(const std::string &key, const std::shared_ptr<RJittedDefine> &define)
+{
+   fJittedDefines[key] = define;
+}
@@ -25,6 +25,7 @@
 
 #include <TError.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -107,10 +108,28 @@ class RNTupleColumnReader : public ROOT::Detail::RDF::RColumnReaderBase {
    std::unique_ptr<RFieldBase> fField; ///< The field backing the RDF column
    RFieldValue fValue;                 ///< The memory location used to read from fField
    Long64_t fLastEntry;                ///< Last entry number that was read
+   /// For simple fields, values are served directly from the page buffer. The following members describe the
+   /// window of entries [fFirstMappedEntry, fFirstMappedEntry + fNMappedEntries) that is currently mapped.
+   unsigned char *fMappedValues = nullptr;
+   Long64_t fFirstMappedEntry = -1;
+   Long64_t fNMappedEntries = 0;
+   std::size_t fValueSize; ///< Size of a single value, used to step through the mapped page
+
+   /// Serve the value at entry from the mapped page, mapping a new page only when entry leaves the current window
+   void *MapImpl(Long64_t entry)
+   {
+      if (entry < fFirstMappedEntry || entry >= fFirstMappedEntry + fNMappedEntries) {
+         NTupleSize_t nItems = 0;
+         fMappedValues = static_cast<unsigned char *>(fField->MapV(entry, nItems));
+         fFirstMappedEntry = entry;
+         fNMappedEntries = nItems;
+      }
+      return fMappedValues + (entry - fFirstMappedEntry) * fValueSize;
+   }
 
 public:
    RNTupleColumnReader(std::unique_ptr<RFieldBase> f)
-      : fField(std::move(f)), fValue(fField->GenerateValue()), fLastEntry(-1)
+      : fField(std::move(f)), fValue(fField->GenerateValue()), fLastEntry(-1), fValueSize(fField->GetValueSize())
    {
    }
    virtual ~RNTupleColumnReader() { fField->DestroyValue(fValue); }
@@ -131,6 +150,9 @@ public:
 
    void *GetImpl(Long64_t entry) final
    {
+      if (fField->IsSimple())
+         return MapImpl(entry);
+
       if (entry != fLastEntry) {
          fField->Read(entry, &fValue);
          fLastEntry = entry;
@@ -273,24 +295,43 @@ bool RNTupleDS::SetEntry(unsigned int, ULong64_t)
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 {
-   // TODO(jblomer): use cluster boundaries for the entry ranges
    std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
    if (fHasSeenAllRanges)
       return ranges;
+   fHasSeenAllRanges = true;
+
+   const auto nEntries = fSources[0]->GetNEntries();
+   if (nEntries == 0)
+      return ranges;
+   if (fNSlots == 1) {
+      ranges.emplace_back(0, nEntries);
+      return ranges;
+   }
 
-   auto nEntries = fSources[0]->GetNEntries();
-   const auto chunkSize = nEntries / fNSlots;
-   const auto reminder = 1U == fNSlots ? 0 : nEntries % fNSlots;
-   auto start = 0UL;
-   auto end = 0UL;
-   for (auto i : ROOT::TSeqU(fNSlots)) {
-      start = end;
-      end += chunkSize;
-      ranges.emplace_back(start, end);
-      (void)i;
+   // Ranges never cross cluster boundaries, so that every cluster is read and decompressed by a single slot only.
+   // Consecutive clusters are grouped until a range holds about nEntries / (kNRangesPerSlot * fNSlots) entries;
+   // more ranges than slots give the thread pool some room for load balancing.
+   std::vector<std::pair<ULong64_t, ULong64_t>> clusters;
+   const auto &desc = fSources[0]->GetDescriptor();
+   clusters.reserve(desc.GetNClusters());
+   for (const auto &c : desc.GetClusterIterable()) {
+      const ULong64_t first = c.GetFirstEntryIndex();
+      clusters.emplace_back(first, first + c.GetNEntries());
+   }
+   std::sort(clusters.begin(), clusters.end());
+
+   constexpr unsigned int kNRangesPerSlot = 2;
+   const ULong64_t targetSize = std::max<ULong64_t>(1, nEntries / (kNRangesPerSlot * fNSlots));
+   for (const auto &c : clusters) {
+      if (c.first == c.second)
+         continue;
+      if (ranges.empty() || (ranges.back().second - ranges.back().first) >= targetSize ||
+          ranges.back().second != c.first) {
+         ranges.emplace_back(c);
+      } else {
+         ranges.back().second = c.second;
+      }
    }
-   ranges.back().second += reminder;
-   fHasSeenAllRanges = true;
    return ranges;
 }
 
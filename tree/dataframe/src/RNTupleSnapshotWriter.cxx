@@ -0,0 +1,397 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RNTupleSnapshotWriter.hxx"
+#include "ROOT/RDataSource.hxx"
+#include "ROOT/RSnapshotOptions.hxx"
+
+#include <stdexcept>
+
+#ifdef R__RDF_HAS_RNTUPLE
+
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "ROOT/RNTuple.hxx"
+#include "ROOT/RNTupleDS.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleOptions.hxx"
+#include "ROOT/RField.hxx"
+#include "ROOT/RPageAllocator.hxx"
+#include "ROOT/RPageStorage.hxx"
+#include "ROOT/RPageStorageFile.hxx"
+#include "ROOT/RVec.hxx"
+#include "Compression.h"
+#include "TFile.h"
+
+#include <cstring> // std::memcpy
+#include <mutex>
+
+namespace {
+
+using ROOT::Experimental::NTupleSize_t;
+using ROOT::Experimental::REntry;
+using ROOT::Experimental::RField;
+using ROOT::Experimental::RNTupleModel;
+using ROOT::Experimental::RNTupleWriter;
+using ROOT::Experimental::Detail::RFieldBase;
+using ROOT::Experimental::Detail::RPage;
+using ROOT::Experimental::Detail::RPageSink;
+
+/// The page sink of the output file together with the state shared by the slots that feed it.
+struct RSharedSink {
+   std::unique_ptr<TFile> fFile; ///< Only set in "UPDATE" mode, when the RNTuple is added to an existing file
+   std::unique_ptr<RPageSink> fSink;
+   /// The model the shared sink was created from. Every slot writes through a clone of it, so that column ids match.
+   std::unique_ptr<RNTupleModel> fModel;
+   std::mutex fMutex;
+   NTupleSize_t fNEntries = 0; ///< Number of entries in the clusters committed so far
+};
+
+/// Page sink of a single processing slot. Pages are sealed (packed and compressed) by the slot's thread as soon as the
+/// slot's columns fill them; when the slot's writer closes a cluster, the sealed pages are moved to the shared sink
+/// as a new cluster of the output RNTuple. Clusters are self-contained (collection offsets are cluster-local), so the
+/// clusters of different slots can be interleaved freely.
+class RPageSinkSlot final : public RPageSink {
+   struct RSealedPageBuf {
+      std::unique_ptr<unsigned char[]> fBuf;
+      RSealedPage fSealedPage;
+   };
+
+   RSharedSink &fShared;
+   /// Sealed pages of the currently open cluster. Indexed by column id.
+   std::vector<std::vector<RSealedPageBuf>> fSealedPages;
+
+   void AddSealedPage(ROOT::Experimental::DescriptorId_t columnId, const RSealedPage &sealedPage, void *buf)
+   {
+      RSealedPageBuf item;
+      item.fBuf.reset(static_cast<unsigned char *>(buf));
+      if (sealedPage.fBuffer != buf)
+         std::memcpy(item.fBuf.get(), sealedPage.fBuffer, sealedPage.fSize);
+      item.fSealedPage = RSealedPage(item.fBuf.get(), sealedPage.fSize, sealedPage.fNElements);
+      fSealedPages[columnId].emplace_back(std::move(item));
+   }
+
+protected:
+   void CreateImpl(const RNTupleModel & /*model*/) final { fSealedPages.resize(fLastColumnId); }
+
+   ROOT::Experimental::RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final
+   {
+      // packing and compression never make a page larger (RNTupleCompressor stores incompressible data as is)
+      auto buf = new unsigned char[page.GetNBytes()];
+      auto sealedPage = SealPage(page, *columnHandle.fColumn->GetElement(), GetWriteOptions().GetCompression(), buf);
+      AddSealedPage(columnHandle.fId, sealedPage, buf);
+      // the locator is not used: the descriptor of the slot sink is never written out
+      return ROOT::Experimental::RClusterDescriptor::RLocator{};
+   }
+
+   ROOT::Experimental::RClusterDescriptor::RLocator
+   CommitSealedPageImpl(ROOT::Experimental::DescriptorId_t columnId, const RSealedPage &sealedPage) final
+   {
+      AddSealedPage(columnId, sealedPage, new unsigned char[sealedPage.fSize]);
+      return ROOT::Experimental::RClusterDescriptor::RLocator{};
+   }
+
+   std::uint64_t CommitClusterImpl(NTupleSize_t nEntries) final
+   {
+      std::uint64_t nBytes = 0;
+      {
+         std::lock_guard<std::mutex> lock(fShared.fMutex);
+         for (std::size_t columnId = 0; columnId < fSealedPages.size(); ++columnId) {
+            for (const auto &item : fSealedPages[columnId]) {
+               fShared.fSink->CommitSealedPage(columnId, item.fSealedPage);
+               nBytes += item.fSealedPage.fSize;
+            }
+         }
+         // nEntries counts the entries of this slot only
+         fShared.fNEntries += nEntries - fPrevClusterNEntries;
+         fShared.fSink->CommitCluster(fShared.fNEntries);
+      }
+      for (auto &pages : fSealedPages)
+         pages.clear();
+      return nBytes;
+   }
+
+   /// The dataset is committed once, by the shared sink
+   void CommitDatasetImpl() final {}
+
+public:
+   explicit RPageSinkSlot(RSharedSink &shared)
+      : RPageSink(shared.fSink->GetNTupleName(), shared.fSink->GetWriteOptions()), fShared(shared)
+   {
+   }
+
+   RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements) final
+   {
+      if (nElements == 0)
+         nElements = kDefaultElementsPerPage;
+      const auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+      return ROOT::Experimental::Detail::RPageAllocatorHeap::NewPage(columnHandle.fId, elementSize, nElements);
+   }
+
+   void ReleasePage(RPage &page) final { ROOT::Experimental::Detail::RPageAllocatorHeap::DeletePage(page); }
+
+   static constexpr std::size_t kDefaultElementsPerPage = 10000;
+};
+
+/// Translate the spelling of TypeID2TypeName into the one understood by RFieldBase::Create
+std::string GetFieldTypeName(const std::string &typeName)
+{
+   if (typeName == "short")
+      return "std::int16_t";
+   if (typeName == "unsigned short")
+      return "std::uint16_t";
+   if (typeName == "long" || typeName == "Long64_t")
+      return "std::int64_t";
+   if (typeName == "unsigned long" || typeName == "ULong64_t")
+      return "std::uint64_t";
+   if (typeName == "string")
+      return "std::string";
+   if (typeName.compare(0, 7, "vector<") == 0)
+      return "std::vector<" + GetFieldTypeName(typeName.substr(7, typeName.size() - 8)) + ">";
+   return typeName;
+}
+
+template <typename T>
+std::unique_ptr<RFieldBase> MakeRVecField(const std::string &fieldName, std::unique_ptr<RFieldBase> itemField)
+{
+   return std::make_unique<RField<ROOT::RVec<T>>>(fieldName, std::move(itemField));
+}
+
+std::unique_ptr<RFieldBase> MakeField(const std::string &fieldName, const std::string &typeName)
+{
+   const std::string rvecPrefix = "ROOT::VecOps::RVec<";
+   if (typeName.compare(0, rvecPrefix.size(), rvecPrefix) != 0 || typeName == "ROOT::VecOps::RVec<bool>")
+      return RFieldBase::Create(fieldName, GetFieldTypeName(typeName)).Unwrap();
+
+   // RFieldBase::Create would return a field with the memory layout of a std::vector: pick the RVec field that
+   // matches the objects RDataFrame passes to Fill instead
+   const auto itemTypeName =
+      GetFieldTypeName(typeName.substr(rvecPrefix.size(), typeName.size() - rvecPrefix.size() - 1));
+   auto itemField = RFieldBase::Create("_0", itemTypeName).Unwrap();
+   if (itemTypeName == "float")
+      return MakeRVecField<float>(fieldName, std::move(itemField));
+   if (itemTypeName == "double")
+      return MakeRVecField<double>(fieldName, std::move(itemField));
+   if (itemTypeName == "char")
+      return MakeRVecField<char>(fieldName, std::move(itemField));
+   if (itemTypeName == "int")
+      return MakeRVecField<int>(fieldName, std::move(itemField));
+   if (itemTypeName == "unsigned int")
+      return MakeRVecField<unsigned int>(fieldName, std::move(itemField));
+   if (itemTypeName == "unsigned char")
+      return MakeRVecField<unsigned char>(fieldName, std::move(itemField));
+   if (itemTypeName == "std::int16_t")
+      return MakeRVecField<std::int16_t>(fieldName, std::move(itemField));
+   if (itemTypeName == "std::uint16_t")
+      return MakeRVecField<std::uint16_t>(fieldName, std::move(itemField));
+   if (itemTypeName == "std::int64_t")
+      return MakeRVecField<std::int64_t>(fieldName, std::move(itemField));
+   if (itemTypeName == "std::uint64_t")
+      return MakeRVecField<std::uint64_t>(fieldName, std::move(itemField));
+   throw std::runtime_error("Snapshot: writing columns of type " + typeName + " to RNTuple is not supported.");
+}
+
+/// Wraps a RNTupleDS that is only constructed, i.e. the RNTuple is only opened, when it is first needed
+class RLazyNTupleDS final : public ROOT::RDF::RDataSource {
+   const std::string fNTupleName;
+   const std::string fFileName;
+   unsigned int fNSlots = 0;
+   mutable std::unique_ptr<ROOT::Experimental::RNTupleDS> fDS;
+
+   ROOT::Experimental::RNTupleDS &GetDS() const
+   {
+      if (!fDS) {
+         auto pageSource = ROOT::Experimental::Detail::RPageSource::Create(fNTupleName, fFileName);
+         fDS = std::make_unique<ROOT::Experimental::RNTupleDS>(std::move(pageSource));
+         if (fNSlots > 0)
+            fDS->SetNSlots(fNSlots);
+      }
+      return *fDS;
+   }
+
+protected:
+   Record_t GetColumnReadersImpl(std::string_view /*name*/, const std::type_info &) final { return {}; }
+
+public:
+   RLazyNTupleDS(std::string_view ntupleName, std::string_view fileName) : fNTupleName(ntupleName), fFileName(fileName)
+   {
+   }
+
+   void SetNSlots(unsigned int nSlots) final
+   {
+      fNSlots = nSlots;
+      if (fDS)
+         fDS->SetNSlots(nSlots);
+   }
+   const std::vector<std::string> &GetColumnNames() const final { return GetDS().GetColumnNames(); }
+   bool HasColumn(std::string_view colName) const final { return GetDS().HasColumn(colName); }
+   std::string GetTypeName(std::string_view colName) const final { return GetDS().GetTypeName(colName); }
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final { return GetDS().GetEntryRanges(); }
+   std::string GetLabel() final { return GetDS().GetLabel(); }
+   bool SetEntry(unsigned int slot, ULong64_t entry) final { return GetDS().SetEntry(slot, entry); }
+   void Initialise() final { GetDS().Initialise(); }
+   void InitSlot(unsigned int slot, ULong64_t firstEntry) final { GetDS().InitSlot(slot, firstEntry); }
+   void FinaliseSlot(unsigned int slot) final { GetDS().FinaliseSlot(slot); }
+   void Finalise() final { GetDS().Finalise(); }
+   std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase>
+   GetColumnReaders(unsigned int slot, std::string_view name, const std::type_info &tid) final
+   {
+      return GetDS().GetColumnReaders(slot, name, tid);
+   }
+};
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+struct RNTupleSnapshotWriter::RImpl {
+   const unsigned int fNSlots;
+   const std::string fFileName;
+   const std::string fNTupleName;
+   const std::vector<std::string> fFieldNames;
+   const std::vector<std::string> fTypeNames;
+   const ROOT::RDF::RSnapshotOptions fOptions;
+
+   RSharedSink fShared;
+   std::vector<std::unique_ptr<RNTupleWriter>> fWriters; ///< One per slot
+   /// One per slot. The values are re-pointed at every Fill to the addresses that RDataFrame provides.
+   std::vector<std::unique_ptr<REntry>> fEntries;
+
+   RImpl(unsigned int nSlots, std::string_view fileName, std::string_view ntupleName,
+         const std::vector<std::string> &fieldNames, const std::vector<std::string> &typeNames,
+         const ROOT::RDF::RSnapshotOptions &options)
+      : fNSlots(nSlots), fFileName(fileName), fNTupleName(ntupleName), fFieldNames(fieldNames), fTypeNames(typeNames),
+        fOptions(options)
+   {
+   }
+};
+
+RNTupleSnapshotWriter::RNTupleSnapshotWriter(unsigned int nSlots, std::string_view fileName,
+                                             std::string_view ntupleName, const std::vector<std::string> &fieldNames,
+                                             const std::vector<std::string> &typeNames,
+                                             const ROOT::RDF::RSnapshotOptions &options)
+   : fImpl(new RImpl(nSlots, fileName, ntupleName, fieldNames, typeNames, options))
+{
+}
+
+RNTupleSnapshotWriter::~RNTupleSnapshotWriter() = default;
+
+void RNTupleSnapshotWriter::Initialize()
+{
+   auto &shared = fImpl->fShared;
+   const auto &options = fImpl->fOptions;
+
+   auto model = RNTupleModel::Create();
+   for (std::size_t i = 0; i < fImpl->fFieldNames.size(); ++i)
+      model->AddField(MakeField(fImpl->fFieldNames[i], fImpl->fTypeNames[i]));
+
+   ROOT::Experimental::RNTupleWriteOptions writeOptions;
+   writeOptions.SetCompression(ROOT::CompressionSettings(options.fCompressionAlgorithm, options.fCompressionLevel));
+   // the slots already buffer and seal whole clusters
+   writeOptions.SetUseBufferedWrite(false);
+
+   TString mode = options.fMode;
+   mode.ToLower();
+   if (mode == "update") {
+      shared.fFile.reset(TFile::Open(fImpl->fFileName.c_str(), "UPDATE"));
+      if (!shared.fFile || shared.fFile->IsZombie())
+         throw std::runtime_error("Snapshot: could not open output file " + fImpl->fFileName);
+      shared.fSink =
+         std::make_unique<ROOT::Experimental::Detail::RPageSinkFile>(fImpl->fNTupleName, *shared.fFile, writeOptions);
+   } else {
+      shared.fSink = RPageSink::Create(fImpl->fNTupleName, fImpl->fFileName, writeOptions);
+   }
+   shared.fModel = std::move(model);
+   shared.fSink->Create(*shared.fModel);
+   shared.fNEntries = 0;
+
+   fImpl->fWriters.resize(fImpl->fNSlots);
+   fImpl->fEntries.resize(fImpl->fNSlots);
+   for (unsigned int slot = 0; slot < fImpl->fNSlots; ++slot) {
+      auto slotModel = shared.fModel->Clone();
+      auto entry = std::make_unique<REntry>();
+      for (auto field : slotModel->GetFieldZero()->GetSubFields())
+         entry->CaptureValue(field->CaptureValue(nullptr));
+      fImpl->fEntries[slot] = std::move(entry);
+      fImpl->fWriters[slot] =
+         std::make_unique<RNTupleWriter>(std::move(slotModel), std::make_unique<RPageSinkSlot>(shared));
+   }
+}
+
+void RNTupleSnapshotWriter::Fill(unsigned int slot, void *const *values)
+{
+   auto &entry = *fImpl->fEntries[slot];
+   std::size_t i = 0;
+   for (auto &value : entry)
+      value = value.GetField()->CaptureValue(values[i++]);
+   fImpl->fWriters[slot]->Fill(entry);
+}
+
+void RNTupleSnapshotWriter::Finalize()
+{
+   auto &shared = fImpl->fShared;
+   // destroying the writers commits the clusters that are still open in the slots
+   fImpl->fWriters.clear();
+   fImpl->fEntries.clear();
+   shared.fSink->CommitDataset();
+   // the columns of the model release their pages to the sink: destroy the model first
+   shared.fModel.reset();
+   shared.fSink.reset();
+   if (shared.fFile)
+      shared.fFile->Close();
+   shared.fFile.reset();
+}
+
+std::unique_ptr<ROOT::RDF::RDataSource> MakeLazyNTupleDS(std::string_view ntupleName, std::string_view fileName)
+{
+   return std::make_unique<RLazyNTupleDS>(ntupleName, fileName);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#else // R__RDF_HAS_RNTUPLE
+
+namespace {
+const char *kNoRNTupleMsg = "Snapshot: writing RNTuples requires ROOT to be built with root7=ON.";
+}
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+struct RNTupleSnapshotWriter::RImpl {
+};
+
+RNTupleSnapshotWriter::RNTupleSnapshotWriter(unsigned int, std::string_view, std::string_view,
+                                             const std::vector<std::string> &, const std::vector<std::string> &,
+                                             const ROOT::RDF::RSnapshotOptions &)
+{
+   throw std::runtime_error(kNoRNTupleMsg);
+}
+
+RNTupleSnapshotWriter::~RNTupleSnapshotWriter() = default;
+
+void RNTupleSnapshotWriter::Initialize() {}
+
+void RNTupleSnapshotWriter::Fill(unsigned int, void *const *) {}
+
+void RNTupleSnapshotWriter::Finalize() {}
+
+std::unique_ptr<ROOT::RDF::RDataSource> MakeLazyNTupleDS(std::string_view, std::string_view)
+{
+   throw std::runtime_error(kNoRNTupleMsg);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // R__RDF_HAS_RNTUPLE
@@ -0,0 +1,37 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfileReport.hxx"
+
+#include "TString.h" // Printf
+
+namespace ROOT {
+
+namespace RDF {
+
+void RProfileReport::Print() const
+{
+   Printf("Event loop: %llu entries in %.3f s (%.3f s CPU), %.4g entries/s, %lld bytes read, %.3f s jitting",
+          fNEntries, fRealTime, fCpuTime, GetThroughput(), fBytesRead, fJitTime);
+   Printf("%-10s %-24s %12s %12s %12s %14s", "Kind", "Name", "Self [s]", "Total [s]", "Calls", "Calls/s");
+   for (const auto &n : fNodes) {
+      Printf("%-10s %-24s %12.4f %12.4f %12llu %14.4g", n.GetKind().c_str(), n.GetName().c_str(), n.GetSelfTime(),
+             n.GetTotalTime(), n.GetNCalls(), n.GetThroughput());
+   }
+   Printf("%-10s %12s %12s %12s %12s %8s %12s %12s", "Slot", "Busy [s]", "Graph [s]", "Reading [s]", "Idle [s]",
+          "Tasks", "RVec allocs", "Reused");
+   for (auto i = 0u; i < fSlots.size(); ++i) {
+      const auto &s = fSlots[i];
+      Printf("%-10u %12.4f %12.4f %12.4f %12.4f %8llu %12llu %12llu", i, s.GetBusyTime(), s.GetProcessingTime(),
+             s.GetReadingTime(), s.GetIdleTime(), s.GetNTasks(), s.GetNBufferRequests(), s.GetNBuffersReused());
+   }
+}
+
+} // End NS RDF
+
+} // End NS ROOT
@@ -0,0 +1,86 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfiler.hxx"
+
+#include <cstdio>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define R__RDF_HAS_RDTSC
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define R__RDF_HAS_RDTSC
+#endif
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+std::uint64_t ReadTicks()
+{
+#ifdef R__RDF_HAS_RDTSC
+   return __rdtsc();
+#else
+   return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+/// Reset all per-slot information and start the calibration of ticks against wall-clock time.
+void RProfiler::Start(unsigned int nSlots)
+{
+   fSlots.assign(nSlots, RSlotData());
+   fStartTime = std::chrono::steady_clock::now();
+   fStartTicks = ReadTicks();
+}
+
+/// Complete the calibration of ticks against wall-clock time. Must be called at the end of the event loop.
+void RProfiler::Stop()
+{
+   const auto ticks = ReadTicks() - fStartTicks;
+   const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - fStartTime;
+   fSecondsPerTick = ticks > 0 ? elapsed.count() / ticks : 0.;
+}
+
+double RNodeTimer::GetSelfTime() const
+{
+   std::uint64_t ticks = 0;
+   for (const auto &c : fCounters)
+      ticks += c.fSelfTicks;
+   return fProfiler != nullptr ? fProfiler->ToSeconds(ticks) : 0.;
+}
+
+double RNodeTimer::GetTotalTime() const
+{
+   std::uint64_t ticks = 0;
+   for (const auto &c : fCounters)
+      ticks += c.fTotalTicks;
+   return fProfiler != nullptr ? fProfiler->ToSeconds(ticks) : 0.;
+}
+
+ULong64_t RNodeTimer::GetNCalls() const
+{
+   ULong64_t nCalls = 0;
+   for (const auto &c : fCounters)
+      nCalls += c.fNCalls;
+   return nCalls;
+}
+
+std::string RNodeTimer::GetSummary() const
+{
+   const auto nCalls = GetNCalls();
+   if (nCalls == 0)
+      return "";
+   char buf[64];
+   std::snprintf(buf, sizeof(buf), "%.3g ms self, %llu calls", 1e3 * GetSelfTime(), nCalls);
+   return buf;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -3,14 +3,17 @@
 
 #include "ROOT/RCsvDS.hxx"
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RTrivialDS.hxx"
+#include "TInterpreter.h"
 #include "TMemFile.h"
 #include "TSystem.h"
 #include "TTree.h"
 
 #include "gtest/gtest.h"
 
+#include <map>
 #include <thread>
 
 using namespace ROOT;
@@ -774,3 +777,102 @@ TEST(RDataFrameInterface, SnapshotWithDuplicateColumns)
       std::logic_error);
    EXPECT_THROW((ROOT::RDataFrame(1).Snapshot("t", "neverwritten.root", {"rdfentry_", "rdfentry_"})), std::logic_error);
 }
+
+TEST(RDataFrameInterface, IdenticalJittedNodesAreMerged)
+{
+   gInterpreter->Declare("namespace RDFMergeTest { int nFilterEvals = 0; int nDefineEvals = 0; }");
+   ROOT::RDataFrame df(10);
+   auto f1 = df.Filter("++RDFMergeTest::nFilterEvals > 0");
+   auto f2 = df.Filter("++RDFMergeTest::nFilterEvals > 0");
+   auto d1 = f1.Define("x", "++RDFMergeTest::nDefineEvals");
+   auto d2 = df.Filter("rdfentry_ >= 0").Define("x", "++RDFMergeTest::nDefineEvals");
+   auto s1 = d1.Sum<int>("x");
+   auto s2 = d2.Sum<int>("x");
+   auto c = f2.Count();
+   EXPECT_EQ(*c, 10ull);
+   EXPECT_EQ(*s1, *s2);
+   EXPECT_EQ(gInterpreter->ProcessLine("RDFMergeTest::nFilterEvals;"), 10);
+   EXPECT_EQ(gInterpreter->ProcessLine("RDFMergeTest::nDefineEvals;"), 10);
+
+   const auto graph = ROOT::RDF::SaveGraph(df);
+   EXPECT_NE(graph.find("2 identical bookings merged"), std::string::npos);
+
+   // named filters are never merged
+   auto n1 = df.Filter("true", "named");
+   auto n2 = df.Filter("true", "named");
+   auto report = df.Report();
+   EXPECT_EQ(std::distance(report->begin(), report->end()), 2);
+}
+
+TEST(RDataFrameInterface, Profiling)
+{
+   ROOT::RDataFrame df(100);
+   EXPECT_TRUE(df.GetProfileReport().IsEmpty());
+
+   df.EnableProfiling();
+   auto sum = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+                 .Filter([](double x) { return x > 49; }, {"x"}, "cut")
+                 .Sum<double>("x");
+   EXPECT_DOUBLE_EQ(*sum, 3725.);
+
+   const auto report = df.GetProfileReport();
+   EXPECT_EQ(report.GetNEntries(), 100ull);
+   EXPECT_EQ(report.GetSlots().size(), df.GetNSlots());
+   std::map<std::string, ULong64_t> nCalls;
+   for (const auto &node : report)
+      nCalls[node.GetKind() + node.GetName()] = node.GetNCalls();
+   EXPECT_EQ(nCalls.size(), 3u);
+   EXPECT_EQ(nCalls["Definex"], 100ull);
+   EXPECT_EQ(nCalls["Filtercut"], 100ull);
+   EXPECT_EQ(nCalls["Sum"], 50ull);
+
+   const auto graph = ROOT::RDF::SaveGraph(df);
+   EXPECT_NE(graph.find("100 calls"), std::string::npos);
+   EXPECT_NE(graph.find("50 calls"), std::string::npos);
+
+   // the report of the last profiled event loop is kept, but the following loops are not profiled anymore
+   df.EnableProfiling(false);
+   EXPECT_EQ(*df.Count(), 100ull);
+   EXPECT_EQ(df.GetProfileReport().GetNEntries(), 100ull);
+   EXPECT_EQ(df.GetNRuns(), 2u);
+}
+
+TEST(RDataFrameInterface, ProfilingRedefine)
+{
+   ROOT::RDataFrame df(100);
+   auto x = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto redefined = x.Redefine("x", [](double v) { return 2. * v; }, {"x"});
+
+   // the shadowed Define is evaluated by the Redefine in every event loop, but is not part of the report
+   for (auto profile : {true, false, true}) {
+      df.EnableProfiling(profile);
+      EXPECT_DOUBLE_EQ(*redefined.Sum<double>("x"), 9900.);
+   }
+   std::map<std::string, ULong64_t> nCalls;
+   for (const auto &node : df.GetProfileReport())
+      nCalls[node.GetKind() + node.GetName()] = node.GetNCalls();
+   EXPECT_EQ(nCalls.size(), 2u);
+   EXPECT_EQ(nCalls["Definex"], 100ull);
+   EXPECT_EQ(nCalls["Sum"], 100ull);
+}
+
+TEST(RDataFrameInterface, RVecBufferPools)
+{
+   ROOT::RDataFrame df(100);
+   df.EnableProfiling();
+   auto sum = df.Define("v", [](ULong64_t e) { return ROOT::RVecD(100, double(e)); }, {"rdfentry_"})
+                 .Define("s", [](const ROOT::RVecD &v) { return ROOT::VecOps::Sum(v); }, {"v"})
+                 .Sum<double>("s");
+   EXPECT_DOUBLE_EQ(*sum, 495000.);
+
+   // the buffer of the value of "v" for an entry is recycled two entries later, when the value of the
+   // following entry has replaced it
+   ULong64_t nRequests = 0;
+   ULong64_t nReused = 0;
+   for (const auto &slot : df.GetProfileReport().GetSlots()) {
+      nRequests += slot.GetNBufferRequests();
+      nReused += slot.GetNBuffersReused();
+   }
+   EXPECT_GE(nRequests, 100ull);
+   EXPECT_GE(nReused, 100ull - 2 * df.GetNSlots());
+}
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <ROOTUnitTestSupport.h>
 #include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDFHelpers.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TChain.h>
 #include <TFile.h>
@@ -977,6 +978,34 @@ TEST_P(RDFSimpleTests, FillWithCustomClassJitted)
    EXPECT_EQ(h.GetEntries(), 10);
 }
 
+TEST_P(RDFSimpleTests, SharedFill)
+{
+   auto d = ROOT::RDataFrame(1000)
+               .Define("x", [](ULong64_t e) { return double(e % 100); }, {"rdfentry_"})
+               .Define("v", [](double x) { return ROOT::RVec<double>{x, x + 1, x + 2}; }, {"x"});
+   auto fill = [&d] {
+      return std::make_tuple(d.Histo1D<double>({"h1", "h1", 100, 0, 100}, "x"),
+                             d.Histo2D<double, double>({"h2", "h2", 100, 0, 100, 100, 0, 100}, "x", "x"),
+                             d.Histo1D<ROOT::RVec<double>, double>({"h3", "h3", 100, 0, 100}, "v", "x"),
+                             d.Profile1D<double, double>({"p", "p", 100, 0, 100}, "x", "x"));
+   };
+   const auto defaultThreshold = ROOT::RDF::Experimental::GetSharedFillThreshold();
+   auto perSlot = fill();
+   ROOT::RDF::Experimental::SetSharedFillThreshold(0u); // always fill a single shared histogram
+   auto shared = fill();
+   ROOT::RDF::Experimental::SetSharedFillThreshold(defaultThreshold);
+
+   EXPECT_EQ(std::get<0>(perSlot)->GetEntries(), std::get<0>(shared)->GetEntries());
+   EXPECT_DOUBLE_EQ(std::get<0>(perSlot)->GetMean(), std::get<0>(shared)->GetMean());
+   EXPECT_EQ(std::get<1>(perSlot)->GetEntries(), std::get<1>(shared)->GetEntries());
+   EXPECT_DOUBLE_EQ(std::get<1>(perSlot)->GetCovariance(), std::get<1>(shared)->GetCovariance());
+   EXPECT_EQ(std::get<2>(perSlot)->GetEntries(), 3000);
+   EXPECT_EQ(std::get<2>(shared)->GetEntries(), 3000);
+   EXPECT_DOUBLE_EQ(std::get<2>(perSlot)->GetSumOfWeights(), std::get<2>(shared)->GetSumOfWeights());
+   for (int bin = 1; bin <= 100; ++bin)
+      EXPECT_DOUBLE_EQ(std::get<3>(perSlot)->GetBinContent(bin), std::get<3>(shared)->GetBinContent(bin));
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_SUITE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
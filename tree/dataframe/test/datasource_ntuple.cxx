@@ -1,5 +1,7 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RNTupleDS.hxx>
+#include <ROOT/RSnapshotOptions.hxx>
+#include <ROOT/RVec.hxx>
 
 #include <ROOT/RNTuple.hxx>
 #include <ROOT/RNTupleModel.hxx>
@@ -125,3 +127,74 @@ TEST_F(RNTupleDSTest, ReadMT)
 
    ReadTest(fNtplName, fFileName);
 }
+
+TEST(RNTupleDS, ClusterAlignedRanges)
+{
+   const std::string fileName = "RNTupleDS_test_clusters.root";
+   {
+      auto model = RNTupleModel::Create();
+      auto pt = model->MakeField<float>("pt");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileName);
+      for (int i = 0; i < 100; ++i) {
+         *pt = i;
+         ntuple->Fill();
+         if (i % 10 == 9)
+            ntuple->CommitCluster();
+      }
+   }
+
+   RNTupleDS ds(RPageSource::Create("ntuple", fileName));
+   ds.SetNSlots(4);
+   ds.Initialise();
+   const auto ranges = ds.GetEntryRanges();
+   ASSERT_FALSE(ranges.empty());
+   ULong64_t expectedStart = 0;
+   for (const auto &r : ranges) {
+      EXPECT_EQ(expectedStart, r.first);
+      EXPECT_EQ(0u, r.first % 10);
+      EXPECT_EQ(0u, r.second % 10);
+      expectedStart = r.second;
+   }
+   EXPECT_EQ(100u, expectedStart);
+   EXPECT_TRUE(ds.GetEntryRanges().empty());
+
+   {
+      IMTRAII _;
+      auto df = ROOT::RDataFrame(std::make_unique<RNTupleDS>(RPageSource::Create("ntuple", fileName)));
+      EXPECT_DOUBLE_EQ(4950., df.Sum<float>("pt").GetValue());
+   }
+   std::remove(fileName.c_str());
+}
+
+static void SnapshotToNTuple(const std::string &fileName)
+{
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   auto out = ROOT::RDataFrame(1000)
+                 .Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                 .Define("v", [](int x) { return ROOT::RVec<float>(x % 4, float(x)); }, {"x"})
+                 .Filter([](int x) { return x % 2 == 0; }, {"x"})
+                 .Snapshot<int, ROOT::RVec<float>>("ntuple", fileName, {"x", "v"}, opts);
+
+   EXPECT_EQ(500u, *out->Count());
+   EXPECT_EQ(249500, *out->Sum<int>("x"));
+   // entries with x % 4 == 2 have two elements equal to x
+   EXPECT_DOUBLE_EQ(2. * 125000, *out->Define("s", "std::accumulate(v.begin(), v.end(), 0.f)").Sum<float>("s"));
+}
+
+TEST(RNTupleDS, Snapshot)
+{
+   const std::string fileName = "RNTupleDS_test_snapshot.root";
+   SnapshotToNTuple(fileName);
+   std::remove(fileName.c_str());
+}
+
+TEST(RNTupleDS, SnapshotMT)
+{
+   const std::string fileName = "RNTupleDS_test_snapshot_mt.root";
+   {
+      IMTRAII _;
+      SnapshotToNTuple(fileName);
+   }
+   std::remove(fileName.c_str());
+}
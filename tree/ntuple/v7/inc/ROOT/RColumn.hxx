@@ -245,6 +245,18 @@ public:
          (clusterIndex.GetIndex() - fReadPage.GetClusterRangeFirst()) * RColumnElement<CppT>::kSize);
    }
 
+   /// Type-erased version of MapV() for callers that know the size of the in-memory element but not its C++ type.
+   /// Only valid for columns whose in-memory and on-disk representations coincide, i.e. principal columns of
+   /// simple fields.
+   void *MapRawV(const NTupleSize_t globalIndex, std::size_t elementSize, NTupleSize_t &nItems) {
+      if (R__unlikely(!fReadPage.Contains(globalIndex))) {
+         MapPage(globalIndex);
+      }
+      nItems = fReadPage.GetGlobalRangeLast() - globalIndex + 1;
+      return static_cast<unsigned char *>(fReadPage.GetBuffer()) +
+             (globalIndex - fReadPage.GetGlobalRangeFirst()) * elementSize;
+   }
+
    NTupleSize_t GetGlobalIndex(const RClusterIndex &clusterIndex) {
       if (!fReadPage.Contains(clusterIndex)) {
          MapPage(clusterIndex);
@@ -224,6 +224,16 @@ public:
       fPrincipalColumn->Read(clusterIndex, &value->fMappedElement);
    }
 
+   /// For simple fields, return a pointer to the value at globalIndex inside the currently mapped page instead of
+   /// copying it into an RFieldValue. On return, nItems is the number of consecutive values available from the
+   /// returned address. The memory stays valid until the field reads from a different page. Returns nullptr for
+   /// fields that are not simple.
+   void *MapV(NTupleSize_t globalIndex, NTupleSize_t &nItems) {
+      if (!fIsSimple)
+         return nullptr;
+      return fPrincipalColumn->MapRawV(globalIndex, GetValueSize(), nItems);
+   }
+
    /// Ensure that all received items are written from page buffers to the storage.
    void Flush() const;
    /// Perform housekeeping tasks for global to cluster-local index translation